@@ -0,0 +1,272 @@
+// 2D Platform Game
+// ActivityScheduler.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ActivityScheduler class.
+
+#include "ActivityScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint32_t;
+
+// <stdexcept>
+using std::invalid_argument;
+using std::out_of_range;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// Returns value / divisor rounded down, for divisor > 0.
+	int32_t floor_div(int32_t value, int32_t divisor)
+	{
+		return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+	}
+}
+
+ActivityScheduler::ActivityScheduler(int32_t level_width, int32_t level_height, int32_t region_size)
+{
+	setLevelSize(level_width, level_height, region_size);
+}
+
+uint32_t ActivityScheduler::regionAt(const Point2f& position) const
+{
+	const int32_t x = std::clamp(int32_t(std::floor(position.x)) / region_size_, 0, regions_x_ - 1);
+	const int32_t y = std::clamp(int32_t(std::floor(position.y)) / region_size_, 0, regions_y_ - 1);
+
+	return uint32_t(y * regions_x_ + x);
+}
+
+ActivityScheduler::Entity& ActivityScheduler::entityAt(uint32_t id)
+{
+	if (id >= entities_.size() || entities_[id].region == NONE)
+		throw out_of_range("ActivityScheduler: no entity with the given id");
+
+	return entities_[id];
+}
+
+void ActivityScheduler::makeDue(uint32_t id)
+{
+	if (due_stamps_[id] == due_stamp_)
+		return;
+
+	Entity& entity = entities_[id];
+
+	due_stamps_[id] = due_stamp_;
+	due_.push_back(ScheduledUpdate { id, float(time_ - entity.last_update) });
+	entity.last_update = time_;
+}
+
+void ActivityScheduler::setLevelSize(int32_t level_width, int32_t level_height, int32_t region_size)
+{
+	if (level_width < 0 || level_height < 0)
+		throw invalid_argument("ActivityScheduler::setLevelSize: level size must not be negative");
+
+	if (region_size < 1)
+		throw invalid_argument("ActivityScheduler::setLevelSize: region_size must be at least 1");
+
+	// Always at least one region, so every position has one.
+	region_size_ = region_size;
+	regions_x_ = std::max((level_width + region_size - 1) / region_size, 1);
+	regions_y_ = std::max((level_height + region_size - 1) / region_size, 1);
+
+	entities_.clear();
+	free_entities_.clear();
+	regions_.assign(size_t(regions_x_) * size_t(regions_y_), vector<uint32_t>());
+	awake_.clear();
+	due_.clear();
+	due_stamps_.clear();
+	visible_count_ = 0;
+	near_count_ = 0;
+}
+
+void ActivityScheduler::setNearUpdates(int32_t distance, uint32_t interval)
+{
+	if (distance < 0)
+		throw invalid_argument("ActivityScheduler::setNearUpdates: distance must not be negative");
+
+	if (interval == 0)
+		throw invalid_argument("ActivityScheduler::setNearUpdates: interval must not be 0");
+
+	near_distance_ = distance;
+	near_interval_ = interval;
+}
+
+uint32_t ActivityScheduler::add(const Point2f& position)
+{
+	uint32_t id;
+
+	if (free_entities_.empty())
+	{
+		id = uint32_t(entities_.size());
+		entities_.emplace_back();
+		due_stamps_.push_back(0);
+	}
+	else
+	{
+		id = free_entities_.back();
+		free_entities_.pop_back();
+	}
+
+	Entity& entity = entities_[id];
+	const uint32_t region_index = regionAt(position);
+	vector<uint32_t>& region = regions_[region_index];
+
+	entity.region = region_index;
+	entity.slot = uint32_t(region.size());
+	entity.last_update = time_;
+	entity.awake_until = 0.0;
+	entity.awake = false;
+	region.push_back(id);
+
+	return id;
+}
+
+void ActivityScheduler::remove(uint32_t id)
+{
+	Entity& entity = entityAt(id);
+	vector<uint32_t>& region = regions_[entity.region];
+
+	region[entity.slot] = region.back();
+	entities_[region.back()].slot = entity.slot;
+	region.pop_back();
+
+	if (entity.awake)
+		awake_.erase(std::find(awake_.begin(), awake_.end(), id));
+
+	entity.region = NONE;
+	entity.awake = false;
+	free_entities_.push_back(id);
+}
+
+void ActivityScheduler::move(uint32_t id, const Point2f& position)
+{
+	Entity& entity = entityAt(id);
+	const uint32_t new_region = regionAt(position);
+
+	if (new_region == entity.region)
+		return;
+
+	vector<uint32_t>& old_members = regions_[entity.region];
+	old_members[entity.slot] = old_members.back();
+	entities_[old_members.back()].slot = entity.slot;
+	old_members.pop_back();
+
+	vector<uint32_t>& new_members = regions_[new_region];
+	entity.region = new_region;
+	entity.slot = uint32_t(new_members.size());
+	new_members.push_back(id);
+}
+
+void ActivityScheduler::wake(uint32_t id, float seconds)
+{
+	Entity& entity = entityAt(id);
+
+	entity.awake_until = std::max(entity.awake_until, time_ + double(seconds));
+
+	if (!entity.awake)
+	{
+		entity.awake = true;
+		awake_.push_back(id);
+	}
+}
+
+void ActivityScheduler::schedule(const Rectangle<int32_t>& visible_tiles, float seconds)
+{
+	time_ += seconds;
+	++tick_;
+	++due_stamp_;
+	due_.clear();
+	visible_count_ = 0;
+	near_count_ = 0;
+
+	if (visible_tiles.width > 0 && visible_tiles.height > 0)
+	{
+		// Regions touching the view, and the range of near regions
+		// around them cut to the level.
+		const int32_t view_x0 = floor_div(visible_tiles.vertex.x, region_size_);
+		const int32_t view_y0 = floor_div(visible_tiles.vertex.y, region_size_);
+		const int32_t view_x1 = floor_div(visible_tiles.vertex.x + visible_tiles.width - 1, region_size_);
+		const int32_t view_y1 = floor_div(visible_tiles.vertex.y + visible_tiles.height - 1, region_size_);
+		const int32_t near_x0 = std::max(view_x0 - near_distance_, 0);
+		const int32_t near_y0 = std::max(view_y0 - near_distance_, 0);
+		const int32_t near_x1 = std::min(view_x1 + near_distance_, regions_x_ - 1);
+		const int32_t near_y1 = std::min(view_y1 + near_distance_, regions_y_ - 1);
+
+		for (int32_t y = near_y0; y <= near_y1; ++y)
+		{
+			for (int32_t x = near_x0; x <= near_x1; ++x)
+			{
+				const uint32_t index = uint32_t(y * regions_x_ + x);
+				const vector<uint32_t>& members = regions_[index];
+				const bool in_view = x >= view_x0 && x <= view_x1 && y >= view_y0 && y <= view_y1;
+
+				if (in_view)
+					visible_count_ += members.size();
+				else
+				{
+					near_count_ += members.size();
+
+					// Regions take turns, so the same share of them updates every tick.
+					if ((tick_ + index) % near_interval_ != 0)
+						continue;
+				}
+
+				for (uint32_t id : members)
+					makeDue(id);
+			}
+		}
+	}
+
+	for (size_t i = 0; i < awake_.size();)
+	{
+		Entity& entity = entities_[awake_[i]];
+
+		if (entity.awake_until < time_)
+		{
+			entity.awake = false;
+			awake_[i] = awake_.back();
+			awake_.pop_back();
+			continue;
+		}
+
+		makeDue(awake_[i]);
+		++i;
+	}
+}
+
+const vector<ScheduledUpdate>& ActivityScheduler::due() const
+{
+	return due_;
+}
+
+size_t ActivityScheduler::visibleCount() const
+{
+	return visible_count_;
+}
+
+size_t ActivityScheduler::nearCount() const
+{
+	return near_count_;
+}
+
+size_t ActivityScheduler::entityCount() const
+{
+	return entities_.size() - free_entities_.size();
+}
@@ -0,0 +1,145 @@
+// 2D Platform Game
+// ActivityScheduler.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ActivityScheduler class.
+
+#ifndef ACTIVITYSCHEDULER_H_INCLUDED
+#define ACTIVITYSCHEDULER_H_INCLUDED
+
+#include "Jlib/Point.h"
+#include "Jlib/Rectangle.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// An entity due for an update this tick.
+struct ScheduledUpdate
+{
+	std::uint32_t id = 0;
+
+	// Seconds since the entity was last updated, or since it was added.
+	float elapsed = 0.0f;
+};
+
+// Decides which entities to update each tick by how close they are
+// to the view, so entities far away cost nothing.
+// The level is split into square regions, and each entity belongs to
+// the region containing its position.
+//  - Entities in regions touching the view update every tick.
+//  - Entities in regions within the near distance of those update
+//    every few ticks, a whole region at a time, with the regions
+//    taking turns so the work is spread evenly.
+//  - Entities further away sleep: only the regions near the view are
+//    visited, so sleeping entities are never read, however many there are.
+//  - A woken entity updates every tick wherever it is until its wake
+//    time runs out, for events such as being hit or heard.
+// Each scheduled update carries the time since the entity last
+// updated, so a reduced-rate or sleeping entity can catch up.
+class ActivityScheduler
+{
+	static constexpr std::uint32_t NONE = 0xFFFFFFFF;
+
+	struct Entity
+	{
+		std::uint32_t region = NONE;
+		std::uint32_t slot = 0;
+		double last_update = 0.0;
+		double awake_until = 0.0;
+		bool awake = false;
+	};
+
+	std::int32_t region_size_ = 32;
+	std::int32_t regions_x_ = 0;
+	std::int32_t regions_y_ = 0;
+	std::int32_t near_distance_ = 2;
+	std::uint32_t near_interval_ = 4;
+
+	std::vector<Entity> entities_;
+	std::vector<std::uint32_t> free_entities_;
+	std::vector<std::vector<std::uint32_t>> regions_;
+	std::vector<std::uint32_t> awake_;
+
+	double time_ = 0.0;
+	std::uint64_t tick_ = 0;
+	std::vector<ScheduledUpdate> due_;
+	std::uint64_t due_stamp_ = 0;
+	std::vector<std::uint64_t> due_stamps_;
+	std::size_t visible_count_ = 0;
+	std::size_t near_count_ = 0;
+
+	// Returns the index of the region containing position.
+	// Positions outside of the level belong to the closest region.
+	std::uint32_t regionAt(const Jlib::Point2f& position) const;
+
+	// Returns the entity with the given id.
+	// This function will throw if id does not refer to an entity.
+	Entity& entityAt(std::uint32_t id);
+
+	// Adds the given entity to the due list unless it is on it already.
+	void makeDue(std::uint32_t id);
+
+	public:
+
+	// Default constructor.
+	ActivityScheduler() = default;
+
+	// Level size constructor.
+	// Splits a level of the given size, in tiles, into regions of
+	// region_size by region_size tiles.
+	// This function will throw if a size is negative or region_size is less than 1.
+	ActivityScheduler(std::int32_t level_width, std::int32_t level_height, std::int32_t region_size = 32);
+
+	// Removes every entity and splits a level of the given size, in
+	// tiles, into regions of region_size by region_size tiles.
+	// This function will throw if a size is negative or region_size is less than 1.
+	void setLevelSize(std::int32_t level_width, std::int32_t level_height, std::int32_t region_size = 32);
+
+	// Sets how many regions beyond the view entities keep updating,
+	// and how many ticks apart they update.
+	// The defaults are 2 regions and every 4 ticks.
+	// This function will throw if distance is negative or interval is 0.
+	void setNearUpdates(std::int32_t distance, std::uint32_t interval);
+
+	// Adds an entity at the given position and returns its id.
+	// Ids of removed entities are reused.
+	std::uint32_t add(const Jlib::Point2f& position);
+
+	// Removes the given entity.
+	// This function will throw if id does not refer to an entity.
+	void remove(std::uint32_t id);
+
+	// Tells the ActivityScheduler the given entity has moved.
+	// Only moving to another region costs anything.
+	// This function will throw if id does not refer to an entity.
+	void move(std::uint32_t id, const Jlib::Point2f& position);
+
+	// Makes the given entity update every tick for the given amount of
+	// seconds, wherever it is. Waking an awake entity extends its wake
+	// time if the new one ends later.
+	// This function will throw if id does not refer to an entity.
+	void wake(std::uint32_t id, float seconds);
+
+	// Advances the time by the given amount of seconds and finds the
+	// entities due for an update, given the tiles on screen, such as
+	// Camera::visibleTiles.
+	// The work done only depends on the amount of regions near the
+	// view and of entities that are near or awake.
+	void schedule(const Jlib::Rectangle<std::int32_t>& visible_tiles, float seconds);
+
+	// Returns the entities due for an update, as found by the last call to schedule.
+	const std::vector<ScheduledUpdate>& due() const;
+
+	// Returns the amount of entities in regions touching the view, as of the last schedule.
+	std::size_t visibleCount() const;
+
+	// Returns the amount of entities in regions near the view, as of the last schedule.
+	std::size_t nearCount() const;
+
+	// Returns the amount of entities.
+	std::size_t entityCount() const;
+};
+
+#endif // ACTIVITYSCHEDULER_H_INCLUDED
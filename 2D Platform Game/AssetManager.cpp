@@ -0,0 +1,225 @@
+// 2D Platform Game
+// AssetManager.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the AssetManager class.
+
+#include "AssetManager.h"
+
+#include <algorithm>
+#include <fstream>
+
+// <chrono>
+using std::chrono::duration;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+
+// <exception>
+using std::current_exception;
+using std::make_exception_ptr;
+
+// <fstream>
+using std::ifstream;
+
+// <memory>
+using std::unique_ptr;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+using std::unique_lock;
+
+// <stdexcept>
+using std::invalid_argument;
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+// <thread>
+using std::thread;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// Reads the whole file at path into bytes, reusing its storage.
+	void read_file(const string& path, vector<char>& bytes)
+	{
+		ifstream fin(path, std::ios::binary | std::ios::ate);
+
+		if (!fin.is_open())
+			throw runtime_error("AssetManager: could not open " + path);
+
+		bytes.resize(size_t(fin.tellg()));
+		fin.seekg(0);
+
+		if (!fin.read(bytes.data(), std::streamsize(bytes.size())))
+			throw runtime_error("AssetManager: could not read " + path);
+	}
+}
+
+AssetManager::AssetManager()
+	: AssetManager(2)
+{
+
+}
+
+AssetManager::AssetManager(size_t thread_count)
+{
+	if (thread_count == 0)
+		throw invalid_argument("AssetManager: thread_count must not be 0");
+
+	threads_.reserve(thread_count);
+
+	for (size_t i = 0; i < thread_count; ++i)
+		threads_.emplace_back(&AssetManager::run, this);
+}
+
+AssetManager::~AssetManager()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	queued_.notify_all();
+
+	for (thread& t : threads_)
+		t.join();
+
+	const std::exception_ptr reason = make_exception_ptr(runtime_error("AssetManager: destroyed before the asset was ready"));
+
+	for (unique_ptr<Job>& job : queue_)
+		job->cancel(reason);
+
+	for (unique_ptr<Job>& job : done_)
+		job->cancel(reason);
+}
+
+double AssetManager::milliseconds(Clock::time_point begin, Clock::time_point end)
+{
+	return duration<double, std::milli>(end - begin).count();
+}
+
+bool AssetManager::loadsAfter(const unique_ptr<Job>& a, const unique_ptr<Job>& b)
+{
+	return a->priority != b->priority ? a->priority < b->priority : a->sequence > b->sequence;
+}
+
+void AssetManager::enqueue(unique_ptr<Job> job, int32_t priority)
+{
+	job->priority = priority;
+	job->queued = Clock::now();
+
+	{
+		lock_guard<mutex> lock(mutex_);
+		job->sequence = next_sequence_++;
+		queue_.push_back(std::move(job));
+		std::push_heap(queue_.begin(), queue_.end(), &AssetManager::loadsAfter);
+		++pending_;
+	}
+
+	queued_.notify_one();
+}
+
+void AssetManager::run()
+{
+	// Kept between Jobs, so reading reuses the same storage.
+	vector<char> bytes;
+
+	while (true)
+	{
+		unique_ptr<Job> job;
+
+		{
+			unique_lock<mutex> lock(mutex_);
+			queued_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+
+			if (stopping_)
+				return;
+
+			std::pop_heap(queue_.begin(), queue_.end(), &AssetManager::loadsAfter);
+			job = std::move(queue_.back());
+			queue_.pop_back();
+		}
+
+		job->started = Clock::now();
+		job->read = job->started;
+
+		try
+		{
+			if (job->reads_file)
+				read_file(job->path, bytes);
+
+			job->read = Clock::now();
+			job->decode(bytes);
+		}
+		catch (...)
+		{
+			job->error = current_exception();
+		}
+
+		job->decoded = Clock::now();
+
+		{
+			lock_guard<mutex> lock(mutex_);
+			done_.push_back(std::move(job));
+		}
+
+		decoded_.notify_all();
+	}
+}
+
+void AssetManager::waitForDecoded()
+{
+	unique_lock<mutex> lock(mutex_);
+	decoded_.wait(lock, [&] { return !done_.empty() || pending_ == 0; });
+}
+
+size_t AssetManager::update(double budget_milliseconds)
+{
+	const Clock::time_point start = Clock::now();
+	size_t finished = 0;
+
+	while (true)
+	{
+		unique_ptr<Job> job;
+
+		{
+			lock_guard<mutex> lock(mutex_);
+
+			if (done_.empty())
+				break;
+
+			job = std::move(done_.front());
+			done_.pop_front();
+			--pending_;
+		}
+
+		job->finish();
+		++finished;
+
+		if (milliseconds(start, Clock::now()) >= budget_milliseconds)
+			break;
+	}
+
+	return finished;
+}
+
+size_t AssetManager::pendingCount() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return pending_;
+}
+
+size_t AssetManager::threadCount() const
+{
+	return threads_.size();
+}
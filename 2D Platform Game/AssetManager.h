@@ -0,0 +1,424 @@
+// 2D Platform Game
+// AssetManager.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the AssetManager class.
+
+#ifndef ASSETMANAGER_H_INCLUDED
+#define ASSETMANAGER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class AssetState : std::uint8_t
+{
+	Loading,
+	Ready,
+	Failed
+};
+
+// Where the time went while loading an asset, in milliseconds.
+struct AssetTimings
+{
+	// From load until a worker thread picked the asset up.
+	double waiting = 0.0;
+
+	// Reading the file on the worker thread.
+	double reading = 0.0;
+
+	// Decoding on the worker thread.
+	double decoding = 0.0;
+
+	// From decoding until the main thread started uploading.
+	double handoff = 0.0;
+
+	// Uploading on the main thread.
+	double uploading = 0.0;
+
+	// From load until the asset was ready or failed.
+	double total = 0.0;
+};
+
+// Shared reference to an asset loaded by an AssetManager.
+// Copies refer to the same asset.
+template <typename T> class AssetHandle
+{
+	friend class AssetManager;
+
+	struct State
+	{
+		std::string path;
+		std::atomic<AssetState> state = AssetState::Loading;
+		std::optional<T> value;
+		std::exception_ptr error;
+		AssetTimings timings;
+		std::promise<void> promise;
+		std::shared_future<void> future = promise.get_future().share();
+	};
+
+	std::shared_ptr<State> state_;
+
+	explicit AssetHandle(std::shared_ptr<State> state)
+		: state_(std::move(state))
+	{
+
+	}
+
+	public:
+
+	// Default constructor.
+	// The AssetHandle refers to no asset.
+	AssetHandle() = default;
+
+	// Returns true if the AssetHandle refers to an asset.
+	// Returns false otherwise.
+	bool valid() const
+	{
+		return state_ != nullptr;
+	}
+
+	// Returns the state of the asset.
+	// This function will throw if the AssetHandle refers to no asset.
+	AssetState state() const
+	{
+		return checkedState().state.load(std::memory_order_acquire);
+	}
+
+	// Returns true if the asset is ready to use.
+	// Returns false otherwise.
+	bool ready() const
+	{
+		return state_ && state() == AssetState::Ready;
+	}
+
+	// Returns the asset.
+	// Rethrows what made the asset fail, and throws if it is still loading.
+	T& get() const
+	{
+		State& state = checkedState();
+
+		switch (state.state.load(std::memory_order_acquire))
+		{
+			case AssetState::Ready: return *state.value;
+			case AssetState::Failed: std::rethrow_exception(state.error);
+			default: throw std::runtime_error("AssetHandle::get: " + state.path + " is still loading");
+		}
+	}
+
+	// Returns the path the asset was loaded from.
+	// This function will throw if the AssetHandle refers to no asset.
+	const std::string& path() const
+	{
+		return checkedState().path;
+	}
+
+	// Returns where the time went while loading the asset.
+	// Only complete once the asset is ready or has failed.
+	// This function will throw if the AssetHandle refers to no asset.
+	const AssetTimings& timings() const
+	{
+		return checkedState().timings;
+	}
+
+	// Returns a future that becomes ready once the asset is ready,
+	// or holds what made it fail, for waiting on other threads.
+	// This function will throw if the AssetHandle refers to no asset.
+	std::shared_future<void> future() const
+	{
+		return checkedState().future;
+	}
+
+	private:
+
+	State& checkedState() const
+	{
+		if (!state_)
+			throw std::invalid_argument("AssetHandle: the handle refers to no asset");
+
+		return *state_;
+	}
+};
+
+// Loads assets in the background so the main thread never waits on
+// the disk or on decoding.
+//  - load queues an asset; the highest priority asset is loaded first,
+//    and equal priorities load in the order they were queued.
+//  - A worker thread reads the file and runs the decode function on
+//    it, such as parsing a level or decoding an image into pixels.
+//  - update, called once per frame on the main thread, runs the upload
+//    function of decoded assets, such as making an sf::Texture from
+//    the pixels, which must happen on the thread that owns the
+//    graphics context. It stops starting uploads once the given time
+//    budget is spent, so a burst of finished loads is spread over
+//    several frames. Then the asset is ready and its callback runs.
+// Every asset records where its load time went; see AssetTimings.
+class AssetManager
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Job
+	{
+		std::string path;
+		std::int32_t priority = 0;
+		std::uint64_t sequence = 0;
+		Clock::time_point queued;
+		Clock::time_point started;
+		Clock::time_point read;
+		Clock::time_point decoded;
+		std::exception_ptr error;
+
+		// False for Jobs that make the asset without reading path.
+		bool reads_file = true;
+
+		virtual ~Job() = default;
+
+		// Decodes the file contents, or makes the asset for Jobs that
+		// do not read a file. Runs on a worker thread.
+		virtual void decode(std::vector<char>& bytes) = 0;
+
+		// Uploads the decoded asset, or fails it if error is set,
+		// and runs the callback. Runs on the main thread.
+		virtual void finish() = 0;
+
+		// Fails the asset without running the callback.
+		virtual void cancel(std::exception_ptr reason) = 0;
+	};
+
+	template <typename T> struct TypedJob : Job
+	{
+		using State = typename AssetHandle<T>::State;
+
+		std::shared_ptr<State> state;
+		std::function<T(std::vector<char>&)> decoder;
+		std::function<T()> generator;
+		std::function<void(T&)> uploader;
+		std::function<void(const AssetHandle<T>&)> on_ready;
+		std::optional<T> value;
+
+		void decode(std::vector<char>& bytes) override
+		{
+			if (generator)
+				value.emplace(generator());
+			else
+				value.emplace(decoder(bytes));
+		}
+
+		void finish() override
+		{
+			const Clock::time_point upload_start = Clock::now();
+
+			if (!error)
+			{
+				try
+				{
+					if (uploader)
+						uploader(*value);
+
+					state->value = std::move(value);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+			}
+
+			const Clock::time_point end = Clock::now();
+			AssetTimings& timings = state->timings;
+
+			timings.waiting = milliseconds(queued, started);
+			timings.reading = milliseconds(started, read);
+			timings.decoding = milliseconds(read, decoded);
+			timings.handoff = milliseconds(decoded, upload_start);
+			timings.uploading = milliseconds(upload_start, end);
+			timings.total = milliseconds(queued, end);
+
+			complete();
+
+			if (on_ready)
+				on_ready(AssetHandle<T>(state));
+		}
+
+		void cancel(std::exception_ptr reason) override
+		{
+			error = reason;
+			state->timings.total = milliseconds(queued, Clock::now());
+			complete();
+		}
+
+		void complete()
+		{
+			if (error)
+			{
+				state->error = error;
+				state->state.store(AssetState::Failed, std::memory_order_release);
+				state->promise.set_exception(error);
+			}
+			else
+			{
+				state->state.store(AssetState::Ready, std::memory_order_release);
+				state->promise.set_value();
+			}
+		}
+	};
+
+	std::vector<std::thread> threads_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable queued_;
+	std::condition_variable decoded_;
+
+	// Max-heap on priority, then on how early the Job was queued.
+	std::vector<std::unique_ptr<Job>> queue_;
+
+	// Jobs decoded and waiting for update, oldest first.
+	std::deque<std::unique_ptr<Job>> done_;
+
+	// Jobs queued, being decoded or waiting for update.
+	std::size_t pending_ = 0;
+	std::uint64_t next_sequence_ = 0;
+	bool stopping_ = false;
+
+	static double milliseconds(Clock::time_point begin, Clock::time_point end);
+
+	// Orders queue_: returns true if a loads after b.
+	static bool loadsAfter(const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b);
+
+	// Returns a Job for an asset with the given path, before its decode
+	// or generate function is set.
+	template <typename T> static std::unique_ptr<TypedJob<T>> makeJob(const std::string& path, std::function<void(T&)> upload, std::function<void(const AssetHandle<T>&)> on_ready)
+	{
+		std::unique_ptr<TypedJob<T>> job = std::make_unique<TypedJob<T>>();
+		job->path = path;
+		job->state = std::make_shared<typename TypedJob<T>::State>();
+		job->state->path = path;
+		job->uploader = std::move(upload);
+		job->on_ready = std::move(on_ready);
+
+		return job;
+	}
+
+	// Queues job and wakes a worker.
+	void enqueue(std::unique_ptr<Job> job, std::int32_t priority);
+
+	// Body of each worker thread.
+	void run();
+
+	// Blocks until a decoded Job is waiting for update, or none are pending.
+	void waitForDecoded();
+
+	public:
+
+	// Default constructor.
+	// Starts two worker threads, enough to keep the disk busy
+	// while another asset decodes.
+	AssetManager();
+
+	// Thread count constructor.
+	// Starts the given amount of worker threads.
+	// This function will throw if thread_count is 0.
+	explicit AssetManager(std::size_t thread_count);
+
+	// Copy constructor. Deleted.
+	AssetManager(const AssetManager& other) = delete;
+
+	// Move constructor. Deleted.
+	AssetManager(AssetManager&& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	AssetManager& operator = (const AssetManager& other) = delete;
+
+	// Move assignment operator. Deleted.
+	AssetManager& operator = (AssetManager&& other) = delete;
+
+	// Destructor.
+	// Waits for the assets being decoded, then fails every asset that
+	// is not ready yet without running their callbacks.
+	~AssetManager();
+
+	// Queues the file at path for loading and returns a handle to it.
+	// decode turns the file contents into the asset on a worker thread,
+	// and may take the bytes. upload, if given, runs on the main thread
+	// during update before the asset is ready. on_ready, if given, runs
+	// on the main thread once the asset is ready or has failed.
+	// An exception thrown while reading, decoding or uploading fails
+	// the asset; AssetHandle::get rethrows it.
+	template <typename T> AssetHandle<T> load(const std::string& path, std::int32_t priority, std::function<T(std::vector<char>&)> decode, std::function<void(T&)> upload = nullptr, std::function<void(const AssetHandle<T>&)> on_ready = nullptr)
+	{
+		if (!decode)
+			throw std::invalid_argument("AssetManager::load: decode must be set");
+
+		std::unique_ptr<TypedJob<T>> job = makeJob<T>(path, std::move(upload), std::move(on_ready));
+		job->decoder = std::move(decode);
+
+		AssetHandle<T> handle(job->state);
+		enqueue(std::move(job), priority);
+
+		return handle;
+	}
+
+	// Queues an asset that does its own I/O, or none, such as one read
+	// through a cache or generated, and returns a handle to it.
+	// generate makes the asset on a worker thread; name is only used
+	// for AssetHandle::path. Otherwise the same as load.
+	template <typename T> AssetHandle<T> generate(const std::string& name, std::int32_t priority, std::function<T()> generate, std::function<void(T&)> upload = nullptr, std::function<void(const AssetHandle<T>&)> on_ready = nullptr)
+	{
+		if (!generate)
+			throw std::invalid_argument("AssetManager::generate: generate must be set");
+
+		std::unique_ptr<TypedJob<T>> job = makeJob<T>(name, std::move(upload), std::move(on_ready));
+		job->generator = std::move(generate);
+		job->reads_file = false;
+
+		AssetHandle<T> handle(job->state);
+		enqueue(std::move(job), priority);
+
+		return handle;
+	}
+
+	// Uploads decoded assets and runs their callbacks, until every one
+	// is done or the given amount of milliseconds have passed. At least
+	// one asset is finished if any is waiting, so loading always moves on.
+	// An exception thrown by a callback is passed on; the asset it
+	// belongs to stays finished.
+	// Must be called on the main thread.
+	// Returns the amount of assets that became ready or failed.
+	std::size_t update(double budget_milliseconds = 2.0);
+
+	// Calls update until the given asset is ready or has failed,
+	// blocking while it is still being loaded. For loading screens and
+	// startup, when there is nothing else to do.
+	// Must be called on the main thread.
+	template <typename T> void wait(const AssetHandle<T>& handle)
+	{
+		while (handle.state() == AssetState::Loading)
+		{
+			if (update(std::numeric_limits<double>::infinity()) == 0)
+				waitForDecoded();
+		}
+	}
+
+	// Returns the amount of assets queued, loading or waiting for update.
+	std::size_t pendingCount() const;
+
+	// Returns the amount of worker threads.
+	std::size_t threadCount() const;
+};
+
+#endif // ASSETMANAGER_H_INCLUDED
@@ -0,0 +1,521 @@
+// 2D Platform Game
+// AudioMixer.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the AudioMixer class.
+
+#include "AudioMixer.h"
+
+#include "Jlib/Angle.h"
+#include "Jlib/Simd.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// <chrono>
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int64_t;
+
+// <stdexcept>
+using std::invalid_argument;
+
+namespace
+{
+	constexpr float QUARTER_PI = std::numbers::pi_v<float> / 4.0f;
+
+	// Constant power panning gives each side cos or sin of the pan
+	// angle; scaled so a voice in the centre plays at its full volume.
+	constexpr float PAN_SCALE = std::numbers::sqrt2_v<float>;
+
+	// Adds count samples to left and right, with gains starting at
+	// left_gain and right_gain and growing by their steps each frame.
+	void mix_voice(const float* samples, size_t count, float* left, float* right, float left_gain, float right_gain, float left_step, float right_step)
+	{
+		size_t i = 0;
+
+		#ifdef JLIB_SSE2
+		const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+		const __m128 left_step4 = _mm_set1_ps(left_step * 4.0f);
+		const __m128 right_step4 = _mm_set1_ps(right_step * 4.0f);
+		__m128 left_gains = _mm_add_ps(_mm_set1_ps(left_gain), _mm_mul_ps(lanes, _mm_set1_ps(left_step)));
+		__m128 right_gains = _mm_add_ps(_mm_set1_ps(right_gain), _mm_mul_ps(lanes, _mm_set1_ps(right_step)));
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 sample = _mm_loadu_ps(samples + i);
+
+			_mm_storeu_ps(left + i, _mm_add_ps(_mm_loadu_ps(left + i), _mm_mul_ps(sample, left_gains)));
+			_mm_storeu_ps(right + i, _mm_add_ps(_mm_loadu_ps(right + i), _mm_mul_ps(sample, right_gains)));
+
+			left_gains = _mm_add_ps(left_gains, left_step4);
+			right_gains = _mm_add_ps(right_gains, right_step4);
+		}
+		#endif // JLIB_SSE2
+
+		for (; i < count; ++i)
+		{
+			left[i] += samples[i] * (left_gain + left_step * float(i));
+			right[i] += samples[i] * (right_gain + right_step * float(i));
+		}
+	}
+
+	// Interleaves left and right into output, scaled by a gain starting
+	// at gain and growing by step each frame, and clamped to [-1, 1].
+	void write_frames(const float* left, const float* right, float* output, size_t count, float gain, float step)
+	{
+		size_t i = 0;
+
+		#ifdef JLIB_SSE2
+		const __m128 low = _mm_set1_ps(-1.0f);
+		const __m128 high = _mm_set1_ps(1.0f);
+		const __m128 step4 = _mm_set1_ps(step * 4.0f);
+		__m128 gains = _mm_add_ps(_mm_set1_ps(gain), _mm_mul_ps(_mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f), _mm_set1_ps(step)));
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128 l = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(left + i), gains), low), high);
+			const __m128 r = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(right + i), gains), low), high);
+
+			_mm_storeu_ps(output + i * 2, _mm_unpacklo_ps(l, r));
+			_mm_storeu_ps(output + i * 2 + 4, _mm_unpackhi_ps(l, r));
+
+			gains = _mm_add_ps(gains, step4);
+		}
+		#endif // JLIB_SSE2
+
+		for (; i < count; ++i)
+		{
+			const float g = gain + step * float(i);
+
+			output[i * 2] = std::clamp(left[i] * g, -1.0f, 1.0f);
+			output[i * 2 + 1] = std::clamp(right[i] * g, -1.0f, 1.0f);
+		}
+	}
+}
+
+AudioMixer::AudioMixer(AudioSink& sink, const MixerSettings& settings)
+	: sink_(&sink), settings_(settings)
+{
+	if (settings.block_frames == 0)
+		throw invalid_argument("AudioMixer: block_frames must not be 0");
+
+	if (!(settings.min_distance > 0.0f) || !(settings.pan_distance > 0.0f) || !(settings.rolloff >= 0.0f))
+		throw invalid_argument("AudioMixer: min_distance and pan_distance must be positive, and rolloff not negative");
+
+	ids_.resize(MAX_VOICES);
+	clips_.resize(MAX_VOICES);
+	cursors_.resize(MAX_VOICES);
+	volumes_.resize(MAX_VOICES);
+	x_.resize(MAX_VOICES);
+	y_.resize(MAX_VOICES);
+	positional_.resize(MAX_VOICES);
+	loops_.resize(MAX_VOICES);
+	stopping_voices_.resize(MAX_VOICES);
+	left_gains_.resize(MAX_VOICES);
+	right_gains_.resize(MAX_VOICES);
+	target_left_.resize(MAX_VOICES);
+	target_right_.resize(MAX_VOICES);
+	pan_angles_.resize(MAX_VOICES);
+	amplitudes_.resize(MAX_VOICES);
+
+	left_.resize(settings.block_frames);
+	right_.resize(settings.block_frames);
+	output_.resize(settings.block_frames * 2);
+
+	thread_ = std::thread(&AudioMixer::run, this);
+}
+
+AudioMixer::~AudioMixer()
+{
+	stopping_.store(true, std::memory_order_relaxed);
+	thread_.join();
+}
+
+bool AudioMixer::send(const Command& command)
+{
+	if (failed_.load(std::memory_order_acquire))
+		std::rethrow_exception(exception_);
+
+	if (commands_.tryPush(command))
+		return true;
+
+	dropped_commands_.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+size_t AudioMixer::find(VoiceId voice) const
+{
+	for (size_t i = 0; i < voice_count_; ++i)
+	{
+		if (ids_[i] == voice)
+			return i;
+	}
+
+	return voice_count_;
+}
+
+void AudioMixer::remove(size_t index)
+{
+	const size_t last = --voice_count_;
+
+	ids_[index] = ids_[last];
+	clips_[index] = clips_[last];
+	cursors_[index] = cursors_[last];
+	volumes_[index] = volumes_[last];
+	x_[index] = x_[last];
+	y_[index] = y_[last];
+	positional_[index] = positional_[last];
+	loops_[index] = loops_[last];
+	stopping_voices_[index] = stopping_voices_[last];
+	left_gains_[index] = left_gains_[last];
+	right_gains_[index] = right_gains_[last];
+	target_left_[index] = target_left_[last];
+	target_right_[index] = target_right_[last];
+}
+
+void AudioMixer::apply(const Command& command)
+{
+	if (command.type == CommandType::Play)
+	{
+		if (voice_count_ == MAX_VOICES)
+		{
+			stats_.dropped_voices.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		const size_t i = voice_count_++;
+
+		ids_[i] = command.voice;
+		clips_[i] = command.clip;
+		cursors_[i] = 0;
+		volumes_[i] = command.volume;
+		x_[i] = command.position.x;
+		y_[i] = command.position.y;
+		positional_[i] = command.positional;
+		loops_[i] = command.loop;
+		stopping_voices_[i] = false;
+
+		// Starts at its gains rather than ramping up to them, so the
+		// attack of the sound is kept.
+		left_gains_[i] = -1.0f;
+		right_gains_[i] = -1.0f;
+
+		return;
+	}
+
+	if (command.type == CommandType::SetListener)
+	{
+		listener_ = command.position;
+		return;
+	}
+
+	if (command.type == CommandType::SetMasterVolume)
+	{
+		master_volume_ = command.volume;
+		return;
+	}
+
+	// The rest act on a voice, which may have ended since.
+	const size_t i = find(command.voice);
+
+	if (i == voice_count_)
+		return;
+
+	switch (command.type)
+	{
+		case CommandType::Stop:
+			stopping_voices_[i] = true;
+			break;
+
+		case CommandType::SetVolume:
+			volumes_[i] = command.volume;
+			break;
+
+		case CommandType::SetPosition:
+			x_[i] = command.position.x;
+			y_[i] = command.position.y;
+			break;
+
+		default:
+			break;
+	}
+}
+
+void AudioMixer::updateGains()
+{
+	for (size_t i = 0; i < voice_count_; ++i)
+	{
+		if (!positional_[i])
+		{
+			pan_angles_[i] = QUARTER_PI;
+			amplitudes_[i] = volumes_[i];
+			continue;
+		}
+
+		const float dx = x_[i] - listener_.x;
+		const float dy = y_[i] - listener_.y;
+		const float distance = std::sqrt(dx * dx + dy * dy);
+		const float excess = std::max(distance - settings_.min_distance, 0.0f);
+		const float attenuation = settings_.min_distance / (settings_.min_distance + settings_.rolloff * excess);
+		const float pan = std::clamp(dx / settings_.pan_distance, -1.0f, 1.0f);
+
+		pan_angles_[i] = (pan + 1.0f) * QUARTER_PI;
+		amplitudes_[i] = volumes_[i] * attenuation;
+	}
+
+	// Cosine for the left side, sine for the right.
+	Jlib::fast_sincos(pan_angles_.data(), target_right_.data(), target_left_.data(), voice_count_);
+
+	for (size_t i = 0; i < voice_count_; ++i)
+	{
+		// Gains are never negative, which apply relies on to mark new voices.
+		const float amplitude = stopping_voices_[i] ? 0.0f : std::max(amplitudes_[i], 0.0f) * PAN_SCALE;
+
+		target_left_[i] = std::max(target_left_[i], 0.0f) * amplitude;
+		target_right_[i] = std::max(target_right_[i], 0.0f) * amplitude;
+
+		if (left_gains_[i] < 0.0f)
+		{
+			left_gains_[i] = target_left_[i];
+			right_gains_[i] = target_right_[i];
+		}
+	}
+}
+
+void AudioMixer::mixBlock()
+{
+	const size_t block = settings_.block_frames;
+	const float inverse_block = 1.0f / float(block);
+
+	commands_.popAll([this](const Command& command) { apply(command); });
+	updateGains();
+
+	std::fill(left_.begin(), left_.end(), 0.0f);
+	std::fill(right_.begin(), right_.end(), 0.0f);
+
+	stats_.voice_blocks.fetch_add(voice_count_, std::memory_order_relaxed);
+
+	for (size_t i = 0; i < voice_count_;)
+	{
+		const float* const samples = clips_[i]->samples.data();
+		const size_t size = clips_[i]->samples.size();
+		const float left_step = (target_left_[i] - left_gains_[i]) * inverse_block;
+		const float right_step = (target_right_[i] - right_gains_[i]) * inverse_block;
+
+		size_t cursor = cursors_[i];
+		size_t done = 0;
+		bool ended = false;
+
+		while (done < block)
+		{
+			const size_t count = std::min(block - done, size - cursor);
+
+			mix_voice(samples + cursor, count, left_.data() + done, right_.data() + done, left_gains_[i] + left_step * float(done), right_gains_[i] + right_step * float(done), left_step, right_step);
+
+			done += count;
+			cursor += count;
+
+			if (cursor == size)
+			{
+				if (!loops_[i])
+				{
+					ended = true;
+					break;
+				}
+
+				cursor = 0;
+			}
+		}
+
+		// A stopped voice has faded out by the end of the block.
+		if (ended || stopping_voices_[i])
+		{
+			// Brings the last voice here, which has not been mixed yet.
+			remove(i);
+			continue;
+		}
+
+		cursors_[i] = cursor;
+		left_gains_[i] = target_left_[i];
+		right_gains_[i] = target_right_[i];
+		++i;
+	}
+
+	write_frames(left_.data(), right_.data(), output_.data(), block, master_gain_, (master_volume_ - master_gain_) * inverse_block);
+	master_gain_ = master_volume_;
+}
+
+void AudioMixer::run()
+{
+	const size_t block = settings_.block_frames;
+	const nanoseconds block_duration(int64_t(double(block) * 1e9 / double(sink_->sampleRate())));
+	const nanoseconds buffered_duration = block_duration * int64_t(settings_.buffered_blocks);
+
+	// When paced, the time the audio written so far runs out.
+	steady_clock::time_point play_end;
+	bool started = false;
+
+	try
+	{
+		while (!stopping_.load(std::memory_order_relaxed))
+		{
+			const steady_clock::time_point start = steady_clock::now();
+
+			mixBlock();
+
+			const int64_t mix_nanoseconds = duration_cast<nanoseconds>(steady_clock::now() - start).count();
+
+			stats_.blocks.fetch_add(1, std::memory_order_relaxed);
+			stats_.total_nanoseconds.fetch_add(mix_nanoseconds, std::memory_order_relaxed);
+
+			int64_t max = stats_.max_nanoseconds.load(std::memory_order_relaxed);
+
+			while (mix_nanoseconds > max && !stats_.max_nanoseconds.compare_exchange_weak(max, mix_nanoseconds, std::memory_order_relaxed));
+
+			if (!sink_->write(output_.data(), block))
+				stats_.underruns.fetch_add(1, std::memory_order_relaxed);
+
+			if (!settings_.paced)
+				continue;
+
+			const steady_clock::time_point now = steady_clock::now();
+
+			if (!started)
+			{
+				play_end = now;
+				started = true;
+			}
+			else if (now > play_end)
+			{
+				// The device played everything before this block arrived.
+				stats_.underruns.fetch_add(1, std::memory_order_relaxed);
+				play_end = now;
+			}
+
+			play_end += block_duration;
+			std::this_thread::sleep_until(play_end - buffered_duration);
+		}
+	}
+	catch (...)
+	{
+		exception_ = std::current_exception();
+		failed_.store(true, std::memory_order_release);
+	}
+}
+
+VoiceId AudioMixer::play(const AudioClip& clip, float volume, bool loop)
+{
+	if (clip.samples.empty())
+		throw invalid_argument("AudioMixer::play: the clip must not be empty");
+
+	Command command;
+	command.type = CommandType::Play;
+	command.voice = next_voice_;
+	command.clip = &clip;
+	command.volume = volume;
+	command.loop = loop;
+
+	if (!send(command))
+		return 0;
+
+	// Skips 0 when the ids wrap around.
+	next_voice_ = next_voice_ + 1 != 0 ? next_voice_ + 1 : 1;
+	return command.voice;
+}
+
+VoiceId AudioMixer::playAt(const AudioClip& clip, const Point2f& position, float volume, bool loop)
+{
+	if (clip.samples.empty())
+		throw invalid_argument("AudioMixer::playAt: the clip must not be empty");
+
+	Command command;
+	command.type = CommandType::Play;
+	command.positional = true;
+	command.voice = next_voice_;
+	command.clip = &clip;
+	command.volume = volume;
+	command.loop = loop;
+	command.position = position;
+
+	if (!send(command))
+		return 0;
+
+	next_voice_ = next_voice_ + 1 != 0 ? next_voice_ + 1 : 1;
+	return command.voice;
+}
+
+void AudioMixer::stop(VoiceId voice)
+{
+	Command command;
+	command.type = CommandType::Stop;
+	command.voice = voice;
+	send(command);
+}
+
+void AudioMixer::setVolume(VoiceId voice, float volume)
+{
+	Command command;
+	command.type = CommandType::SetVolume;
+	command.voice = voice;
+	command.volume = volume;
+	send(command);
+}
+
+void AudioMixer::setPosition(VoiceId voice, const Point2f& position)
+{
+	Command command;
+	command.type = CommandType::SetPosition;
+	command.voice = voice;
+	command.position = position;
+	send(command);
+}
+
+void AudioMixer::setListener(const Point2f& position)
+{
+	Command command;
+	command.type = CommandType::SetListener;
+	command.position = position;
+	send(command);
+}
+
+void AudioMixer::setMasterVolume(float volume)
+{
+	Command command;
+	command.type = CommandType::SetMasterVolume;
+	command.volume = volume;
+	send(command);
+}
+
+MixerReport AudioMixer::takeReport()
+{
+	MixerReport report;
+
+	report.blocks = stats_.blocks.exchange(0, std::memory_order_relaxed);
+	const int64_t total = stats_.total_nanoseconds.exchange(0, std::memory_order_relaxed);
+	report.max_block_microseconds = double(stats_.max_nanoseconds.exchange(0, std::memory_order_relaxed)) / 1e3;
+	report.mean_block_microseconds = report.blocks != 0 ? double(total) / double(report.blocks) / 1e3 : 0.0;
+
+	// Includes each voice's share of the work done once per block.
+	report.voice_blocks = stats_.voice_blocks.exchange(0, std::memory_order_relaxed);
+	report.nanoseconds_per_voice_frame = report.voice_blocks != 0 ? double(total) / (double(report.voice_blocks) * double(settings_.block_frames)) : 0.0;
+
+	report.underruns = stats_.underruns.exchange(0, std::memory_order_relaxed);
+	report.dropped_commands = dropped_commands_.exchange(0, std::memory_order_relaxed);
+	report.dropped_voices = stats_.dropped_voices.exchange(0, std::memory_order_relaxed);
+
+	return report;
+}
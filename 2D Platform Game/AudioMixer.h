@@ -0,0 +1,245 @@
+// 2D Platform Game
+// AudioMixer.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the AudioClip struct and the AudioMixer class.
+
+#ifndef AUDIOMIXER_H_INCLUDED
+#define AUDIOMIXER_H_INCLUDED
+
+#include "AudioSink.h"
+
+#include "Jlib/Point.h"
+#include "Jlib/SpscQueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// A mono sound, at the sample rate of the sink it is played on.
+struct AudioClip
+{
+	std::vector<float> samples;
+};
+
+// Identifies a playing voice. 0 is never a voice.
+using VoiceId = std::uint32_t;
+
+// How the mixer runs and how positional voices fade with distance.
+struct MixerSettings
+{
+	// Frames mixed at once. Smaller blocks react sooner and cost more.
+	std::size_t block_frames = 256;
+
+	// When true, the mixer keeps to the sample rate of the sink by its
+	// own clock, as a device would, keeping buffered_blocks blocks
+	// ahead, and counts an underrun whenever a block is late.
+	// For sinks without a clock, such as NullAudioSink. Leave it false
+	// for sinks that block, and to mix as fast as possible.
+	bool paced = false;
+	std::size_t buffered_blocks = 4;
+
+	// Distances in tiles. Positional voices play at full volume within
+	// min_distance of the listener, and fade by min_distance /
+	// (min_distance + rolloff * (distance - min_distance)) past it.
+	float min_distance = 4.0f;
+	float rolloff = 1.0f;
+
+	// Horizontal distance at which a positional voice plays from one
+	// side only.
+	float pan_distance = 16.0f;
+};
+
+// Mixing times and problems since the last AudioMixer::takeReport.
+struct MixerReport
+{
+	std::size_t blocks = 0;
+	double mean_block_microseconds = 0.0;
+	double max_block_microseconds = 0.0;
+
+	// Voices mixed, summed over the blocks, and the mixing time per
+	// voice per frame.
+	std::size_t voice_blocks = 0;
+	double nanoseconds_per_voice_frame = 0.0;
+
+	// Blocks the sink ran out of audio before.
+	std::size_t underruns = 0;
+
+	// Commands dropped because the queue was full, and plays dropped
+	// because every voice was in use.
+	std::size_t dropped_commands = 0;
+	std::size_t dropped_voices = 0;
+};
+
+// Mixes every playing sound on its own thread and sends the result to
+// an AudioSink.
+// The game thread sends commands through a Jlib::SpscQueue, so neither
+// thread takes a lock; the mixer applies every command waiting at the
+// start of each block. Voices are kept as arrays of each field, with
+// the ones playing packed at the front, and mixed 4 frames at a time
+// with SSE2 where Jlib/Simd.h finds it.
+// Positional voices are attenuated by their distance to the listener,
+// which the game moves each tick to camera_position or player_position,
+// and panned by how far left or right of it they are. Gain changes,
+// stops included, ramp over one block so they never click.
+class AudioMixer
+{
+	public:
+
+	static constexpr std::size_t MAX_VOICES = 256;
+	static constexpr std::size_t COMMAND_CAPACITY = 1024;
+
+	private:
+
+	enum class CommandType : std::uint8_t
+	{
+		Play,
+		Stop,
+		SetVolume,
+		SetPosition,
+		SetListener,
+		SetMasterVolume
+	};
+
+	struct Command
+	{
+		CommandType type = CommandType::Play;
+		bool positional = false;
+		bool loop = false;
+		VoiceId voice = 0;
+		const AudioClip* clip = nullptr;
+		float volume = 1.0f;
+		Jlib::Point2f position;
+	};
+
+	// Mixing times added by the mixer thread and taken by the game thread.
+	struct MixerStats
+	{
+		std::atomic<std::size_t> blocks = 0;
+		std::atomic<std::int64_t> total_nanoseconds = 0;
+		std::atomic<std::int64_t> max_nanoseconds = 0;
+		std::atomic<std::size_t> voice_blocks = 0;
+		std::atomic<std::size_t> underruns = 0;
+		std::atomic<std::size_t> dropped_voices = 0;
+	};
+
+	AudioSink* sink_ = nullptr;
+	MixerSettings settings_;
+
+	Jlib::SpscQueue<Command, COMMAND_CAPACITY> commands_;
+
+	// Game thread only.
+	VoiceId next_voice_ = 1;
+
+	// Mixer thread only. Voices [0, voice_count_) are playing.
+	std::size_t voice_count_ = 0;
+	std::vector<VoiceId> ids_;
+	std::vector<const AudioClip*> clips_;
+	std::vector<std::size_t> cursors_;
+	std::vector<float> volumes_;
+	std::vector<float> x_;
+	std::vector<float> y_;
+	std::vector<std::uint8_t> positional_;
+	std::vector<std::uint8_t> loops_;
+	std::vector<std::uint8_t> stopping_voices_;
+
+	// Mixer thread only. Gains of each voice at the end of the last
+	// block, and the ones to ramp to by the end of this one.
+	std::vector<float> left_gains_;
+	std::vector<float> right_gains_;
+	std::vector<float> target_left_;
+	std::vector<float> target_right_;
+	std::vector<float> pan_angles_;
+	std::vector<float> amplitudes_;
+
+	// Mixer thread only.
+	Jlib::Point2f listener_;
+	float master_volume_ = 1.0f;
+	float master_gain_ = 1.0f;
+	std::vector<float> left_;
+	std::vector<float> right_;
+	std::vector<float> output_;
+
+	std::atomic<bool> stopping_ = false;
+	std::atomic<std::size_t> dropped_commands_ = 0;
+
+	// exception_ is written before failed_ is set, and read after.
+	std::exception_ptr exception_;
+	std::atomic<bool> failed_ = false;
+
+	MixerStats stats_;
+
+	std::thread thread_;
+
+	// Game thread only. Queues command, rethrowing the exception that
+	// stopped the mixer thread if there was one.
+	// Returns false if the queue was full.
+	bool send(const Command& command);
+
+	// Mixer thread only.
+	void apply(const Command& command);
+	std::size_t find(VoiceId voice) const;
+	void remove(std::size_t index);
+	void updateGains();
+	void mixBlock();
+
+	// Body of the mixer thread.
+	void run();
+
+	public:
+
+	// Sink and settings constructor.
+	// Starts the mixer thread, which writes to sink until the AudioMixer
+	// is destroyed. sink must outlive the AudioMixer.
+	// Throws a std::invalid_argument if block_frames is 0, or a distance
+	// in settings is not positive.
+	explicit AudioMixer(AudioSink& sink, const MixerSettings& settings = MixerSettings());
+
+	// Copy constructor. Deleted.
+	AudioMixer(const AudioMixer& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	AudioMixer& operator = (const AudioMixer& other) = delete;
+
+	// Destructor.
+	// Stops the mixer thread after the block it is mixing.
+	~AudioMixer();
+
+	// Game thread only, as are all the functions below.
+	// Plays clip at volume on both sides, as for music and menus.
+	// clip must outlive the voice: keep clips for as long as the mixer.
+	// Returns the id of the voice, or 0 if the queue was full.
+	// Throws a std::invalid_argument if clip is empty.
+	VoiceId play(const AudioClip& clip, float volume = 1.0f, bool loop = false);
+
+	// Plays clip from position, in tiles, attenuated and panned relative
+	// to the listener.
+	// Returns the id of the voice, or 0 if the queue was full.
+	// Throws a std::invalid_argument if clip is empty.
+	VoiceId playAt(const AudioClip& clip, const Jlib::Point2f& position, float volume = 1.0f, bool loop = false);
+
+	// Fades the voice out over one block. Does nothing if it has ended.
+	void stop(VoiceId voice);
+
+	// Changes the volume of the voice.
+	void setVolume(VoiceId voice, float volume);
+
+	// Moves a positional voice.
+	void setPosition(VoiceId voice, const Jlib::Point2f& position);
+
+	// Moves the listener, in tiles.
+	void setListener(const Jlib::Point2f& position);
+
+	// Scales everything the mixer plays.
+	void setMasterVolume(float volume);
+
+	// Returns the mixing times since the last call, and starts counting
+	// again.
+	MixerReport takeReport();
+};
+
+#endif // AUDIOMIXER_H_INCLUDED
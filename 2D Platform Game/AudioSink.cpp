@@ -0,0 +1,193 @@
+// 2D Platform Game
+// AudioSink.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the AudioSink, NullAudioSink and WavFileAudioSink classes.
+
+#include "AudioSink.h"
+
+#include "Jlib/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int16_t;
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <stdexcept>
+using std::invalid_argument;
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+namespace
+{
+	constexpr size_t WAV_HEADER_SIZE = 44;
+	constexpr uint16_t WAV_CHANNELS = 2;
+	constexpr uint16_t WAV_BITS = 16;
+
+	// WAV files are little endian whatever the machine is.
+	void put_u16(uint8_t* bytes, uint16_t value)
+	{
+		bytes[0] = uint8_t(value);
+		bytes[1] = uint8_t(value >> 8);
+	}
+
+	void put_u32(uint8_t* bytes, uint32_t value)
+	{
+		for (size_t i = 0; i < 4; ++i)
+			bytes[i] = uint8_t(value >> (i * 8));
+	}
+
+	// Converts count samples in [-1, 1] to 16-bit, clamping the rest.
+	void to_int16(const float* samples, int16_t* result, size_t count)
+	{
+		size_t i = 0;
+
+		#ifdef JLIB_SSE2
+		const __m128 scale = _mm_set1_ps(32767.0f);
+
+		// packs saturates, so only the conversion needs care.
+		for (; i + 8 <= count; i += 8)
+		{
+			const __m128i low = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)), scale));
+			const __m128i high = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i + 4), _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)), scale));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_packs_epi32(low, high));
+		}
+		#endif // JLIB_SSE2
+
+		for (; i < count; ++i)
+			result[i] = int16_t(std::lrint(std::clamp(samples[i], -1.0f, 1.0f) * 32767.0f));
+	}
+}
+
+NullAudioSink::NullAudioSink(uint32_t sample_rate)
+	: sample_rate_(sample_rate)
+{
+	if (sample_rate == 0)
+		throw invalid_argument("NullAudioSink: the sample rate must not be 0");
+}
+
+uint32_t NullAudioSink::sampleRate() const
+{
+	return sample_rate_;
+}
+
+bool NullAudioSink::write(const float*, size_t frame_count)
+{
+	frames_.fetch_add(frame_count, std::memory_order_relaxed);
+	return true;
+}
+
+uint64_t NullAudioSink::frameCount() const
+{
+	return frames_.load(std::memory_order_relaxed);
+}
+
+WavFileAudioSink::WavFileAudioSink(const string& path, uint32_t sample_rate)
+	: sample_rate_(sample_rate), path_(path)
+{
+	if (sample_rate == 0)
+		throw invalid_argument("WavFileAudioSink: the sample rate must not be 0");
+
+	fout_.open(path, std::ios::binary | std::ios::trunc);
+
+	if (!fout_.is_open())
+		throw runtime_error("WavFileAudioSink: could not open " + path);
+
+	// Written again with the sizes by close.
+	writeHeader();
+}
+
+WavFileAudioSink::~WavFileAudioSink()
+{
+	if (fout_.is_open())
+	{
+		writeHeader();
+		fout_.close();
+	}
+}
+
+void WavFileAudioSink::writeHeader()
+{
+	// A RIFF chunk size is 32 bits; longer files keep the largest size.
+	const uint64_t data_size = std::min<uint64_t>(frames_ * WAV_CHANNELS * (WAV_BITS / 8), 0xFFFFFFFFu - (WAV_HEADER_SIZE - 8));
+	uint8_t header[WAV_HEADER_SIZE];
+
+	std::copy_n("RIFF", 4, header);
+	put_u32(header + 4, uint32_t(data_size + WAV_HEADER_SIZE - 8));
+	std::copy_n("WAVEfmt ", 8, header + 8);
+	put_u32(header + 16, 16);
+	put_u16(header + 20, 1);
+	put_u16(header + 22, WAV_CHANNELS);
+	put_u32(header + 24, sample_rate_);
+	put_u32(header + 28, sample_rate_ * WAV_CHANNELS * (WAV_BITS / 8));
+	put_u16(header + 32, WAV_CHANNELS * (WAV_BITS / 8));
+	put_u16(header + 34, WAV_BITS);
+	std::copy_n("data", 4, header + 36);
+	put_u32(header + 40, uint32_t(data_size));
+
+	const std::streampos end = fout_.tellp();
+
+	fout_.seekp(0);
+	fout_.write(reinterpret_cast<const char*>(header), std::streamsize(WAV_HEADER_SIZE));
+
+	if (end > std::streampos(WAV_HEADER_SIZE))
+		fout_.seekp(end);
+}
+
+uint32_t WavFileAudioSink::sampleRate() const
+{
+	return sample_rate_;
+}
+
+bool WavFileAudioSink::write(const float* samples, size_t frame_count)
+{
+	if (!fout_.is_open())
+		throw runtime_error("WavFileAudioSink: " + path_ + " is closed");
+
+	const size_t count = frame_count * WAV_CHANNELS;
+
+	// Samples are written in the byte order of the machine, little
+	// endian on everything the game builds for.
+	converted_.resize(count);
+	to_int16(samples, converted_.data(), count);
+
+	fout_.write(reinterpret_cast<const char*>(converted_.data()), std::streamsize(count * sizeof(int16_t)));
+
+	if (!fout_)
+		throw runtime_error("WavFileAudioSink: could not write " + path_);
+
+	frames_ += frame_count;
+
+	// A file never runs out of audio.
+	return true;
+}
+
+uint64_t WavFileAudioSink::frameCount() const
+{
+	return frames_;
+}
+
+void WavFileAudioSink::close()
+{
+	if (!fout_.is_open())
+		return;
+
+	writeHeader();
+	fout_.close();
+
+	if (!fout_)
+		throw runtime_error("WavFileAudioSink: could not write " + path_);
+}
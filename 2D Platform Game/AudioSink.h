@@ -0,0 +1,105 @@
+// 2D Platform Game
+// AudioSink.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the AudioSink, NullAudioSink and WavFileAudioSink classes.
+
+#ifndef AUDIOSINK_H_INCLUDED
+#define AUDIOSINK_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Where the AudioMixer sends what it mixes: a sound device, a file, or
+// nowhere.
+// Audio is given as frames of 2 floats, left then right, in [-1, 1].
+class AudioSink
+{
+	public:
+
+	// Default constructor.
+	AudioSink() = default;
+
+	// Copy constructor. Deleted.
+	AudioSink(const AudioSink& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	AudioSink& operator = (const AudioSink& other) = delete;
+
+	// Destructor.
+	virtual ~AudioSink() = default;
+
+	// Returns the frames played per second.
+	virtual std::uint32_t sampleRate() const = 0;
+
+	// Mixer thread only.
+	// Plays frame_count frames from samples. A sink playing to a device
+	// blocks until the device has room for them.
+	// Returns false if the device ran out of audio before they arrived.
+	// Returns true otherwise.
+	virtual bool write(const float* samples, std::size_t frame_count) = 0;
+};
+
+// Discards the audio, counting the frames written. For running the game
+// without a sound device, and for timing the mixer.
+class NullAudioSink : public AudioSink
+{
+	std::uint32_t sample_rate_ = 0;
+	std::atomic<std::uint64_t> frames_ = 0;
+
+	public:
+
+	// Sample rate constructor.
+	explicit NullAudioSink(std::uint32_t sample_rate);
+
+	std::uint32_t sampleRate() const override;
+
+	bool write(const float* samples, std::size_t frame_count) override;
+
+	// Returns the amount of frames written so far.
+	std::uint64_t frameCount() const;
+};
+
+// Writes the audio to a 16-bit stereo WAV file, to listen to or compare
+// what the mixer made without a sound device.
+// The sizes in the header are filled in by close, or by the destructor.
+class WavFileAudioSink : public AudioSink
+{
+	std::uint32_t sample_rate_ = 0;
+	std::string path_;
+	std::ofstream fout_;
+	std::uint64_t frames_ = 0;
+	std::vector<std::int16_t> converted_;
+
+	// Writes the header for the frames written so far.
+	void writeHeader();
+
+	public:
+
+	// Path and sample rate constructor.
+	// Throws a std::runtime_error if the file cannot be opened.
+	WavFileAudioSink(const std::string& path, std::uint32_t sample_rate);
+
+	// Destructor.
+	// Closes the file if close has not been called.
+	~WavFileAudioSink() override;
+
+	std::uint32_t sampleRate() const override;
+
+	// Throws a std::runtime_error if the file cannot be written.
+	bool write(const float* samples, std::size_t frame_count) override;
+
+	// Returns the amount of frames written so far.
+	std::uint64_t frameCount() const;
+
+	// Fills in the header and closes the file.
+	// Throws a std::runtime_error if the file cannot be written.
+	void close();
+};
+
+#endif // AUDIOSINK_H_INCLUDED
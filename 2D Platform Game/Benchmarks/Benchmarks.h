@@ -0,0 +1,90 @@
+// 2D Platform Game
+// Benchmarks.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the benchmarks run by the Benchmarks program.
+
+#ifndef BENCHMARKS_H_INCLUDED
+#define BENCHMARKS_H_INCLUDED
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+// Timings of a function called several times.
+struct BenchmarkTimes
+{
+	double best_milliseconds = 0.0;
+	double mean_milliseconds = 0.0;
+};
+
+// Calls prepare and then function runs times, and returns how long the
+// calls to function took.
+template <typename P, typename F> BenchmarkTimes time_calls(std::size_t runs, const P& prepare, const F& function)
+{
+	BenchmarkTimes times;
+	double total = 0.0;
+
+	times.best_milliseconds = 1e300;
+
+	for (std::size_t i = 0; i < runs; ++i)
+	{
+		prepare();
+
+		const auto start = std::chrono::steady_clock::now();
+		function();
+		const auto end = std::chrono::steady_clock::now();
+		const double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+		times.best_milliseconds = std::min(times.best_milliseconds, milliseconds);
+		total += milliseconds;
+	}
+
+	times.mean_milliseconds = runs != 0 ? total / double(runs) : 0.0;
+	return times;
+}
+
+// Calls function runs times and returns how long the calls took.
+template <typename F> BenchmarkTimes time_calls(std::size_t runs, const F& function)
+{
+	return time_calls(runs, [] {}, function);
+}
+
+// Each benchmark prints what it measured to std::cout, and throws a
+// std::runtime_error if the results it checks are wrong.
+
+// SpriteBatch::build on 50,000 sprites.
+void benchmark_sprite_batch();
+
+// Accuracy of the fast trig functions in Jlib/Angle.h, and their speed
+// on 1,048,576 angles.
+void benchmark_trig();
+
+// Accuracy of the fast Vector2f normalization in Jlib/Vector.h, and its
+// speed on 4096 vectors.
+void benchmark_normalize();
+
+// parse_layered_level on a 28.6 MB level, and parse_level on its
+// collision layer in the level.txt format.
+void benchmark_level_parse();
+
+// The allocations made by Jlib::Matrix arithmetic, and a chained
+// element-wise expression on 1024x1024 floats against the same loop
+// written by hand.
+void benchmark_matrix();
+
+// matrix_product and transpose against naive loops on 256x256,
+// 1024x1024 and 4096x4096 floats.
+void benchmark_matrix_product();
+
+// ParticleSystem::update on 1,000,000 particles, with and without
+// collision.
+void benchmark_particles();
+
+// GridPathfinder against Dijkstra's algorithm on small levels, and the
+// queries of GridPathfinder and HierarchicalPathfinder on 4096x4096
+// levels.
+void benchmark_pathfinding();
+
+#endif // BENCHMARKS_H_INCLUDED
@@ -0,0 +1,127 @@
+// 2D Platform Game
+// LevelParseBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Times parse_layered_level and parse_level on a generated level.
+
+#include "Benchmarks.h"
+#include "Level.h"
+
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// <cstddef>
+using std::size_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+using std::to_string;
+
+namespace
+{
+	constexpr size_t WIDTH = 4000;
+	constexpr size_t HEIGHT = 2000;
+	constexpr size_t ENTITY_COUNT = 200000;
+	constexpr size_t RUNS = 5;
+
+	// Returns a layered level of WIDTH by HEIGHT random tiles in every
+	// layer, with CRLF rows, and ENTITY_COUNT entities of 3 types in
+	// runs of 7.
+	string layered_text(std::mt19937& rng)
+	{
+		const char* const layers[] = { "background", "collision", "foreground" };
+		const char* const types[] = { "slime", "coin", "bat" };
+		const char tiles[] = "_#~";
+
+		string text = "JLEVEL 1\n; generated by the Benchmarks program\nsize " + to_string(WIDTH) + " " + to_string(HEIGHT) + "\n";
+		text += "spawn 3.5 4\nmeta name First Steps\nmeta music theme.ogg\n";
+		text.reserve(3 * HEIGHT * (WIDTH + 2) + ENTITY_COUNT * 24);
+
+		for (const char* layer : layers)
+		{
+			text += "layer ";
+			text += layer;
+			text += '\n';
+
+			for (size_t row = 0; row < HEIGHT; ++row)
+			{
+				for (size_t column = 0; column < WIDTH; ++column)
+					text += tiles[rng() % 3];
+
+				text += "\r\n";
+			}
+		}
+
+		for (size_t i = 0; i < ENTITY_COUNT; ++i)
+		{
+			text += "entity ";
+			text += types[(i / 7) % 3];
+			text += ' ' + to_string(rng() % WIDTH) + ".5 " + to_string(rng() % HEIGHT) + '\n';
+		}
+
+		return text;
+	}
+
+	// Returns level in the level.txt format.
+	string plain_text(const Level& level)
+	{
+		const size_t width = level.layout.colSize();
+		const size_t height = level.layout.rowSize();
+		string text = to_string(width) + " " + to_string(height) + "\n3.5 4\n";
+
+		text.reserve(text.size() + height * (width + 1));
+
+		for (size_t row = 0; row < height; ++row)
+		{
+			text.append(reinterpret_cast<const char*>(level.layout.data()) + row * width, width);
+			text += '\n';
+		}
+
+		return text;
+	}
+
+	double megabytes_per_second(size_t bytes, double milliseconds)
+	{
+		return double(bytes) / 1e6 / (milliseconds / 1e3);
+	}
+}
+
+void benchmark_level_parse()
+{
+	std::mt19937 rng(5);
+	const string layered = layered_text(rng);
+
+	// The last result is freed before each parse, outside of the timing,
+	// so each parse allocates about as a first load would.
+	LayeredLevel level;
+	const BenchmarkTimes layered_times = time_calls(RUNS, [&] { level = LayeredLevel(); }, [&] { level = parse_layered_level(layered.data(), layered.size()); });
+
+	if (level.width != WIDTH || level.height != HEIGHT || level.entities.size() != ENTITY_COUNT || level.entity_types.size() != 3)
+		throw runtime_error("level_parse: the layered level was not read in full");
+
+	const string plain = plain_text(level.toLevel());
+
+	Level collision;
+	const BenchmarkTimes plain_times = time_calls(RUNS, [&] { collision = Level(); }, [&] { collision = parse_level(plain.data(), plain.size()); });
+
+	if (collision.layout != level.layer(LevelLayer::Collision))
+		throw runtime_error("level_parse: the 2 formats disagree on the collision layer");
+
+	cout << "layered, " << WIDTH << "x" << HEIGHT << " in 3 layers and " << ENTITY_COUNT << " entities: "
+	     << double(layered.size()) / 1e6 << " MB in " << layered_times.best_milliseconds << " ms, "
+	     << megabytes_per_second(layered.size(), layered_times.best_milliseconds) << " MB/s" << endl;
+
+	cout << "level.txt format, collision layer only: "
+	     << double(plain.size()) / 1e6 << " MB in " << plain_times.best_milliseconds << " ms, "
+	     << megabytes_per_second(plain.size(), plain_times.best_milliseconds) << " MB/s" << endl;
+}
@@ -0,0 +1,266 @@
+// 2D Platform Game
+// MatrixBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Counts the allocations made by Jlib::Matrix arithmetic and times it,
+// and times matrix_product and transpose against naive loops.
+
+#include "Benchmarks.h"
+
+#include "Jlib/Matrix.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// <atomic>
+using std::atomic;
+
+// <cstddef>
+using std::size_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+using std::to_string;
+
+namespace
+{
+	constexpr size_t SIZE = 1024;
+	constexpr size_t RUNS = 20;
+
+	// A naive product row costs the same whichever row it is, so at the
+	// larger sizes only the first naive_rows rows are timed and the time
+	// is scaled up. A full naive 4096x4096 product takes about 15 minutes.
+	struct ProductSize
+	{
+		size_t size;
+		size_t naive_rows;
+		size_t runs;
+	};
+
+	constexpr ProductSize PRODUCT_SIZES[] =
+	{
+		{ 256, 256, 5 },
+		{ 1024, 64, 1 },
+		{ 4096, 8, 1 }
+	};
+
+	// Calls to the global operator new and operator new[] made by the
+	// whole program.
+	atomic<size_t> allocation_count = 0;
+
+	// Returns how many allocations function makes.
+	template <typename F> size_t allocations(const F& function)
+	{
+		const size_t before = allocation_count.load(std::memory_order_relaxed);
+		function();
+		return allocation_count.load(std::memory_order_relaxed) - before;
+	}
+
+	void expect_allocations(size_t expected, size_t counted, const char* what)
+	{
+		if (counted != expected)
+		{
+			throw runtime_error("matrix: " + string(what) + " made " + to_string(counted)
+			                    + " allocations instead of " + to_string(expected));
+		}
+
+		cout << what << ": " << counted << (counted == 1 ? " allocation" : " allocations") << endl;
+	}
+
+	// Writes the first rows rows of A * B to C with the textbook loop,
+	// which reads B down its columns.
+	void naive_product(const Matrix<float>& A, const Matrix<float>& B, Matrix<float>& C, size_t rows)
+	{
+		const size_t n = A.rowSize();
+
+		for (size_t i = 0; i < rows; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				float sum = 0.0f;
+
+				for (size_t k = 0; k < n; ++k)
+					sum += A(i, k) * B(k, j);
+
+				C(i, j) = sum;
+			}
+		}
+	}
+
+	// Writes the transpose of A to T one row of A at a time.
+	void naive_transpose(const Matrix<float>& A, Matrix<float>& T)
+	{
+		const size_t n = A.rowSize();
+
+		for (size_t r = 0; r < n; ++r)
+		{
+			for (size_t c = 0; c < n; ++c)
+				T(c, r) = A(r, c);
+		}
+	}
+}
+
+// Replaced so that the allocations can be counted. The array forms are
+// replaced too, since a sanitizer runtime may not forward them to these.
+void* operator new(size_t count)
+{
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(count != 0 ? count : 1))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t count)
+{
+	return operator new(count);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	std::free(memory);
+}
+
+void benchmark_matrix()
+{
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<float> value(-4.0f, 4.0f);
+
+	Matrix<float> A(SIZE, SIZE);
+	Matrix<float> B(SIZE, SIZE);
+	Matrix<float> C(SIZE, SIZE);
+	Matrix<float> D(SIZE, SIZE);
+
+	for (size_t i = 0; i < SIZE * SIZE; ++i)
+	{
+		A[i] = value(rng);
+		B[i] = value(rng);
+		C[i] = value(rng);
+	}
+
+	// Assigning a chained expression to a matrix of the same size writes
+	// straight into its buffer.
+	expect_allocations(0, allocations([&] { D = A + B * 2.0f - C / 4.0f; }), "D = A + B * 2 - C / 4");
+
+	for (size_t i = 0; i < SIZE * SIZE; ++i)
+	{
+		if (std::fabs(D[i] - (A[i] + B[i] * 2.0f - C[i] / 4.0f)) > 1e-5f)
+			throw runtime_error("matrix: A + B * 2 - C / 4 is wrong");
+	}
+
+	expect_allocations(0, allocations([&] { D = hadamard_product(A, B) - apply(C, [](float x) { return x * x; }); }), "D = hadamard_product(A, B) - apply(C, square)");
+	expect_allocations(0, allocations([&] { D += -(A - B) * 0.5f; }), "D += -(A - B) * 0.5");
+	expect_allocations(0, allocations([&] { D = A; }), "D = A");
+	expect_allocations(0, allocations([&] { D.resize(SIZE / 2, SIZE); }), "D.resize to a smaller size");
+	expect_allocations(1, allocations([&] { Matrix<float> E = A + B - C; }), "Matrix E = A + B - C");
+
+	D.resize(SIZE, SIZE);
+
+	// The same arithmetic written as one loop by hand, which is what the
+	// expression should compile to.
+	const BenchmarkTimes expression = time_calls(RUNS, [&] { D = A + B * 2.0f - C / 4.0f; });
+	const BenchmarkTimes by_hand = time_calls(RUNS, [&]
+	{
+		const float* a = A.data();
+		const float* b = B.data();
+		const float* c = C.data();
+		float* d = D.data();
+
+		for (size_t i = 0; i < SIZE * SIZE; ++i)
+			d[i] = a[i] + b[i] * 2.0f - c[i] / 4.0f;
+	});
+
+	cout << SIZE << "x" << SIZE << " floats, A + B * 2 - C / 4, best of " << RUNS << ":" << endl;
+	cout << "  expression: " << expression.best_milliseconds << " ms" << endl;
+	cout << "  by hand:    " << by_hand.best_milliseconds << " ms" << endl;
+}
+
+void benchmark_matrix_product()
+{
+	std::mt19937 rng(2);
+
+	for (const ProductSize& product_size : PRODUCT_SIZES)
+	{
+		const size_t n = product_size.size;
+		const size_t rows = product_size.naive_rows;
+
+		// Small whole numbers keep every sum exact, so the 2 products
+		// can be compared exactly.
+		Matrix<float> A(n, n);
+		Matrix<float> B(n, n);
+
+		for (size_t i = 0; i < n * n; ++i)
+		{
+			A[i] = float(rng() % 4);
+			B[i] = float(rng() % 4);
+		}
+
+		Matrix<float> naive(n, n);
+		Matrix<float> blocked;
+
+		const BenchmarkTimes naive_times = time_calls(product_size.runs, [&] { naive_product(A, B, naive, rows); });
+		const BenchmarkTimes blocked_times = time_calls(product_size.runs, [&] { blocked = A * B; });
+
+		for (size_t i = 0; i < rows * n; ++i)
+		{
+			if (naive[i] != blocked[i])
+				throw runtime_error("matrix_product: the blocked product differs from the naive one");
+		}
+
+		Matrix<float> naive_transposed(n, n);
+		Matrix<float> tiled;
+
+		const BenchmarkTimes naive_transpose_times = time_calls(product_size.runs, [&] { naive_transpose(A, naive_transposed); });
+		const BenchmarkTimes tiled_times = time_calls(product_size.runs, [&] { tiled = transpose(A); });
+
+		if (tiled != naive_transposed)
+			throw runtime_error("matrix_product: the tiled transpose differs from the naive one");
+
+		const double naive_milliseconds = naive_times.best_milliseconds * double(n) / double(rows);
+
+		cout << n << "x" << n << " floats, best of " << product_size.runs << ":" << endl;
+		cout << "  naive product:   " << naive_milliseconds << " ms";
+
+		if (rows != n)
+			cout << " (scaled from " << rows << " rows)";
+
+		cout << endl;
+		cout << "  matrix_product:  " << blocked_times.best_milliseconds << " ms, " << naive_milliseconds / blocked_times.best_milliseconds << "x" << endl;
+		cout << "  naive transpose: " << naive_transpose_times.best_milliseconds << " ms" << endl;
+		cout << "  transpose:       " << tiled_times.best_milliseconds << " ms, "
+		     << naive_transpose_times.best_milliseconds / tiled_times.best_milliseconds << "x" << endl;
+	}
+}
@@ -0,0 +1,141 @@
+// 2D Platform Game
+// ParticleBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Times ParticleSystem::update on 1,000,000 particles.
+
+#include "Benchmarks.h"
+#include "ParticleSystem.h"
+#include "Tile.h"
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+// Jlib/Color.h
+using Jlib::Color;
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+namespace
+{
+	constexpr size_t PARTICLE_COUNT = 1000000;
+	constexpr size_t LEVEL_SIZE = 512;
+	constexpr size_t FRAMES = 120;
+	constexpr float FRAME_SECONDS = 1.0f / 60.0f;
+
+	// Returns a LEVEL_SIZE x LEVEL_SIZE level with solid borders and
+	// about 15% of the other tiles solid.
+	Matrix<uint8_t> make_level(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+		Matrix<uint8_t> level(LEVEL_SIZE, LEVEL_SIZE);
+
+		for (size_t row = 0; row < LEVEL_SIZE; ++row)
+		{
+			for (size_t col = 0; col < LEVEL_SIZE; ++col)
+			{
+				const bool border = row == 0 || col == 0 || row == LEVEL_SIZE - 1 || col == LEVEL_SIZE - 1;
+				level(row, col) = border || chance(rng) < 0.15f ? TILE_SOLID : TILE_EMPTY;
+			}
+		}
+
+		return level;
+	}
+
+	// Spawns particles with lifetimes of 0.5 to 3.5 seconds until
+	// particles is full.
+	// With a level, particles are only spawned in empty tiles.
+	void refill(ParticleSystem& particles, std::mt19937& rng, const Matrix<uint8_t>* level)
+	{
+		std::uniform_real_distribution<float> position(1.0f, float(LEVEL_SIZE) - 1.0f);
+		std::uniform_real_distribution<float> speed(-5.0f, 5.0f);
+		std::uniform_real_distribution<float> lifetime(0.5f, 3.5f);
+
+		while (particles.size() < particles.capacity())
+		{
+			const Point2f at(position(rng), position(rng));
+
+			if (level != nullptr && is_solid_at(*level, int32_t(at.x), int32_t(at.y)))
+				continue;
+
+			particles.spawn(at, Vector2f(speed(rng), speed(rng)), lifetime(rng), Color(255, 255, 255, 255));
+		}
+	}
+
+	// Checks that every particle is alive and, with a level, that none
+	// ended the frame inside a solid tile.
+	void check(const ParticleSystem& particles, const Matrix<uint8_t>* level)
+	{
+		for (size_t i = 0; i < particles.size(); ++i)
+		{
+			if (!(particles.lifetimes()[i] > 0.0f))
+				throw runtime_error("particles: a dead particle was not removed");
+
+			const Point2f& at = particles.positions()[i];
+
+			if (level != nullptr && is_solid_at(*level, int32_t(std::floor(at.x)), int32_t(std::floor(at.y))))
+				throw runtime_error("particles: a particle ended a frame inside a solid tile");
+		}
+	}
+
+	// Times FRAMES updates of a full ParticleSystem, refilling it
+	// between updates outside of the timing.
+	void time_updates(const Matrix<uint8_t>* level, std::mt19937& rng, const char* what)
+	{
+		ParticleSystem particles(PARTICLE_COUNT);
+
+		particles.setGravity(Vector2f(0.0f, 9.8f));
+		particles.setDrag(0.1f);
+		particles.setCollision(level, 0.5f);
+
+		refill(particles, rng, level);
+		particles.update(FRAME_SECONDS);
+
+		size_t removed = 0;
+
+		const BenchmarkTimes times = time_calls(FRAMES, [&] { refill(particles, rng, level); }, [&]
+		{
+			particles.update(FRAME_SECONDS);
+			removed += PARTICLE_COUNT - particles.size();
+		});
+
+		check(particles, level);
+
+		cout << PARTICLE_COUNT << " particles, " << what << ": " << times.best_milliseconds << " ms best, "
+		     << times.mean_milliseconds << " ms mean, " << double(removed) / double(FRAMES) << " removed per frame" << endl;
+	}
+}
+
+void benchmark_particles()
+{
+	std::mt19937 rng(4);
+	const Matrix<uint8_t> level = make_level(rng);
+
+	time_updates(nullptr, rng, "no collision");
+	time_updates(&level, rng, "collision with a 512x512 level");
+}
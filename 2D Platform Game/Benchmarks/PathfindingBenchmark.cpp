@@ -0,0 +1,268 @@
+// 2D Platform Game
+// PathfindingBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Checks that GridPathfinder finds shortest paths and times its queries
+// and those of HierarchicalPathfinder on 4096x4096 levels.
+
+#include "Benchmarks.h"
+#include "HierarchicalPathfinder.h"
+#include "Pathfinding.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2i;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <utility>
+using std::pair;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr int32_t CHECK_WIDTH = 40;
+	constexpr int32_t CHECK_HEIGHT = 30;
+	constexpr size_t CHECK_LEVELS = 300;
+	constexpr size_t CHECK_QUERIES = 10;
+
+	constexpr int32_t LARGE_SIZE = 4096;
+	constexpr size_t QUERY_COUNT = 200;
+	constexpr int32_t CHUNK_SIZE = 32;
+
+	constexpr float DIAGONAL = 1.41421356f;
+
+	struct Query
+	{
+		Point2i start;
+		Point2i goal;
+	};
+
+	// Returns a width x height level where each tile is solid with the
+	// given chance.
+	Matrix<uint8_t> make_level(int32_t width, int32_t height, float walls, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+		Matrix<uint8_t> level(height, width);
+
+		for (size_t i = 0; i < level.size(); ++i)
+			level[i] = chance(rng) < walls ? TILE_SOLID : TILE_EMPTY;
+
+		return level;
+	}
+
+	// Returns QUERY_COUNT queries between open tiles in the square of
+	// the given size whose top left corner is at (offset, offset).
+	vector<Query> make_queries(const Matrix<uint8_t>& level, int32_t offset, int32_t size, std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int32_t> coordinate(offset, offset + size - 1);
+		vector<Query> queries;
+
+		while (queries.size() < QUERY_COUNT)
+		{
+			const Point2i start(coordinate(rng), coordinate(rng));
+			const Point2i goal(coordinate(rng), coordinate(rng));
+
+			if (!is_solid_at(level, start.x, start.y) && !is_solid_at(level, goal.x, goal.y))
+				queries.push_back({ start, goal });
+		}
+
+		return queries;
+	}
+
+	// Returns the length of the shortest path from start to goal with
+	// Dijkstra's algorithm over the 8 neighbours of every tile, without
+	// cutting corners, or -1 if there is none.
+	float shortest_length(const Matrix<uint8_t>& level, const Point2i& start, const Point2i& goal)
+	{
+		const int32_t width = int32_t(level.colSize());
+		vector<float> costs(level.size(), INFINITY);
+		std::priority_queue<pair<float, int32_t>, vector<pair<float, int32_t>>, std::greater<>> open;
+
+		costs[start.y * width + start.x] = 0.0f;
+		open.emplace(0.0f, start.y * width + start.x);
+
+		while (!open.empty())
+		{
+			const auto [cost, tile] = open.top();
+			open.pop();
+
+			if (cost > costs[tile])
+				continue;
+
+			const int32_t x = tile % width;
+			const int32_t y = tile / width;
+
+			if (x == goal.x && y == goal.y)
+				return cost;
+
+			for (int32_t dy = -1; dy <= 1; ++dy)
+			{
+				for (int32_t dx = -1; dx <= 1; ++dx)
+				{
+					if ((dx == 0 && dy == 0) || is_solid_at(level, x + dx, y + dy))
+						continue;
+
+					if (dx != 0 && dy != 0 && (is_solid_at(level, x + dx, y) || is_solid_at(level, x, y + dy)))
+						continue;
+
+					const float new_cost = cost + (dx != 0 && dy != 0 ? DIAGONAL : 1.0f);
+					const int32_t next = (y + dy) * width + x + dx;
+
+					if (new_cost < costs[next])
+					{
+						costs[next] = new_cost;
+						open.emplace(new_cost, next);
+					}
+				}
+			}
+		}
+
+		return -1.0f;
+	}
+
+	// Returns the length of a GridPathfinder path, whose jump points
+	// are joined by straight or diagonal lines.
+	float path_length(const vector<Point2i>& path)
+	{
+		float length = 0.0f;
+
+		for (size_t i = 1; i < path.size(); ++i)
+		{
+			const int32_t dx = std::abs(path[i].x - path[i - 1].x);
+			const int32_t dy = std::abs(path[i].y - path[i - 1].y);
+
+			if (dx != 0 && dy != 0 && dx != dy)
+				throw runtime_error("pathfinding: 2 jump points are not on a straight or diagonal line");
+
+			length += float(std::max(dx, dy) - std::min(dx, dy)) + DIAGONAL * float(std::min(dx, dy));
+		}
+
+		return length;
+	}
+
+	// Checks GridPathfinder against Dijkstra's algorithm on small
+	// levels with 30% walls.
+	void check_shortest(std::mt19937& rng)
+	{
+		size_t checked = 0;
+
+		for (size_t i = 0; i < CHECK_LEVELS; ++i)
+		{
+			const Matrix<uint8_t> level = make_level(CHECK_WIDTH, CHECK_HEIGHT, 0.3f, rng);
+			GridPathfinder pathfinder(level);
+			vector<Point2i> path;
+
+			for (size_t j = 0; j < CHECK_QUERIES; ++j)
+			{
+				const Point2i start(int32_t(rng() % CHECK_WIDTH), int32_t(rng() % CHECK_HEIGHT));
+				const Point2i goal(int32_t(rng() % CHECK_WIDTH), int32_t(rng() % CHECK_HEIGHT));
+
+				if (is_solid_at(level, start.x, start.y) || is_solid_at(level, goal.x, goal.y))
+					continue;
+
+				const float shortest = shortest_length(level, start, goal);
+				const bool found = pathfinder.findPath(start, goal, path);
+
+				if (found != (shortest >= 0.0f))
+					throw runtime_error("pathfinding: GridPathfinder disagrees on whether a path exists");
+
+				if (found && std::fabs(path_length(path) - shortest) > 1e-3f)
+					throw runtime_error("pathfinding: GridPathfinder returned a path that is not the shortest");
+
+				++checked;
+			}
+		}
+
+		cout << checked << " queries on " << CHECK_WIDTH << "x" << CHECK_HEIGHT << " levels match Dijkstra's algorithm" << endl;
+	}
+
+	// Times GridPathfinder on the given queries.
+	void time_grid(const Matrix<uint8_t>& level, const vector<Query>& queries, const char* what)
+	{
+		GridPathfinder pathfinder(level);
+		vector<Point2i> path;
+		size_t found = 0;
+		size_t expanded = 0;
+
+		const BenchmarkTimes times = time_calls(1, [&]
+		{
+			for (const Query& query : queries)
+			{
+				found += pathfinder.findPath(query.start, query.goal, path);
+				expanded += pathfinder.lastExpandedCount();
+			}
+		});
+
+		cout << "GridPathfinder, " << what << ": " << found << "/" << queries.size() << " found, "
+		     << times.best_milliseconds / double(queries.size()) << " ms per query, "
+		     << expanded / queries.size() << " nodes expanded per query" << endl;
+	}
+}
+
+void benchmark_pathfinding()
+{
+	std::mt19937 rng(1);
+
+	check_shortest(rng);
+
+	Matrix<uint8_t> walls = make_level(LARGE_SIZE, LARGE_SIZE, 0.2f, rng);
+	const vector<Query> window_queries = make_queries(walls, 1500, 1024, rng);
+	const vector<Query> long_queries = make_queries(walls, 0, LARGE_SIZE, rng);
+
+	time_grid(walls, window_queries, "4096x4096 with 20% walls, within 1024 tiles");
+
+	const Matrix<uint8_t> open = make_level(LARGE_SIZE, LARGE_SIZE, 0.02f, rng);
+
+	time_grid(open, make_queries(open, 0, LARGE_SIZE, rng), "4096x4096 with 2% walls, across the level");
+
+	// The first pass computes the entrance costs of the chunks it
+	// passes through. The second finds them all cached.
+	HierarchicalPathfinder hierarchical(walls, CHUNK_SIZE);
+	vector<Point2i> path;
+	size_t found = 0;
+
+	const auto search = [&]
+	{
+		for (const Query& query : long_queries)
+			found += hierarchical.findPath(query.start, query.goal, path);
+	};
+
+	const auto reset = [&] { found = 0; };
+	const BenchmarkTimes first = time_calls(1, reset, search);
+	const BenchmarkTimes cached = time_calls(1, reset, search);
+
+	cout << "HierarchicalPathfinder, " << CHUNK_SIZE << "-tile chunks, 4096x4096 with 20% walls, across the level: "
+	     << found << "/" << long_queries.size() << " found, " << first.best_milliseconds / double(long_queries.size())
+	     << " ms per query computing chunk costs, " << cached.best_milliseconds / double(long_queries.size())
+	     << " ms per query with them cached" << endl;
+}
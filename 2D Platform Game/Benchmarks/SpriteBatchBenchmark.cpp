@@ -0,0 +1,121 @@
+// 2D Platform Game
+// SpriteBatchBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Times SpriteBatch::build.
+
+#include "Benchmarks.h"
+#include "SpriteBatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+// Jlib/Angle.h
+using Jlib::Angle;
+
+// Jlib/Color.h
+using Jlib::Color;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint16_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+namespace
+{
+	constexpr size_t SPRITE_COUNT = 50000;
+	constexpr size_t RUNS = 50;
+
+	// Adds SPRITE_COUNT rotated 16x16 sprites spread over 200x200 tiles,
+	// on layers [0, layers) and textures [0, textures).
+	void fill(SpriteBatch& batch, std::mt19937& rng, uint8_t layers, uint16_t textures)
+	{
+		std::uniform_real_distribution<float> position(0.0f, 200.0f);
+		std::uniform_real_distribution<double> degrees(0.0, 360.0);
+
+		batch.clear();
+
+		for (size_t i = 0; i < SPRITE_COUNT; ++i)
+		{
+			const Point2f at(position(rng), position(rng));
+			const Rectangle<float> source(float(i % 16) * 16.0f, 0.0f, 16.0f, 16.0f);
+
+			batch.add(at, source, uint16_t(rng() % textures), uint8_t(rng() % layers), Color(255, 255, 255, 255), Angle(degrees(rng)));
+		}
+	}
+
+	// Checks the draw calls cover every vertex in increasing key order,
+	// and that rotating kept the top edge of every quad 16 pixels long.
+	void check(const SpriteBatch& batch)
+	{
+		const auto& calls = batch.drawCalls();
+		const auto& vertices = batch.vertices();
+		size_t covered = 0;
+
+		for (size_t i = 0; i < calls.size(); ++i)
+		{
+			if (calls[i].first_vertex != covered)
+				throw runtime_error("sprite_batch: draw calls leave a gap");
+
+			if (i != 0 && (calls[i].layer << 16 | calls[i].texture) <= (calls[i - 1].layer << 16 | calls[i - 1].texture))
+				throw runtime_error("sprite_batch: draw calls are out of order");
+
+			covered += calls[i].vertex_count;
+		}
+
+		if (covered != vertices.size())
+			throw runtime_error("sprite_batch: draw calls do not cover every vertex");
+
+		for (size_t i = 0; i < vertices.size(); i += SpriteBatch::VERTICES_PER_SPRITE)
+		{
+			const float dx = vertices[i + 1].x - vertices[i].x;
+			const float dy = vertices[i + 1].y - vertices[i].y;
+
+			if (std::fabs(std::sqrt(dx * dx + dy * dy) - 16.0f) > 0.05f)
+				throw runtime_error("sprite_batch: a rotated quad changed size");
+		}
+	}
+}
+
+void benchmark_sprite_batch()
+{
+	SpriteBatch batch;
+	std::mt19937 rng(1);
+
+	batch.reserve(SPRITE_COUNT);
+
+	fill(batch, rng, 4, 8);
+	batch.build(Point2f(0.0f, 0.0f), 32.0f);
+	check(batch);
+
+	// The sprites are added again before every build, outside of the
+	// timing, so every build sorts from the same kind of order.
+	BenchmarkTimes times = time_calls(RUNS, [&] { fill(batch, rng, 4, 8); }, [&] { batch.build(Point2f(0.0f, 0.0f), 32.0f); });
+
+	cout << SPRITE_COUNT << " sprites, 4 layers x 8 textures: " << batch.drawCalls().size() << " draw calls, build "
+	     << times.best_milliseconds << " ms best, " << times.mean_milliseconds << " ms mean" << endl;
+
+	times = time_calls(RUNS, [&] { fill(batch, rng, 1, 1); }, [&] { batch.build(Point2f(0.0f, 0.0f), 32.0f); });
+	check(batch);
+
+	cout << SPRITE_COUNT << " sprites, 1 texture: " << batch.drawCalls().size() << " draw call, build "
+	     << times.best_milliseconds << " ms best, " << times.mean_milliseconds << " ms mean" << endl;
+}
@@ -0,0 +1,148 @@
+// 2D Platform Game
+// TrigBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Checks the accuracy of Jlib's fast trig functions and times them.
+
+#include "Benchmarks.h"
+
+#include "Jlib/Angle.h"
+#include "Jlib/Vector.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Jlib/Angle.h
+using Jlib::Angle;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cstddef>
+using std::size_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr size_t ACCURACY_COUNT = size_t(1) << 16;
+	constexpr size_t TIMING_COUNT = size_t(1) << 20;
+	constexpr size_t RUNS = 5;
+
+	// The bounds documented in Jlib/Angle.h.
+	constexpr double RADIANS_ERROR = 1.2e-7;
+	constexpr double ANGLE_ERROR = 2e-7;
+
+	constexpr double RADIANS_PER_DEGREE = 3.14159265358979323846 / 180.0;
+
+	double error(double approximation, double exact)
+	{
+		return std::fabs(approximation - exact);
+	}
+
+	// Checks fast_sincos on float radians in [-8192, 8192], and every
+	// Angle overload on angles up to 1e10 degrees.
+	void check_accuracy(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> radians(-8192.0f, 8192.0f);
+		std::uniform_real_distribution<double> degrees(-1e10, 1e10);
+		double radians_error = 0.0;
+		double angle_error = 0.0;
+
+		for (size_t i = 0; i < ACCURACY_COUNT; ++i)
+		{
+			const float x = radians(rng);
+			float sin_value, cos_value;
+
+			Jlib::fast_sincos(x, sin_value, cos_value);
+			radians_error = std::max(radians_error, error(sin_value, std::sin(double(x))));
+			radians_error = std::max(radians_error, error(cos_value, std::cos(double(x))));
+		}
+
+		vector<Angle> angles(ACCURACY_COUNT);
+		vector<float> sines(ACCURACY_COUNT);
+		vector<float> cosines(ACCURACY_COUNT);
+
+		for (Angle& ang : angles)
+			ang = Angle(degrees(rng));
+
+		Jlib::fast_sincos(angles.data(), sines.data(), cosines.data(), angles.size());
+
+		for (size_t i = 0; i < ACCURACY_COUNT; ++i)
+		{
+			const double exact = std::remainder(angles[i].value(), 360.0) * RADIANS_PER_DEGREE;
+			const Vector2f v(angles[i], 1.0f);
+
+			angle_error = std::max(angle_error, error(v.x, std::cos(exact)));
+			angle_error = std::max(angle_error, error(v.y, std::sin(exact)));
+			angle_error = std::max(angle_error, error(cosines[i], std::cos(exact)));
+			angle_error = std::max(angle_error, error(sines[i], std::sin(exact)));
+		}
+
+		cout << "max error, float radians up to 8192: " << radians_error << endl;
+		cout << "max error, Angles up to 1e10 degrees: " << angle_error << endl;
+
+		if (radians_error > RADIANS_ERROR || angle_error > ANGLE_ERROR)
+			throw runtime_error("trig: an error is above the bound in Jlib/Angle.h");
+
+		const Vector2f nan(Angle(NAN), 1.0f);
+
+		if (!std::isnan(nan.x) || !std::isnan(nan.y))
+			throw runtime_error("trig: Vector2f(Angle(NaN)) is not NaN");
+	}
+}
+
+void benchmark_trig()
+{
+	std::mt19937 rng(1);
+
+	check_accuracy(rng);
+
+	std::uniform_real_distribution<double> degrees(-360.0, 360.0);
+	vector<Angle> angles(TIMING_COUNT);
+	vector<float> radians(TIMING_COUNT);
+	vector<Vector2f> vectors(TIMING_COUNT);
+	vector<float> sines(TIMING_COUNT);
+	vector<float> cosines(TIMING_COUNT);
+
+	for (size_t i = 0; i < TIMING_COUNT; ++i)
+	{
+		angles[i] = Angle(degrees(rng));
+		radians[i] = float(angles[i].radians());
+	}
+
+	const BenchmarkTimes library = time_calls(RUNS, [&]
+	{
+		for (size_t i = 0; i < TIMING_COUNT; ++i)
+			vectors[i].setAll(float(5.0 * Jlib::cos(angles[i])), float(5.0 * Jlib::sin(angles[i])));
+	});
+
+	const BenchmarkTimes constructor = time_calls(RUNS, [&]
+	{
+		for (size_t i = 0; i < TIMING_COUNT; ++i)
+			vectors[i] = Vector2f(angles[i], 5.0f);
+	});
+
+	const BenchmarkTimes angle_batch = time_calls(RUNS, [&] { Jlib::fast_sincos(angles.data(), sines.data(), cosines.data(), TIMING_COUNT); });
+	const BenchmarkTimes radians_batch = time_calls(RUNS, [&] { Jlib::fast_sincos(radians.data(), sines.data(), cosines.data(), TIMING_COUNT); });
+
+	const double base = library.best_milliseconds;
+
+	cout << TIMING_COUNT << " angles, best of " << RUNS << ":" << endl;
+	cout << "  Jlib::cos + Jlib::sin:           " << base << " ms" << endl;
+	cout << "  Vector2f(Angle, T):              " << constructor.best_milliseconds << " ms, " << base / constructor.best_milliseconds << "x" << endl;
+	cout << "  fast_sincos(const Angle*):       " << angle_batch.best_milliseconds << " ms, " << base / angle_batch.best_milliseconds << "x" << endl;
+	cout << "  fast_sincos(const float*):       " << radians_batch.best_milliseconds << " ms, " << base / radians_batch.best_milliseconds << "x" << endl;
+}
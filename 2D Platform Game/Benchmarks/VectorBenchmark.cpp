@@ -0,0 +1,157 @@
+// 2D Platform Game
+// VectorBenchmark.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Checks the accuracy of Jlib's fast Vector2f normalization and times it.
+
+#include "Benchmarks.h"
+
+#include "Jlib/Vector.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cstddef>
+using std::size_t;
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr size_t COUNT = 4096;
+	constexpr size_t PASSES = 500;
+	constexpr size_t RUNS = 5;
+
+	// The bound documented for Jlib::fast_inverse_sqrt, with room for
+	// the rounding of the final multiplications.
+	constexpr double FAST_ERROR = 2e-6;
+
+	// Returns the largest difference between a component of normalized
+	// and the same component of the unit vector computed in double.
+	double max_error(const vector<Vector2f>& original, const vector<Vector2f>& normalized)
+	{
+		double error = 0.0;
+
+		for (size_t i = 0; i < original.size(); ++i)
+		{
+			const double x = original[i].x;
+			const double y = original[i].y;
+			const double length = std::sqrt(x * x + y * y);
+
+			error = std::max(error, std::fabs(normalized[i].x - x / length));
+			error = std::max(error, std::fabs(normalized[i].y - y / length));
+		}
+
+		return error;
+	}
+
+	// Checks fastUnitVector() and fast_normalize() against the unit
+	// vectors computed in double, and on the zero vector.
+	void check_accuracy(const vector<Vector2f>& original)
+	{
+		vector<Vector2f> single(original.size());
+		vector<Vector2f> batch = original;
+
+		for (size_t i = 0; i < original.size(); ++i)
+			single[i] = original[i].fastUnitVector();
+
+		// An odd count, so that the scalar tail of fast_normalize runs.
+		Jlib::fast_normalize(batch.data(), batch.size() - 1);
+		batch.back() = batch.back().fastUnitVector();
+
+		const double single_error = max_error(original, single);
+		const double batch_error = max_error(original, batch);
+
+		cout << "max error, fastUnitVector(): " << single_error << endl;
+		cout << "max error, fast_normalize(): " << batch_error << endl;
+
+		if (single_error > FAST_ERROR || batch_error > FAST_ERROR)
+			throw runtime_error("normalize: an error is above the bound of fast_inverse_sqrt");
+
+		Vector2f zeros[5];
+
+		Jlib::fast_normalize(zeros, 5);
+
+		for (const Vector2f& zero : zeros)
+		{
+			if (zero.x != 0.0f || zero.y != 0.0f)
+				throw runtime_error("normalize: fast_normalize changed a zero vector");
+		}
+	}
+}
+
+void benchmark_normalize()
+{
+	std::mt19937 rng(3);
+	std::uniform_real_distribution<float> component(-100.0f, 100.0f);
+	vector<Vector2f> original(COUNT);
+
+	for (Vector2f& v : original)
+		v.setAll(component(rng), component(rng));
+
+	check_accuracy(original);
+
+	// Every run starts from the same vectors. Later passes normalize
+	// vectors that are already unit length, which costs the same.
+	vector<Vector2f> vectors(COUNT);
+	const auto reset = [&] { vectors = original; };
+
+	const BenchmarkTimes in_double = time_calls(RUNS, reset, [&]
+	{
+		for (size_t pass = 0; pass < PASSES; ++pass)
+		{
+			for (Vector2f& v : vectors)
+			{
+				const double length = std::sqrt(double(v.x) * v.x + double(v.y) * v.y);
+				v.setAll(float(v.x / length), float(v.y / length));
+			}
+		}
+	});
+
+	const BenchmarkTimes unit_vector = time_calls(RUNS, reset, [&]
+	{
+		for (size_t pass = 0; pass < PASSES; ++pass)
+		{
+			for (Vector2f& v : vectors)
+				v = v.unitVector();
+		}
+	});
+
+	const BenchmarkTimes fast_unit_vector = time_calls(RUNS, reset, [&]
+	{
+		for (size_t pass = 0; pass < PASSES; ++pass)
+		{
+			for (Vector2f& v : vectors)
+				v = v.fastUnitVector();
+		}
+	});
+
+	const BenchmarkTimes fast_normalize = time_calls(RUNS, reset, [&]
+	{
+		for (size_t pass = 0; pass < PASSES; ++pass)
+			Jlib::fast_normalize(vectors.data(), vectors.size());
+	});
+
+	const double base = in_double.best_milliseconds;
+
+	cout << COUNT << " Vector2f x " << PASSES << " passes, best of " << RUNS << ":" << endl;
+	cout << "  through double:   " << base << " ms" << endl;
+	cout << "  unitVector():     " << unit_vector.best_milliseconds << " ms, " << base / unit_vector.best_milliseconds << "x" << endl;
+	cout << "  fastUnitVector(): " << fast_unit_vector.best_milliseconds << " ms, " << base / fast_unit_vector.best_milliseconds << "x" << endl;
+	cout << "  fast_normalize(): " << fast_normalize.best_milliseconds << " ms, " << base / fast_normalize.best_milliseconds << "x" << endl;
+}
@@ -0,0 +1,76 @@
+// 2D Platform Game
+// main.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Main file of the Benchmarks program.
+// Runs the benchmarks named on the command line, or all of them.
+// Build it in Release: the numbers in the commit messages were
+// measured with optimizations on.
+
+#include "Benchmarks.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+// <iostream>
+using std::cout;
+using std::endl;
+
+// <string>
+using std::string;
+
+namespace
+{
+	struct Benchmark
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	constexpr Benchmark BENCHMARKS[] =
+	{
+		{ "sprite_batch", benchmark_sprite_batch },
+		{ "trig", benchmark_trig },
+		{ "normalize", benchmark_normalize },
+		{ "level_parse", benchmark_level_parse },
+		{ "matrix", benchmark_matrix },
+		{ "matrix_product", benchmark_matrix_product },
+		{ "particles", benchmark_particles },
+		{ "pathfinding", benchmark_pathfinding }
+	};
+}
+
+int main(int argc, char** argv)
+{
+	int failures = 0;
+
+	for (const Benchmark& benchmark : BENCHMARKS)
+	{
+		bool selected = argc < 2;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			if (string(argv[i]) == benchmark.name)
+				selected = true;
+		}
+
+		if (!selected)
+			continue;
+
+		cout << "== " << benchmark.name << endl;
+
+		try
+		{
+			benchmark.run();
+		}
+		catch (const std::exception& e)
+		{
+			cout << "ERROR: " << e.what() << endl;
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+// 2D Platform Game
+// ByteStream.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ByteWriter and ByteReader classes.
+
+#include "ByteStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <vector>
+using std::vector;
+
+ByteWriter::ByteWriter(vector<uint8_t>& buffer)
+	: buffer_(&buffer)
+{
+
+}
+
+size_t ByteWriter::size() const
+{
+	return buffer_->size();
+}
+
+uint8_t* ByteWriter::reserve(size_t size)
+{
+	const size_t start = buffer_->size();
+
+	// Grows geometrically, as push_back would, so a buffer written from
+	// empty every time still reaches its final size in a few steps.
+	if (buffer_->capacity() < start + size)
+		buffer_->reserve(std::max(start + size, buffer_->capacity() * 2));
+
+	buffer_->resize(start + size);
+	return buffer_->data() + start;
+}
+
+void ByteWriter::truncate(size_t size)
+{
+	if (size < buffer_->size())
+		buffer_->resize(size);
+}
+
+void ByteWriter::writeU8(uint8_t value)
+{
+	buffer_->push_back(value);
+}
+
+void ByteWriter::writeU32(uint32_t value)
+{
+	std::memcpy(reserve(4), &value, 4);
+}
+
+void ByteWriter::writeU64(uint64_t value)
+{
+	std::memcpy(reserve(8), &value, 8);
+}
+
+void ByteWriter::writeF32(float value)
+{
+	std::memcpy(reserve(4), &value, 4);
+}
+
+void ByteWriter::writeVarint(uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer_->push_back(uint8_t(value) | 0x80);
+		value >>= 7;
+	}
+
+	buffer_->push_back(uint8_t(value));
+}
+
+void ByteWriter::writeBytes(const void* data, size_t size)
+{
+	if (size != 0)
+		std::memcpy(reserve(size), data, size);
+}
+
+ByteReader::ByteReader(const uint8_t* data, size_t size)
+	: it_(data), end_(data + size)
+{
+
+}
+
+void ByteReader::need(size_t size) const
+{
+	if (size > size_t(end_ - it_))
+		throw runtime_error("ByteReader: read past the end");
+}
+
+size_t ByteReader::remaining() const
+{
+	return size_t(end_ - it_);
+}
+
+uint8_t ByteReader::readU8()
+{
+	need(1);
+	return *it_++;
+}
+
+uint32_t ByteReader::readU32()
+{
+	uint32_t value = 0;
+	std::memcpy(&value, readBytes(4), 4);
+	return value;
+}
+
+uint64_t ByteReader::readU64()
+{
+	uint64_t value = 0;
+	std::memcpy(&value, readBytes(8), 8);
+	return value;
+}
+
+float ByteReader::readF32()
+{
+	float value = 0.0f;
+	std::memcpy(&value, readBytes(4), 4);
+	return value;
+}
+
+uint64_t ByteReader::readVarint()
+{
+	uint64_t value = 0;
+
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		const uint8_t byte = readU8();
+		value |= uint64_t(byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+
+	throw runtime_error("ByteReader: varint longer than 64 bits");
+}
+
+const uint8_t* ByteReader::readBytes(size_t size)
+{
+	need(size);
+
+	const uint8_t* const start = it_;
+	it_ += size;
+
+	return start;
+}
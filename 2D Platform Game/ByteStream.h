@@ -0,0 +1,81 @@
+// 2D Platform Game
+// ByteStream.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ByteWriter and ByteReader classes.
+
+#ifndef BYTESTREAM_H_INCLUDED
+#define BYTESTREAM_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Appends binary values to a byte buffer owned by the caller, so one
+// buffer kept between uses is written without allocating, and the
+// result is written to a file as it is.
+// Fixed size values are stored in the byte order of the machine, as in
+// the LevelCache files. Varints store 7 bits per byte, low bits first.
+class ByteWriter
+{
+	std::vector<std::uint8_t>* buffer_ = nullptr;
+
+	public:
+
+	// Buffer constructor.
+	// Writes after whatever buffer already holds.
+	explicit ByteWriter(std::vector<std::uint8_t>& buffer);
+
+	// Returns the amount of bytes in the buffer.
+	std::size_t size() const;
+
+	// Grows the buffer by size bytes and returns a pointer to them, to
+	// be filled in place. The pointer is valid until the next write.
+	std::uint8_t* reserve(std::size_t size);
+
+	// Removes bytes from the end of the buffer, so it holds size bytes.
+	// Used to give back what reserve asked for and was not filled.
+	void truncate(std::size_t size);
+
+	// Appends value.
+	void writeU8(std::uint8_t value);
+	void writeU32(std::uint32_t value);
+	void writeU64(std::uint64_t value);
+	void writeF32(float value);
+	void writeVarint(std::uint64_t value);
+	void writeBytes(const void* data, std::size_t size);
+};
+
+// Reads the values written by a ByteWriter straight from the bytes
+// given, without copying them first.
+// Every read will throw if it would go past the end.
+class ByteReader
+{
+	const std::uint8_t* it_ = nullptr;
+	const std::uint8_t* end_ = nullptr;
+
+	// Throws unless size more bytes can be read.
+	void need(std::size_t size) const;
+
+	public:
+
+	// Span constructor.
+	// The bytes must outlive the ByteReader.
+	ByteReader(const std::uint8_t* data, std::size_t size);
+
+	// Returns the amount of bytes left to read.
+	std::size_t remaining() const;
+
+	// Reads the next value.
+	std::uint8_t readU8();
+	std::uint32_t readU32();
+	std::uint64_t readU64();
+	float readF32();
+	std::uint64_t readVarint();
+
+	// Skips size bytes and returns a pointer to the first of them.
+	const std::uint8_t* readBytes(std::size_t size);
+};
+
+#endif // BYTESTREAM_H_INCLUDED
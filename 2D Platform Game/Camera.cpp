@@ -0,0 +1,184 @@
+// 2D Platform Game
+// Camera.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the Camera class.
+
+#include "Camera.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// Jlib/Transform.h
+using Jlib::Mat3f;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cmath>
+using std::ceil;
+using std::exp;
+using std::floor;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+
+// <stdexcept>
+using std::invalid_argument;
+
+Camera::Camera(const Vector2f& viewport_size)
+{
+	setViewport(viewport_size);
+}
+
+void Camera::clampToBounds()
+{
+	if (!has_bounds_)
+		return;
+
+	const float half_width = viewport_.x * 0.5f;
+	const float half_height = viewport_.y * 0.5f;
+
+	if (bounds_right_ - bounds_left_ <= viewport_.x)
+		centre_.x = (bounds_left_ + bounds_right_) * 0.5f;
+	else
+		centre_.x = std::clamp(centre_.x, bounds_left_ + half_width, bounds_right_ - half_width);
+
+	if (bounds_bottom_ - bounds_top_ <= viewport_.y)
+		centre_.y = (bounds_top_ + bounds_bottom_) * 0.5f;
+	else
+		centre_.y = std::clamp(centre_.y, bounds_top_ + half_height, bounds_bottom_ - half_height);
+}
+
+void Camera::setViewport(const Vector2f& size)
+{
+	if (!(size.x >= 0.0f && size.y >= 0.0f))
+		throw invalid_argument("Camera::setViewport: size must not be negative");
+
+	viewport_ = size;
+	clampToBounds();
+}
+
+void Camera::setDeadZone(const Vector2f& size)
+{
+	if (!(size.x >= 0.0f && size.y >= 0.0f))
+		throw invalid_argument("Camera::setDeadZone: size must not be negative");
+
+	dead_zone_ = size;
+}
+
+void Camera::setSmoothing(float seconds)
+{
+	if (!(seconds >= 0.0f))
+		throw invalid_argument("Camera::setSmoothing: seconds must not be negative");
+
+	smoothing_ = seconds;
+}
+
+void Camera::setBounds(float left, float top, float right, float bottom)
+{
+	if (!(right >= left && bottom >= top))
+		throw invalid_argument("Camera::setBounds: right must not be less than left, nor bottom less than top");
+
+	has_bounds_ = true;
+	bounds_left_ = left;
+	bounds_top_ = top;
+	bounds_right_ = right;
+	bounds_bottom_ = bottom;
+	clampToBounds();
+}
+
+void Camera::setBounds(const Matrix<uint8_t>& level)
+{
+	setBounds(0.0f, 0.0f, float(level.colSize()), float(level.rowSize()));
+}
+
+void Camera::clearBounds()
+{
+	has_bounds_ = false;
+}
+
+void Camera::snapTo(const Point2f& target)
+{
+	centre_ = target;
+	clampToBounds();
+}
+
+void Camera::update(const Point2f& target, float seconds)
+{
+	// The closest centre that keeps target inside the dead zone.
+	const float half_zone_x = dead_zone_.x * 0.5f;
+	const float half_zone_y = dead_zone_.y * 0.5f;
+	const float goal_x = std::clamp(centre_.x, target.x - half_zone_x, target.x + half_zone_x);
+	const float goal_y = std::clamp(centre_.y, target.y - half_zone_y, target.y + half_zone_y);
+
+	// Exponential easing does not depend on the frame rate.
+	const float t = smoothing_ > 0.0f ? 1.0f - exp(-seconds / smoothing_) : 1.0f;
+
+	centre_.x += (goal_x - centre_.x) * t;
+	centre_.y += (goal_y - centre_.y) * t;
+	clampToBounds();
+}
+
+Point2f Camera::centre() const
+{
+	return centre_;
+}
+
+Point2f Camera::topLeft() const
+{
+	return Point2f(centre_.x - viewport_.x * 0.5f, centre_.y - viewport_.y * 0.5f);
+}
+
+Vector2f Camera::viewport() const
+{
+	return viewport_;
+}
+
+Rectangle<int32_t> Camera::visibleTiles(int32_t margin) const
+{
+	const Point2f top_left = topLeft();
+
+	int32_t left = int32_t(floor(top_left.x)) - margin;
+	int32_t top = int32_t(floor(top_left.y)) - margin;
+	int32_t right = int32_t(ceil(top_left.x + viewport_.x)) + margin;
+	int32_t bottom = int32_t(ceil(top_left.y + viewport_.y)) + margin;
+
+	if (has_bounds_)
+	{
+		left = std::max(left, int32_t(floor(bounds_left_)));
+		top = std::max(top, int32_t(floor(bounds_top_)));
+		right = std::min(right, int32_t(ceil(bounds_right_)));
+		bottom = std::min(bottom, int32_t(ceil(bounds_bottom_)));
+	}
+
+	return Rectangle<int32_t>(left, top, std::max(right - left, 0), std::max(bottom - top, 0));
+}
+
+bool Camera::isVisible(const Point2f& point, float margin) const
+{
+	return std::fabs(point.x - centre_.x) <= viewport_.x * 0.5f + margin && std::fabs(point.y - centre_.y) <= viewport_.y * 0.5f + margin;
+}
+
+Mat3f Camera::viewTransform(float pixels_per_tile) const
+{
+	const Point2f top_left = topLeft();
+	return Mat3f::scale(pixels_per_tile, pixels_per_tile) * Mat3f::translation(-top_left.x, -top_left.y);
+}
+
+Point2f Camera::toView(const Point2f& point) const
+{
+	return viewTransform().transformPoint(point);
+}
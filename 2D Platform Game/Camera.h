@@ -0,0 +1,115 @@
+// 2D Platform Game
+// Camera.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the Camera class.
+
+#ifndef CAMERA_H_INCLUDED
+#define CAMERA_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/Rectangle.h"
+#include "Jlib/Transform.h"
+#include "Jlib/Vector.h"
+
+#include <cstdint>
+
+// Follows a target around the level. Positions and sizes are in tiles.
+// The target can move within a dead zone around the centre of the
+// view without moving the Camera. Once it leaves, the Camera eases
+// towards keeping it at the edge of the dead zone, and the view is
+// kept inside the level bounds if there are any.
+// visibleTiles gives the range of tiles on screen, so per frame work
+// only depends on the viewport size.
+class Camera
+{
+	Jlib::Point2f centre_;
+	Jlib::Vector2f viewport_;
+	Jlib::Vector2f dead_zone_;
+	float smoothing_ = 0.0f;
+
+	bool has_bounds_ = false;
+	float bounds_left_ = 0.0f;
+	float bounds_top_ = 0.0f;
+	float bounds_right_ = 0.0f;
+	float bounds_bottom_ = 0.0f;
+
+	// Moves the centre so the view stays inside the bounds.
+	// A view larger than the bounds is centred on them.
+	void clampToBounds();
+
+	public:
+
+	// Default constructor.
+	Camera() = default;
+
+	// Viewport constructor.
+	// Sets the size of the view.
+	// This function will throw if either component of viewport_size is negative.
+	explicit Camera(const Jlib::Vector2f& viewport_size);
+
+	// Sets the size of the view.
+	// This function will throw if either component of size is negative.
+	void setViewport(const Jlib::Vector2f& size);
+
+	// Sets the size of the box around the centre of the view the target
+	// can move within without moving the Camera.
+	// This function will throw if either component of size is negative.
+	void setDeadZone(const Jlib::Vector2f& size);
+
+	// Sets how long the Camera takes to catch up with the target:
+	// the remaining distance shrinks by a factor of e every given
+	// amount of seconds, whatever the frame rate.
+	// 0, the default, follows the target instantly.
+	// This function will throw if seconds is negative.
+	void setSmoothing(float seconds);
+
+	// Keeps the view inside the given area.
+	// This function will throw if right < left or bottom < top.
+	void setBounds(float left, float top, float right, float bottom);
+
+	// Keeps the view inside the given level layout.
+	void setBounds(const Jlib::Matrix<std::uint8_t>& level);
+
+	// Lets the view go anywhere.
+	void clearBounds();
+
+	// Centres the view on target at once, ignoring the dead zone and smoothing.
+	void snapTo(const Jlib::Point2f& target);
+
+	// Moves the view towards target by the given amount of seconds.
+	void update(const Jlib::Point2f& target, float seconds);
+
+	// Returns the centre of the view.
+	Jlib::Point2f centre() const;
+
+	// Returns the top left corner of the view.
+	Jlib::Point2f topLeft() const;
+
+	// Returns the size of the view.
+	Jlib::Vector2f viewport() const;
+
+	// Returns the range of tiles at least partly on screen, grown by
+	// margin tiles on every side and cut to the bounds if there are any.
+	// The rectangle covers the tiles vertex.x to vertex.x + width - 1
+	// and vertex.y to vertex.y + height - 1. Its size is never negative.
+	Jlib::Rectangle<std::int32_t> visibleTiles(std::int32_t margin = 0) const;
+
+	// Returns true if point is on screen or within margin tiles of it.
+	// Returns false otherwise.
+	bool isVisible(const Jlib::Point2f& point, float margin = 0.0f) const;
+
+	// Returns the transform from positions in the level, in tiles, to
+	// positions on screen, with the top left corner of the view at (0, 0)
+	// and pixels_per_tile pixels to a tile.
+	Jlib::Mat3f viewTransform(float pixels_per_tile = 1.0f) const;
+
+	// Returns point relative to the top left corner of the view.
+	// Multiply by the tile size in pixels to get screen coordinates,
+	// or use viewTransform.
+	Jlib::Point2f toView(const Jlib::Point2f& point) const;
+};
+
+#endif // CAMERA_H_INCLUDED
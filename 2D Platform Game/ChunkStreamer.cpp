@@ -0,0 +1,257 @@
+// 2D Platform Game
+// ChunkStreamer.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ChunkStreamer class.
+
+#include "ChunkStreamer.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::int64_t;
+using std::uint8_t;
+using std::uint64_t;
+
+// <memory>
+using std::make_unique;
+
+// <stdexcept>
+using std::invalid_argument;
+
+namespace
+{
+	// Rounds towards negative infinity, unlike integer division.
+	int32_t floor_div(int32_t value, int32_t divisor)
+	{
+		return value / divisor - (value % divisor < 0 ? 1 : 0);
+	}
+
+	uint64_t chunk_key(int32_t chunk_x, int32_t chunk_y)
+	{
+		return (uint64_t(std::uint32_t(chunk_x)) << 32) | uint64_t(std::uint32_t(chunk_y));
+	}
+
+	// Returns how many chunks value is outside of [low, high].
+	int64_t distance_outside(int32_t value, int32_t low, int32_t high)
+	{
+		if (value < low)
+			return int64_t(low) - value;
+
+		if (value > high)
+			return int64_t(value) - high;
+
+		return 0;
+	}
+}
+
+ChunkStreamer::ChunkStreamer(const LevelGenerator& generator, ThreadPool* pool)
+	: generator_(generator), pool_(pool)
+{
+
+}
+
+const ChunkStreamer::Chunk* ChunkStreamer::find(int32_t x, int32_t y) const
+{
+	const auto it = chunks_.find(chunk_key(floor_div(x, CHUNK_SIZE), floor_div(y, CHUNK_SIZE)));
+
+	return it != chunks_.end() ? it->second.get() : nullptr;
+}
+
+void ChunkStreamer::setRange(int32_t margin, int32_t lookahead, size_t budget)
+{
+	if (margin < 0 || lookahead < 0)
+		throw invalid_argument("ChunkStreamer::setRange: margin and lookahead must not be negative");
+
+	if (budget == 0)
+		throw invalid_argument("ChunkStreamer::setRange: budget must not be 0");
+
+	margin_ = margin;
+	lookahead_ = lookahead;
+	budget_ = budget;
+}
+
+size_t ChunkStreamer::update(const Rectangle<int32_t>& visible_tiles, const Vector2f& velocity)
+{
+	// Chunks under the visible tiles.
+	const int32_t view_left = floor_div(visible_tiles.vertex.x, CHUNK_SIZE);
+	const int32_t view_top = floor_div(visible_tiles.vertex.y, CHUNK_SIZE);
+	const int32_t view_right = floor_div(visible_tiles.vertex.x + std::max(visible_tiles.width, 1) - 1, CHUNK_SIZE);
+	const int32_t view_bottom = floor_div(visible_tiles.vertex.y + std::max(visible_tiles.height, 1) - 1, CHUNK_SIZE);
+
+	// Chunks wanted.
+	int32_t left = view_left - margin_;
+	int32_t top = view_top - margin_;
+	int32_t right = view_right + margin_;
+	int32_t bottom = view_bottom + margin_;
+
+	if (velocity.x < 0.0f)
+		left -= lookahead_;
+	else if (velocity.x > 0.0f)
+		right += lookahead_;
+
+	if (velocity.y < 0.0f)
+		top -= lookahead_;
+	else if (velocity.y > 0.0f)
+		bottom += lookahead_;
+
+	// Chunks just past the wanted area are kept, so moving back and
+	// forth over a chunk border does not generate the same chunks again.
+	for (auto it = chunks_.begin(); it != chunks_.end();)
+	{
+		const Chunk& chunk = *it->second;
+
+		if (chunk.x < left - 1 || chunk.x > right + 1 || chunk.y < top - 1 || chunk.y > bottom + 1)
+		{
+			free_.push_back(std::move(it->second));
+			it = chunks_.erase(it);
+		}
+		else
+			++it;
+	}
+
+	missing_.clear();
+
+	for (int32_t y = top; y <= bottom; ++y)
+	{
+		for (int32_t x = left; x <= right; ++x)
+		{
+			if (chunks_.contains(chunk_key(x, y)))
+				continue;
+
+			const int64_t dx = distance_outside(x, view_left, view_right);
+			const int64_t dy = distance_outside(y, view_top, view_bottom);
+
+			missing_.emplace_back(dx * dx + dy * dy, chunk_key(x, y));
+		}
+	}
+
+	if (missing_.empty())
+		return 0;
+
+	const size_t count = std::min(budget_, missing_.size());
+
+	std::partial_sort(missing_.begin(), missing_.begin() + std::ptrdiff_t(count), missing_.end());
+
+	batch_.clear();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (free_.empty())
+			batch_.push_back(make_unique<Chunk>());
+		else
+		{
+			batch_.push_back(std::move(free_.back()));
+			free_.pop_back();
+		}
+
+		batch_.back()->x = int32_t(std::uint32_t(missing_[i].second >> 32));
+		batch_.back()->y = int32_t(std::uint32_t(missing_[i].second));
+	}
+
+	const auto generate = [this](size_t index)
+	{
+		Chunk& chunk = *batch_[index];
+		generator_.generateChunk(chunk.x, chunk.y, chunk.tiles);
+	};
+
+	if (pool_ != nullptr)
+		pool_->parallelFor(count, generate);
+	else
+	{
+		for (size_t i = 0; i < count; ++i)
+			generate(i);
+	}
+
+	for (auto& chunk : batch_)
+	{
+		const uint64_t key = chunk_key(chunk->x, chunk->y);
+		chunks_.emplace(key, std::move(chunk));
+	}
+
+	batch_.clear();
+	generated_ += count;
+
+	return count;
+}
+
+bool ChunkStreamer::hasChunk(int32_t chunk_x, int32_t chunk_y) const
+{
+	return chunks_.contains(chunk_key(chunk_x, chunk_y));
+}
+
+uint8_t ChunkStreamer::tileAt(int32_t x, int32_t y) const
+{
+	const Chunk* chunk = find(x, y);
+
+	if (chunk == nullptr)
+		return TILE_SOLID;
+
+	const int32_t c = x - chunk->x * CHUNK_SIZE;
+	const int32_t r = y - chunk->y * CHUNK_SIZE;
+
+	return chunk->tiles[size_t(r) * CHUNK_SIZE + size_t(c)];
+}
+
+void ChunkStreamer::copyTo(Matrix<uint8_t>& layout, const Rectangle<int32_t>& tiles) const
+{
+	const size_t width = size_t(std::max(tiles.width, 0));
+	const size_t height = size_t(std::max(tiles.height, 0));
+
+	layout.resize(height, width);
+
+	// Copies each row one chunk wide run at a time.
+	for (size_t r = 0; r < height; ++r)
+	{
+		const int32_t y = tiles.vertex.y + int32_t(r);
+		uint8_t* row = layout.data() + r * width;
+
+		for (size_t c = 0; c < width;)
+		{
+			const int32_t x = tiles.vertex.x + int32_t(c);
+			const int32_t chunk_column = x - floor_div(x, CHUNK_SIZE) * CHUNK_SIZE;
+			const size_t run = std::min(size_t(CHUNK_SIZE - chunk_column), width - c);
+			const Chunk* chunk = find(x, y);
+
+			if (chunk == nullptr)
+				std::memset(row + c, TILE_SOLID, run);
+			else
+			{
+				const int32_t chunk_row = y - chunk->y * CHUNK_SIZE;
+				std::memcpy(row + c, chunk->tiles + size_t(chunk_row) * CHUNK_SIZE + size_t(chunk_column), run);
+			}
+
+			c += run;
+		}
+	}
+}
+
+size_t ChunkStreamer::chunkCount() const
+{
+	return chunks_.size();
+}
+
+size_t ChunkStreamer::generatedCount() const
+{
+	return generated_;
+}
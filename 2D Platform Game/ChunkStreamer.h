@@ -0,0 +1,111 @@
+// 2D Platform Game
+// ChunkStreamer.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ChunkStreamer class.
+
+#ifndef CHUNKSTREAMER_H_INCLUDED
+#define CHUNKSTREAMER_H_INCLUDED
+
+#include "LevelGenerator.h"
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Rectangle.h"
+#include "Jlib/ThreadPool.h"
+#include "Jlib/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Keeps the chunks of a LevelGenerator around the camera generated, so
+// an endless level only holds the part near the player.
+// Each update wants the chunks under the visible tiles, margin chunks
+// around them and lookahead more in the direction the camera moves.
+// Missing chunks are generated nearest to the screen first, at most
+// budget per update, in parallel when there is a ThreadPool. Chunks
+// more than one chunk past the wanted area are dropped, and their
+// memory reused for the next ones generated.
+class ChunkStreamer
+{
+	public:
+
+	static constexpr std::int32_t CHUNK_SIZE = LevelGenerator::CHUNK_SIZE;
+
+	private:
+
+	struct Chunk
+	{
+		std::int32_t x = 0;
+		std::int32_t y = 0;
+		std::uint8_t tiles[LevelGenerator::CHUNK_TILES];
+	};
+
+	LevelGenerator generator_;
+	Jlib::ThreadPool* pool_ = nullptr;
+	std::int32_t margin_ = 1;
+	std::int32_t lookahead_ = 2;
+	std::size_t budget_ = 16;
+
+	std::unordered_map<std::uint64_t, std::unique_ptr<Chunk>> chunks_;
+	std::vector<std::unique_ptr<Chunk>> free_;
+
+	// Kept so update does not allocate once the level has been explored.
+	std::vector<std::pair<std::int64_t, std::uint64_t>> missing_;
+	std::vector<std::unique_ptr<Chunk>> batch_;
+	std::size_t generated_ = 0;
+
+	// Returns the chunk holding tile (x, y), or nullptr if it is not generated.
+	const Chunk* find(std::int32_t x, std::int32_t y) const;
+
+	public:
+
+	// Generator constructor.
+	// Chunks are generated on the calling thread if pool is nullptr.
+	explicit ChunkStreamer(const LevelGenerator& generator, Jlib::ThreadPool* pool = nullptr);
+
+	// Copy constructor. Deleted.
+	ChunkStreamer(const ChunkStreamer& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	ChunkStreamer& operator = (const ChunkStreamer& other) = delete;
+
+	// Sets how many chunks are kept around the visible tiles, how many
+	// more are generated ahead of the camera, and the most chunks
+	// generated by one update.
+	// This function will throw if margin or lookahead is negative or budget is 0.
+	void setRange(std::int32_t margin, std::int32_t lookahead, std::size_t budget);
+
+	// Generates the missing chunks near visible_tiles, as given by
+	// Camera::visibleTiles, and drops the far ones. velocity is how the
+	// camera or player moves; only the sign of each component is used.
+	// Returns the amount of chunks generated.
+	std::size_t update(const Jlib::Rectangle<std::int32_t>& visible_tiles, const Jlib::Vector2f& velocity);
+
+	// Returns true if the given chunk is generated.
+	// Returns false otherwise.
+	bool hasChunk(std::int32_t chunk_x, std::int32_t chunk_y) const;
+
+	// Returns the tile at (x, y). Tiles of chunks not generated are
+	// TILE_SOLID, as is_solid_at treats tiles outside of a level.
+	std::uint8_t tileAt(std::int32_t x, std::int32_t y) const;
+
+	// Copies the given tiles to layout, resized to fit, so the code
+	// written for level.txt layouts can use them. Tile (0, 0) of layout
+	// is tiles.vertex; offset positions by it.
+	// Tiles of chunks not generated are TILE_SOLID.
+	void copyTo(Jlib::Matrix<std::uint8_t>& layout, const Jlib::Rectangle<std::int32_t>& tiles) const;
+
+	// Returns the amount of chunks held.
+	std::size_t chunkCount() const;
+
+	// Returns the amount of chunks generated since construction,
+	// including ones dropped and generated again.
+	std::size_t generatedCount() const;
+};
+
+#endif // CHUNKSTREAMER_H_INCLUDED
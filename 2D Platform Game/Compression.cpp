@@ -0,0 +1,254 @@
+// 2D Platform Game
+// Compression.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for LZ block compression.
+
+#include "Compression.h"
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <stdexcept>
+using std::invalid_argument;
+using std::runtime_error;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr size_t MIN_MATCH = 4;
+	constexpr size_t MAX_OFFSET = 0xFFFF;
+	constexpr uint32_t HASH_BITS = 14;
+
+	uint32_t load32(const uint8_t* data)
+	{
+		uint32_t value = 0;
+		std::memcpy(&value, data, 4);
+		return value;
+	}
+
+	uint64_t load64(const uint8_t* data)
+	{
+		uint64_t value = 0;
+		std::memcpy(&value, data, 8);
+		return value;
+	}
+
+	uint8_t* write_length(uint8_t* out, size_t length)
+	{
+		while (length >= 255)
+		{
+			*out++ = 255;
+			length -= 255;
+		}
+
+		*out++ = uint8_t(length);
+		return out;
+	}
+
+	size_t read_length(const uint8_t*& in, const uint8_t* end)
+	{
+		size_t length = 0;
+
+		while (true)
+		{
+			if (in == end)
+				throw runtime_error("lz_decompress: the block is damaged");
+
+			const uint8_t byte = *in++;
+			length += byte;
+
+			if (byte != 255)
+				return length;
+		}
+	}
+
+	// Writes a sequence of literals followed by a match. A match_length
+	// of 0 writes the last sequence, which has no match.
+	uint8_t* write_sequence(uint8_t* out, const uint8_t* literals, size_t literal_count, size_t offset, size_t match_length)
+	{
+		const size_t match_code = match_length != 0 ? match_length - MIN_MATCH : 0;
+		uint8_t* const token = out++;
+
+		*token = uint8_t((literal_count < 15 ? literal_count : 15) << 4);
+
+		if (literal_count >= 15)
+			out = write_length(out, literal_count - 15);
+
+		std::memcpy(out, literals, literal_count);
+		out += literal_count;
+
+		if (match_length == 0)
+			return out;
+
+		*token |= uint8_t(match_code < 15 ? match_code : 15);
+		*out++ = uint8_t(offset);
+		*out++ = uint8_t(offset >> 8);
+
+		if (match_code >= 15)
+			out = write_length(out, match_code - 15);
+
+		return out;
+	}
+}
+
+size_t lz_bound(size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+void lz_compress(const uint8_t* data, size_t size, ByteWriter& writer)
+{
+	// Positions are kept as uint32_t, plus one so 0 means none.
+	if (size >= std::numeric_limits<uint32_t>::max())
+		throw invalid_argument("lz_compress: blocks must be smaller than 4 GiB");
+
+	const size_t bound = lz_bound(size);
+	const size_t block_start = writer.size();
+	uint8_t* const start = writer.reserve(bound);
+	uint8_t* out = start;
+
+	// Positions of recent 4 byte sequences, by hash.
+	thread_local vector<uint32_t> table;
+	table.assign(size_t(1) << HASH_BITS, 0);
+
+	size_t anchor = 0;
+	size_t i = 0;
+
+	while (i + MIN_MATCH <= size)
+	{
+		const uint32_t sequence = load32(data + i);
+		const uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+		const size_t candidate = table[hash];
+
+		table[hash] = uint32_t(i + 1);
+
+		if (candidate != 0 && i - (candidate - 1) <= MAX_OFFSET && load32(data + candidate - 1) == sequence)
+		{
+			const size_t match = candidate - 1;
+			size_t length = MIN_MATCH;
+
+			// Compares 8 bytes at a time; the lowest differing bit
+			// gives the first differing byte.
+			while (i + length + 8 <= size)
+			{
+				const uint64_t difference = load64(data + match + length) ^ load64(data + i + length);
+
+				if (difference != 0)
+				{
+					length += size_t(std::countr_zero(difference)) / 8;
+					break;
+				}
+
+				length += 8;
+			}
+
+			if (i + length + 8 > size)
+			{
+				while (i + length < size && data[match + length] == data[i + length])
+					++length;
+			}
+
+			out = write_sequence(out, data + anchor, i - anchor, i - match, length);
+			i += length;
+			anchor = i;
+		}
+		else
+		{
+			// Steps further the longer nothing matches, so data that
+			// does not compress is passed over quickly.
+			i += 1 + ((i - anchor) >> 6);
+		}
+	}
+
+	out = write_sequence(out, data + anchor, size - anchor, 0, 0);
+	writer.truncate(block_start + size_t(out - start));
+}
+
+void lz_decompress(const uint8_t* block, size_t block_size, uint8_t* output, size_t output_size)
+{
+	const uint8_t* in = block;
+	const uint8_t* const in_end = block + block_size;
+	uint8_t* out = output;
+	uint8_t* const out_end = output + output_size;
+
+	while (true)
+	{
+		if (in == in_end)
+			throw runtime_error("lz_decompress: the block is damaged");
+
+		const uint8_t token = *in++;
+		size_t literal_count = token >> 4;
+
+		if (literal_count == 15)
+			literal_count += read_length(in, in_end);
+
+		if (literal_count > size_t(in_end - in) || literal_count > size_t(out_end - out))
+			throw runtime_error("lz_decompress: the block is damaged");
+
+		// Short runs are copied 16 bytes at once when both sides have room.
+		if (literal_count <= 16 && in_end - in >= 16 && out_end - out >= 16)
+			std::memcpy(out, in, 16);
+		else
+			std::memcpy(out, in, literal_count);
+
+		in += literal_count;
+		out += literal_count;
+
+		if (in == in_end)
+			break;
+
+		if (in_end - in < 2)
+			throw runtime_error("lz_decompress: the block is damaged");
+
+		const size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+		in += 2;
+
+		size_t length = size_t(token & 15) + MIN_MATCH;
+
+		if ((token & 15) == 15)
+			length += read_length(in, in_end);
+
+		if (offset == 0 || offset > size_t(out - output) || length > size_t(out_end - out))
+			throw runtime_error("lz_decompress: the block is damaged");
+
+		const uint8_t* match = out - offset;
+
+		// Matches may overlap what they write, repeating the last offset
+		// bytes. Copying 8 bytes at a time only reads bytes already
+		// written when they are at least 8 bytes back.
+		if (offset >= 8 && length <= 16 && out_end - out >= 16)
+		{
+			std::memcpy(out, match, 8);
+			std::memcpy(out + 8, match + 8, 8);
+		}
+		else if (offset >= length)
+			std::memcpy(out, match, length);
+		else if (offset == 1)
+			std::memset(out, *match, length);
+		else
+		{
+			for (size_t j = 0; j < length; ++j)
+				out[j] = match[j];
+		}
+
+		out += length;
+	}
+
+	if (out != out_end)
+		throw runtime_error("lz_decompress: the block is shorter than expected");
+}
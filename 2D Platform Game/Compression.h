@@ -0,0 +1,38 @@
+// 2D Platform Game
+// Compression.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for LZ block compression.
+
+#ifndef COMPRESSION_H_INCLUDED
+#define COMPRESSION_H_INCLUDED
+
+#include "ByteStream.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// A fast LZ77 block format in the style of LZ4, meant for data
+// written and read by this game, such as saves.
+// The block is a list of sequences: a token byte holding the amount of
+// literals in its high 4 bits and the match length minus 4 in its low
+// 4 bits, where 15 means more length bytes follow, each adding up to
+// 255; the literals; then a 2 byte offset back to the match and any
+// more match length bytes. The last sequence has literals only.
+// The block does not store its own size: keep the uncompressed size
+// alongside it.
+
+// Returns the most bytes lz_compress can write for size bytes of input.
+std::size_t lz_bound(std::size_t size);
+
+// Appends the compressed form of the given bytes to writer, compressing
+// straight into its buffer.
+void lz_compress(const std::uint8_t* data, std::size_t size, ByteWriter& writer);
+
+// Decompresses a block made by lz_compress into output, which must be
+// exactly output_size bytes, the size of the data compressed.
+// This function will throw if the block is damaged or does not fill output.
+void lz_decompress(const std::uint8_t* block, std::size_t block_size, std::uint8_t* output, std::size_t output_size);
+
+#endif // COMPRESSION_H_INCLUDED
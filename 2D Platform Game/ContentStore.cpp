@@ -0,0 +1,219 @@
+// 2D Platform Game
+// ContentStore.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for content hashing and the ContentStore class.
+
+#include "ContentStore.h"
+
+#include <algorithm>
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <memory>
+using std::make_shared;
+using std::shared_ptr;
+using std::weak_ptr;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+	constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+	constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+	constexpr uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+	constexpr uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+	uint64_t rotate_left(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// Little endian loads, so hashes match across platforms.
+	uint64_t read_64(const uint8_t* bytes)
+	{
+		uint64_t value = 0;
+
+		for (int i = 7; i >= 0; --i)
+			value = (value << 8) | bytes[i];
+
+		return value;
+	}
+
+	uint32_t read_32(const uint8_t* bytes)
+	{
+		return uint32_t(bytes[0]) | uint32_t(bytes[1]) << 8 | uint32_t(bytes[2]) << 16 | uint32_t(bytes[3]) << 24;
+	}
+
+	uint64_t hash_round(uint64_t accumulator, uint64_t input)
+	{
+		accumulator += input * PRIME_2;
+		accumulator = rotate_left(accumulator, 31);
+		return accumulator * PRIME_1;
+	}
+
+	uint64_t merge_round(uint64_t hash, uint64_t lane)
+	{
+		hash ^= hash_round(0, lane);
+		return hash * PRIME_1 + PRIME_4;
+	}
+}
+
+uint64_t content_hash(const void* data, size_t size, uint64_t seed)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	const uint8_t* const end = bytes + size;
+	uint64_t hash;
+
+	if (size >= 32)
+	{
+		// Four independent lanes keep the multiplier busy.
+		uint64_t lane_1 = seed + PRIME_1 + PRIME_2;
+		uint64_t lane_2 = seed + PRIME_2;
+		uint64_t lane_3 = seed;
+		uint64_t lane_4 = seed - PRIME_1;
+
+		for (; end - bytes >= 32; bytes += 32)
+		{
+			lane_1 = hash_round(lane_1, read_64(bytes));
+			lane_2 = hash_round(lane_2, read_64(bytes + 8));
+			lane_3 = hash_round(lane_3, read_64(bytes + 16));
+			lane_4 = hash_round(lane_4, read_64(bytes + 24));
+		}
+
+		hash = rotate_left(lane_1, 1) + rotate_left(lane_2, 7) + rotate_left(lane_3, 12) + rotate_left(lane_4, 18);
+		hash = merge_round(hash, lane_1);
+		hash = merge_round(hash, lane_2);
+		hash = merge_round(hash, lane_3);
+		hash = merge_round(hash, lane_4);
+	}
+	else
+		hash = seed + PRIME_5;
+
+	hash += uint64_t(size);
+
+	for (; end - bytes >= 8; bytes += 8)
+	{
+		hash ^= hash_round(0, read_64(bytes));
+		hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+	}
+
+	if (end - bytes >= 4)
+	{
+		hash ^= uint64_t(read_32(bytes)) * PRIME_1;
+		hash = rotate_left(hash, 23) * PRIME_2 + PRIME_3;
+		bytes += 4;
+	}
+
+	for (; bytes != end; ++bytes)
+	{
+		hash ^= *bytes * PRIME_5;
+		hash = rotate_left(hash, 11) * PRIME_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= PRIME_2;
+	hash ^= hash >> 29;
+	hash *= PRIME_3;
+	hash ^= hash >> 32;
+
+	return hash;
+}
+
+shared_ptr<const ContentBlob> ContentStore::intern(const void* data, size_t size)
+{
+	const uint64_t hash = content_hash(data, size);
+	const uint8_t* const bytes = static_cast<const uint8_t*>(data);
+
+	lock_guard<mutex> lock(mutex_);
+	requested_bytes_ += size;
+
+	vector<weak_ptr<const ContentBlob>>& bucket = blobs_[hash];
+
+	for (size_t i = 0; i < bucket.size();)
+	{
+		shared_ptr<const ContentBlob> blob = bucket[i].lock();
+
+		if (!blob)
+		{
+			bucket[i] = std::move(bucket.back());
+			bucket.pop_back();
+			continue;
+		}
+
+		if (blob->size() == size && std::equal(blob->begin(), blob->end(), bytes))
+			return blob;
+
+		++i;
+	}
+
+	shared_ptr<const ContentBlob> blob = make_shared<const ContentBlob>(bytes, bytes + size);
+	bucket.push_back(blob);
+
+	return blob;
+}
+
+void ContentStore::prune()
+{
+	lock_guard<mutex> lock(mutex_);
+
+	for (auto it = blobs_.begin(); it != blobs_.end();)
+	{
+		std::erase_if(it->second, [](const weak_ptr<const ContentBlob>& blob) { return blob.expired(); });
+
+		if (it->second.empty())
+			it = blobs_.erase(it);
+		else
+			++it;
+	}
+}
+
+size_t ContentStore::uniqueCount() const
+{
+	lock_guard<mutex> lock(mutex_);
+	size_t count = 0;
+
+	for (const auto& [hash, bucket] : blobs_)
+	{
+		for (const weak_ptr<const ContentBlob>& blob : bucket)
+			count += blob.expired() ? 0 : 1;
+	}
+
+	return count;
+}
+
+size_t ContentStore::uniqueBytes() const
+{
+	lock_guard<mutex> lock(mutex_);
+	size_t bytes = 0;
+
+	for (const auto& [hash, bucket] : blobs_)
+	{
+		for (const weak_ptr<const ContentBlob>& blob : bucket)
+		{
+			if (const shared_ptr<const ContentBlob> alive = blob.lock())
+				bytes += alive->size();
+		}
+	}
+
+	return bytes;
+}
+
+size_t ContentStore::requestedBytes() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return requested_bytes_;
+}
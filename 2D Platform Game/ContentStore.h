@@ -0,0 +1,69 @@
+// 2D Platform Game
+// ContentStore.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for content hashing and the ContentStore class.
+
+#ifndef CONTENTSTORE_H_INCLUDED
+#define CONTENTSTORE_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Returns the XXH64 hash of the given bytes.
+// The result is the same on every run and platform, so it can name
+// files on disk.
+std::uint64_t content_hash(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+// Block of bytes shared by everything with the same contents.
+using ContentBlob = std::vector<std::uint8_t>;
+
+// Keeps one copy of each distinct block of bytes, such as a chunk of
+// tiles, a row of tiles or the pixels of a texture, so assets with
+// equal parts share them instead of holding copies.
+// Blocks are found by content_hash and compared byte by byte, so
+// hash collisions never mix up contents. A block is freed once
+// nothing refers to it any more.
+// Safe to use from several threads at once.
+class ContentStore
+{
+	mutable std::mutex mutex_;
+	std::unordered_map<std::uint64_t, std::vector<std::weak_ptr<const ContentBlob>>> blobs_;
+	std::size_t requested_bytes_ = 0;
+
+	public:
+
+	// Default constructor.
+	ContentStore() = default;
+
+	// Copy constructor. Deleted.
+	ContentStore(const ContentStore& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	ContentStore& operator = (const ContentStore& other) = delete;
+
+	// Returns the shared block with the given contents, adding it if
+	// there is none.
+	std::shared_ptr<const ContentBlob> intern(const void* data, std::size_t size);
+
+	// Forgets blocks nothing refers to any more.
+	// intern does this as it goes for the hashes it looks up.
+	void prune();
+
+	// Returns the amount of distinct blocks alive.
+	std::size_t uniqueCount() const;
+
+	// Returns the amount of bytes held by distinct blocks alive.
+	std::size_t uniqueBytes() const;
+
+	// Returns the amount of bytes passed to intern so far: what storing
+	// every block separately would have cost.
+	std::size_t requestedBytes() const;
+};
+
+#endif // CONTENTSTORE_H_INCLUDED
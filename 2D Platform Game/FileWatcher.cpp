@@ -0,0 +1,132 @@
+// 2D Platform Game
+// FileWatcher.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the FileWatcher class.
+
+#include "FileWatcher.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <algorithm>
+#include <thread>
+#endif // __linux__
+
+// <chrono>
+using std::chrono::milliseconds;
+
+// <cstdint>
+using std::int64_t;
+
+// <filesystem>
+namespace fs = std::filesystem;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+FileWatcher::FileWatcher(const string& path)
+	: path_(path)
+{
+	const fs::path file = fs::absolute(path).lexically_normal();
+
+	directory_ = file.parent_path().string();
+	name_ = file.filename().string();
+
+	#ifdef __linux__
+	inotify_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (inotify_ < 0)
+		throw runtime_error("FileWatcher: could not start inotify");
+
+	// Watching the directory catches files replaced by a rename.
+	if (inotify_add_watch(inotify_, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+	{
+		close(inotify_);
+		throw runtime_error("FileWatcher: could not watch " + directory_);
+	}
+	#else
+	std::error_code error;
+	modified_ = int64_t(fs::last_write_time(path_, error).time_since_epoch().count());
+	size_ = fs::file_size(path_, error);
+	#endif // __linux__
+}
+
+FileWatcher::~FileWatcher()
+{
+	#ifdef __linux__
+	close(inotify_);
+	#endif // __linux__
+}
+
+const string& FileWatcher::path() const
+{
+	return path_;
+}
+
+bool FileWatcher::wait(milliseconds timeout)
+{
+	#ifdef __linux__
+	pollfd request = { inotify_, POLLIN, 0 };
+
+	if (poll(&request, 1, int(timeout.count())) <= 0)
+		return false;
+
+	// Read every queued event, so a burst of writes is reported once.
+	alignas(inotify_event) char buffer[4096];
+	bool written = false;
+
+	while (true)
+	{
+		const ssize_t size = read(inotify_, buffer, sizeof(buffer));
+
+		if (size <= 0)
+			break;
+
+		for (ssize_t offset = 0; offset < size;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+
+			if (event->len > 0 && name_ == event->name)
+				written = true;
+
+			offset += ssize_t(sizeof(inotify_event) + event->len);
+		}
+	}
+
+	return written;
+	#else
+	const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+	while (true)
+	{
+		std::error_code time_error;
+		std::error_code size_error;
+		const int64_t modified = int64_t(fs::last_write_time(path_, time_error).time_since_epoch().count());
+		const std::uintmax_t size = fs::file_size(path_, size_error);
+
+		if (!time_error && !size_error && (modified != modified_ || size != size_))
+		{
+			modified_ = modified;
+			size_ = size;
+			return true;
+		}
+
+		const auto now = std::chrono::steady_clock::now();
+
+		if (now >= deadline)
+			return false;
+
+		std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, milliseconds(50)));
+	}
+	#endif // __linux__
+}
@@ -0,0 +1,59 @@
+// 2D Platform Game
+// FileWatcher.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the FileWatcher class.
+
+#ifndef FILEWATCHER_H_INCLUDED
+#define FILEWATCHER_H_INCLUDED
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Tells when a file has been written.
+// On Linux this uses inotify on the file's directory, so it also sees
+// editors that save by writing a new file and renaming it over the
+// old one, and waiting costs nothing while the file does not change.
+// Elsewhere the file's modification time and size are polled.
+class FileWatcher
+{
+	std::string path_;
+	std::string directory_;
+	std::string name_;
+
+	#ifdef __linux__
+	int inotify_ = -1;
+	#else
+	std::int64_t modified_ = 0;
+	std::uintmax_t size_ = 0;
+	#endif // __linux__
+
+	public:
+
+	// Path constructor.
+	// Starts watching the file at path, which need not exist yet.
+	// This function will throw if the file's directory cannot be watched.
+	explicit FileWatcher(const std::string& path);
+
+	// Copy constructor. Deleted.
+	FileWatcher(const FileWatcher& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	FileWatcher& operator = (const FileWatcher& other) = delete;
+
+	// Destructor.
+	~FileWatcher();
+
+	// Returns the path of the watched file.
+	const std::string& path() const;
+
+	// Blocks until the file is written or the timeout passes.
+	// Several writes close together may be reported as one.
+	// Returns true if the file was written.
+	// Returns false otherwise.
+	bool wait(std::chrono::milliseconds timeout);
+};
+
+#endif // FILEWATCHER_H_INCLUDED
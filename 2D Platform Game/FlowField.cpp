@@ -0,0 +1,646 @@
+// 2D Platform Game
+// FlowField.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the FlowField class.
+
+#include "FlowField.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+using Jlib::Point2i;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <utility>
+using std::pair;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// The 8 neighbours of a tile, in the order used by direction indices
+	// and by the bits of FlowField::spill_. Neighbour 7 - n is opposite n.
+	constexpr int32_t NEIGHBOUR_DX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+	constexpr int32_t NEIGHBOUR_DY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+	constexpr float DIAGONAL = 0.70710678f;
+
+	const Vector2f DIRECTIONS[9] =
+	{
+		Vector2f(-DIAGONAL, -DIAGONAL), Vector2f(0.0f, -1.0f), Vector2f(DIAGONAL, -DIAGONAL),
+		Vector2f(-1.0f, 0.0f), Vector2f(1.0f, 0.0f),
+		Vector2f(-DIAGONAL, DIAGONAL), Vector2f(0.0f, 1.0f), Vector2f(DIAGONAL, DIAGONAL),
+		Vector2f(0.0f, 0.0f)
+	};
+
+	// Bits of SolveScratch::tiles.
+	constexpr uint8_t WALKABLE = 1;
+	constexpr uint8_t INSIDE = 2;
+
+	// Diagonal neighbour n needs the straight neighbours with these bits.
+	constexpr uint32_t CORNER_NEEDS[8] = { 0x0A, 0, 0x12, 0, 0, 0x48, 0, 0x50 };
+
+	// Scratch space for solveChunk, one set per thread.
+	// The chunk is copied with a 1 tile border taken from its neighbours,
+	// so the search never needs bounds checks and stays in cache.
+	struct SolveScratch
+	{
+		vector<uint8_t> tiles;
+		vector<uint32_t> distances;
+		vector<uint8_t> directions;
+		vector<pair<uint32_t, uint32_t>> seeds;
+		vector<uint32_t> buckets[8];
+	};
+
+	thread_local SolveScratch scratch;
+}
+
+FlowField::FlowField(const Matrix<uint8_t>& level, ThreadPool* pool)
+{
+	setLevel(level, pool);
+}
+
+void FlowField::setLevel(const Matrix<uint8_t>& level, ThreadPool* pool)
+{
+	level_ = &level;
+	pool_ = pool;
+	width_ = int32_t(level.colSize());
+	height_ = int32_t(level.rowSize());
+	chunks_x_ = (width_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunks_y_ = (height_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	const size_t tile_count = size_t(width_) * size_t(height_);
+	const size_t chunk_count = size_t(chunks_x_) * size_t(chunks_y_);
+
+	distances_.assign(tile_count, UNREACHABLE);
+	directions_.assign(tile_count, NO_DIRECTION);
+	priority_.assign(chunk_count, UNREACHABLE);
+	rescan_.assign(chunk_count, 0);
+	spill_.assign(chunk_count, 0);
+	spill_distance_.assign(chunk_count, UNREACHABLE);
+	touched_.assign(chunk_count, 0);
+	touched_list_.clear();
+	batch_.clear();
+	batch_.reserve(chunk_count);
+	active_count_ = 0;
+	target_.setAll(-1, -1);
+	needs_reset_ = true;
+}
+
+bool FlowField::walkable(int32_t x, int32_t y) const
+{
+	return !is_solid_at(*level_, x, y);
+}
+
+void FlowField::activate(int32_t chunk_x, int32_t chunk_y, uint32_t priority, bool rescan)
+{
+	if (chunk_x < 0 || chunk_y < 0 || chunk_x >= chunks_x_ || chunk_y >= chunks_y_)
+		return;
+
+	const size_t chunk = size_t(chunk_y) * size_t(chunks_x_) + size_t(chunk_x);
+
+	if (priority_[chunk] == UNREACHABLE)
+		++active_count_;
+
+	priority_[chunk] = std::min(priority_[chunk], priority);
+
+	if (rescan)
+		rescan_[chunk] = 1;
+}
+
+template <typename F> void FlowField::forEach(size_t count, const F& function)
+{
+	if (pool_ != nullptr)
+		pool_->parallelFor(count, function);
+	else
+	{
+		for (size_t i = 0; i < count; ++i)
+			function(i);
+	}
+}
+
+void FlowField::solveChunk(uint32_t chunk)
+{
+	const int32_t x0 = (int32_t(chunk) % chunks_x_) * CHUNK_SIZE;
+	const int32_t y0 = (int32_t(chunk) / chunks_x_) * CHUNK_SIZE;
+	const int32_t chunk_width = std::min(CHUNK_SIZE, width_ - x0);
+	const int32_t chunk_height = std::min(CHUNK_SIZE, height_ - y0);
+	const int32_t local_width = chunk_width + 2;
+	const int32_t local_height = chunk_height + 2;
+
+	vector<uint8_t>& tiles = scratch.tiles;
+	vector<uint32_t>& distances = scratch.distances;
+	vector<uint8_t>& directions = scratch.directions;
+	vector<pair<uint32_t, uint32_t>>& seeds = scratch.seeds;
+
+	tiles.resize(size_t(local_width) * size_t(local_height));
+	distances.resize(size_t(local_width) * size_t(local_height));
+	directions.resize(size_t(local_width) * size_t(local_height));
+	seeds.clear();
+
+	// Copy the chunk and its border. Local (1, 1) is the chunk's first tile.
+	const uint8_t* level_tiles = level_->data();
+
+	for (int32_t ly = 0; ly < local_height; ++ly)
+	{
+		const int32_t y = y0 + ly - 1;
+		const bool row_inside = ly > 0 && ly <= chunk_height;
+
+		for (int32_t lx = 0; lx < local_width; ++lx)
+		{
+			const int32_t x = x0 + lx - 1;
+			const size_t local = size_t(ly) * size_t(local_width) + size_t(lx);
+			const bool inside = row_inside && lx > 0 && lx <= chunk_width;
+			const size_t tile = size_t(y) * size_t(width_) + size_t(x);
+
+			// Only the border can fall outside of the level.
+			if (inside ? !is_solid(level_tiles[tile]) : walkable(x, y))
+			{
+				tiles[local] = WALKABLE | (inside ? INSIDE : 0);
+				distances[local] = distances_[tile];
+			}
+			else
+			{
+				tiles[local] = 0;
+				distances[local] = UNREACHABLE;
+			}
+		}
+	}
+
+	int32_t offsets[8];
+
+	for (int32_t n = 0; n < 8; ++n)
+		offsets[n] = NEIGHBOUR_DY[n] * local_width + NEIGHBOUR_DX[n];
+
+	// Returns bit n set for every neighbour n with all of the given tile bits.
+	const auto neighbours_with = [&](size_t local, uint8_t bits)
+	{
+		uint32_t result = 0;
+
+		for (int32_t n = 0; n < 8; ++n)
+		{
+			if ((tiles[size_t(int32_t(local) + offsets[n])] & bits) == bits)
+				result |= 1u << n;
+		}
+
+		return result;
+	};
+
+	// Returns the lowest distance to the given tile through its neighbours,
+	// and the neighbour it goes through.
+	const auto best_through_neighbours = [&](size_t local)
+	{
+		const uint32_t open = neighbours_with(local, WALKABLE);
+		pair<uint32_t, uint8_t> best(UNREACHABLE, NO_DIRECTION);
+
+		for (int32_t n = 0; n < 8; ++n)
+		{
+			if (!(open & (1u << n)) || (open & CORNER_NEEDS[n]) != CORNER_NEEDS[n])
+				continue;
+
+			const uint32_t distance = distances[size_t(int32_t(local) + offsets[n])];
+
+			if (distance == UNREACHABLE)
+				continue;
+
+			const uint32_t through = distance + (CORNER_NEEDS[n] != 0 ? DIAGONAL_COST : STRAIGHT_COST);
+
+			if (through < best.first)
+				best = pair<uint32_t, uint8_t>(through, uint8_t(n));
+		}
+
+		return best;
+	};
+
+	// With rescan, every tile may have a new way in, such as a tile that
+	// opened up. Otherwise only the border can be reached from outside.
+	const bool rescan = rescan_[chunk] != 0;
+	rescan_[chunk] = 0;
+
+	for (int32_t ly = 1; ly <= chunk_height; ++ly)
+	{
+		const bool edge_row = ly == 1 || ly == chunk_height;
+		const int32_t step = (rescan || edge_row) ? 1 : std::max(chunk_width - 1, 1);
+
+		for (int32_t lx = 1; lx <= chunk_width; lx += step)
+		{
+			const size_t local = size_t(ly) * size_t(local_width) + size_t(lx);
+
+			if (!tiles[local])
+				continue;
+
+			const pair<uint32_t, uint8_t> best = best_through_neighbours(local);
+
+			if (best.first < distances[local] && best.first <= max_distance_)
+			{
+				distances[local] = best.first;
+				directions[local] = best.second;
+				seeds.emplace_back(best.first, uint32_t(local));
+			}
+			else if (rescan && distances[local] != UNREACHABLE)
+				seeds.emplace_back(distances[local], uint32_t(local));
+		}
+	}
+
+	if (seeds.empty())
+		return;
+
+	std::sort(seeds.begin(), seeds.end());
+
+	// Dijkstra with a bucket queue. Steps cost 5 or 7, so every queued
+	// distance is within 7 of the current one and 8 buckets suffice.
+	// Seeds join the queue once the current distance reaches them.
+	vector<uint32_t>* buckets = scratch.buckets;
+	size_t next_seed = 0;
+	size_t pending = 0;
+	uint32_t current = seeds[0].first;
+
+	while (next_seed < seeds.size() || pending != 0)
+	{
+		if (pending == 0)
+			current = std::max(current, seeds[next_seed].first);
+
+		while (next_seed < seeds.size() && seeds[next_seed].first == current)
+		{
+			if (distances[seeds[next_seed].second] == current)
+			{
+				buckets[current & 7].push_back(seeds[next_seed].second);
+				++pending;
+			}
+
+			++next_seed;
+		}
+
+		vector<uint32_t>& bucket = buckets[current & 7];
+
+		for (size_t b = 0; b < bucket.size(); ++b)
+		{
+			const uint32_t local = bucket[b];
+
+			if (distances[local] != current)
+				continue;
+
+			// The border copied from the neighbours is read but never written.
+			uint32_t walkable_neighbours = 0;
+			uint32_t inside_neighbours = 0;
+
+			for (int32_t n = 0; n < 8; ++n)
+			{
+				const uint8_t neighbour = tiles[size_t(int32_t(local) + offsets[n])];
+				walkable_neighbours |= uint32_t(neighbour & WALKABLE) << n;
+				inside_neighbours |= uint32_t(neighbour == (WALKABLE | INSIDE)) << n;
+			}
+
+			for (int32_t n = 0; n < 8; ++n)
+			{
+				if (!(inside_neighbours & (1u << n)) || (walkable_neighbours & CORNER_NEEDS[n]) != CORNER_NEEDS[n])
+					continue;
+
+				const uint32_t next = uint32_t(int32_t(local) + offsets[n]);
+				const uint32_t distance = current + (CORNER_NEEDS[n] != 0 ? DIAGONAL_COST : STRAIGHT_COST);
+
+				if (distance < distances[next] && distance <= max_distance_)
+				{
+					distances[next] = distance;
+					directions[next] = uint8_t(7 - n);
+					buckets[distance & 7].push_back(next);
+					++pending;
+				}
+			}
+		}
+
+		pending -= bucket.size();
+		bucket.clear();
+		++current;
+	}
+
+	// Copy back what went down, noting which neighbours are affected.
+	uint8_t spill = 0;
+	uint32_t spill_distance = UNREACHABLE;
+
+	for (int32_t ly = 1; ly <= chunk_height; ++ly)
+	{
+		const size_t first = size_t(y0 + ly - 1) * size_t(width_) + size_t(x0);
+		const size_t local_first = size_t(ly) * size_t(local_width) + 1;
+
+		for (int32_t lx = 0; lx < chunk_width; ++lx)
+		{
+			const uint32_t distance = distances[local_first + size_t(lx)];
+
+			if (distance >= distances_[first + size_t(lx)])
+				continue;
+
+			distances_[first + size_t(lx)] = distance;
+			directions_[first + size_t(lx)] = directions[local_first + size_t(lx)];
+
+			const bool left = lx == 0;
+			const bool right = lx == chunk_width - 1;
+			const bool top = ly == 1;
+			const bool bottom = ly == chunk_height;
+
+			if (left || right || top || bottom)
+			{
+				spill |= uint8_t((top && left) << 0 | top << 1 | (top && right) << 2 | left << 3 |
+				                 right << 4 | (bottom && left) << 5 | bottom << 6 | (bottom && right) << 7);
+				spill_distance = std::min(spill_distance, distance);
+			}
+		}
+	}
+
+	spill_[chunk] = spill;
+	spill_distance_[chunk] = spill_distance;
+}
+
+void FlowField::solve()
+{
+	const uint32_t chunk_count = uint32_t(priority_.size());
+	chunks_solved_ = 0;
+
+	while (active_count_ != 0)
+	{
+		uint32_t lowest = UNREACHABLE;
+
+		for (uint32_t chunk = 0; chunk < chunk_count; ++chunk)
+			lowest = std::min(lowest, priority_[chunk]);
+
+		const uint32_t threshold = lowest + std::min(UNREACHABLE - 1 - lowest, uint32_t(CHUNK_SIZE) * STRAIGHT_COST);
+
+		for (int32_t group = 0; group < 4; ++group)
+		{
+			batch_.clear();
+
+			for (uint32_t chunk = 0; chunk < chunk_count; ++chunk)
+			{
+				const int32_t chunk_x = int32_t(chunk) % chunks_x_;
+				const int32_t chunk_y = int32_t(chunk) / chunks_x_;
+
+				if (priority_[chunk] <= threshold && ((chunk_x & 1) | ((chunk_y & 1) << 1)) == group)
+				{
+					priority_[chunk] = UNREACHABLE;
+					--active_count_;
+					batch_.push_back(chunk);
+				}
+			}
+
+			// No 2 chunks of a group touch, so each can read its
+			// neighbours while the others are being solved.
+			forEach(batch_.size(), [&](size_t i) { solveChunk(batch_[i]); });
+			chunks_solved_ += batch_.size();
+
+			for (uint32_t chunk : batch_)
+			{
+				const int32_t chunk_x = int32_t(chunk) % chunks_x_;
+				const int32_t chunk_y = int32_t(chunk) / chunks_x_;
+
+				for (int32_t n = 0; n < 8; ++n)
+				{
+					if (spill_[chunk] & (1u << n))
+						activate(chunk_x + NEIGHBOUR_DX[n], chunk_y + NEIGHBOUR_DY[n], spill_distance_[chunk], false);
+				}
+
+				spill_[chunk] = 0;
+
+				if (!touched_[chunk])
+				{
+					touched_[chunk] = 1;
+					touched_list_.push_back(chunk);
+				}
+			}
+		}
+	}
+}
+
+void FlowField::reset()
+{
+	needs_reset_ = false;
+
+	std::fill(priority_.begin(), priority_.end(), UNREACHABLE);
+	std::fill(rescan_.begin(), rescan_.end(), 0);
+	std::fill(spill_.begin(), spill_.end(), 0);
+	active_count_ = 0;
+
+	// Only chunks solved since the last reset can hold distances.
+	forEach(touched_list_.size(), [&](size_t i)
+	{
+		const uint32_t chunk = touched_list_[i];
+		const int32_t x0 = (int32_t(chunk) % chunks_x_) * CHUNK_SIZE;
+		const int32_t y0 = (int32_t(chunk) / chunks_x_) * CHUNK_SIZE;
+		const int32_t x1 = std::min(x0 + CHUNK_SIZE, width_);
+		const int32_t y1 = std::min(y0 + CHUNK_SIZE, height_);
+
+		for (int32_t y = y0; y < y1; ++y)
+		{
+			const size_t first = size_t(y) * size_t(width_) + size_t(x0);
+
+			std::fill(distances_.begin() + first, distances_.begin() + first + size_t(x1 - x0), UNREACHABLE);
+			std::fill(directions_.begin() + first, directions_.begin() + first + size_t(x1 - x0), NO_DIRECTION);
+		}
+
+		touched_[chunk] = 0;
+	});
+
+	touched_list_.clear();
+
+	if (walkable(target_.x, target_.y))
+		seedTarget();
+
+	solve();
+}
+
+void FlowField::seedTarget()
+{
+	const size_t target = size_t(target_.y) * size_t(width_) + size_t(target_.x);
+	distances_[target] = 0;
+	directions_[target] = NO_DIRECTION;
+
+	// solveChunk never lowers the target itself, so the chunks its
+	// neighbours are in are queued here rather than through spill_.
+	for (int32_t dy = -1; dy <= 1; ++dy)
+	{
+		for (int32_t dx = -1; dx <= 1; ++dx)
+		{
+			const int32_t nx = target_.x + dx;
+			const int32_t ny = target_.y + dy;
+
+			if (nx >= 0 && ny >= 0 && nx < width_ && ny < height_)
+				activate(nx / CHUNK_SIZE, ny / CHUNK_SIZE, 0, dx == 0 && dy == 0);
+		}
+	}
+}
+
+bool FlowField::retarget(const Point2i& previous)
+{
+	// Limited fields are small enough to start over, and lose the tiles
+	// past the limit, which this could not bring back.
+	if (max_distance_ != UNREACHABLE - 1 || !walkable(target_.x, target_.y))
+		return false;
+
+	const size_t target = size_t(target_.y) * size_t(width_) + size_t(target_.x);
+	const uint32_t offset = distances_[target];
+
+	// No path is longer than a diagonal step per tile, so below this
+	// size adding offset to a distance cannot overflow.
+	if (offset == UNREACHABLE || uint64_t(distances_.size()) * DIAGONAL_COST * 2 >= UNREACHABLE)
+		return false;
+
+	// Going through the old target is one way to the new one, so every
+	// distance plus offset is an upper bound, and tiles that keep it
+	// keep a direction that is still as short as any.
+	forEach(touched_list_.size(), [&](size_t i)
+	{
+		const uint32_t chunk = touched_list_[i];
+		const int32_t x0 = (int32_t(chunk) % chunks_x_) * CHUNK_SIZE;
+		const int32_t y0 = (int32_t(chunk) / chunks_x_) * CHUNK_SIZE;
+		const int32_t x1 = std::min(x0 + CHUNK_SIZE, width_);
+		const int32_t y1 = std::min(y0 + CHUNK_SIZE, height_);
+
+		for (int32_t y = y0; y < y1; ++y)
+		{
+			uint32_t* const row = distances_.data() + size_t(y) * size_t(width_);
+
+			for (int32_t x = x0; x < x1; ++x)
+			{
+				if (row[x] != UNREACHABLE)
+					row[x] += offset;
+			}
+		}
+	});
+
+	// The old target has no direction, and finds one from its neighbours.
+	const size_t old_target = size_t(previous.y) * size_t(width_) + size_t(previous.x);
+	distances_[old_target] = UNREACHABLE;
+	directions_[old_target] = NO_DIRECTION;
+	activate(previous.x / CHUNK_SIZE, previous.y / CHUNK_SIZE, offset, true);
+
+	seedTarget();
+	solve();
+
+	return true;
+}
+
+bool FlowField::update(const Point2f& target)
+{
+	if (level_ == nullptr)
+		return false;
+
+	const Point2i tile(int32_t(std::floor(target.x)), int32_t(std::floor(target.y)));
+
+	if (tile != target_)
+	{
+		const Point2i previous = target_;
+		target_ = tile;
+
+		if (!needs_reset_ && retarget(previous))
+			return true;
+
+		needs_reset_ = true;
+	}
+
+	if (needs_reset_)
+	{
+		reset();
+		return true;
+	}
+
+	if (active_count_ != 0)
+	{
+		solve();
+		return true;
+	}
+
+	return false;
+}
+
+void FlowField::setMaxDistance(float distance)
+{
+	if (distance < 0.0f || distance * float(STRAIGHT_COST) >= float(UNREACHABLE - 1))
+		max_distance_ = UNREACHABLE - 1;
+	else
+		max_distance_ = uint32_t(distance * float(STRAIGHT_COST));
+
+	needs_reset_ = true;
+}
+
+void FlowField::tileChanged(int32_t x, int32_t y)
+{
+	if (level_ == nullptr || x < 0 || y < 0 || x >= width_ || y >= height_)
+		return;
+
+	if (!walkable(x, y))
+	{
+		// Distances only ever go down while solving, so a new wall
+		// can only be handled by starting over.
+		needs_reset_ = true;
+		return;
+	}
+
+	// An open tile can also unblock diagonal moves between the tiles
+	// around it, which may be in the chunks next to it.
+	for (int32_t dy = -1; dy <= 1; ++dy)
+	{
+		for (int32_t dx = -1; dx <= 1; ++dx)
+		{
+			const int32_t nx = x + dx;
+			const int32_t ny = y + dy;
+
+			if (nx >= 0 && ny >= 0 && nx < width_ && ny < height_)
+				activate(nx / CHUNK_SIZE, ny / CHUNK_SIZE, 0, true);
+		}
+	}
+}
+
+Vector2f FlowField::direction(const Point2f& position) const
+{
+	return direction(int32_t(std::floor(position.x)), int32_t(std::floor(position.y)));
+}
+
+Vector2f FlowField::direction(int32_t x, int32_t y) const
+{
+	if (x < 0 || y < 0 || x >= width_ || y >= height_)
+		return DIRECTIONS[NO_DIRECTION];
+
+	return DIRECTIONS[directions_[size_t(y) * size_t(width_) + size_t(x)]];
+}
+
+float FlowField::distance(int32_t x, int32_t y) const
+{
+	if (x < 0 || y < 0 || x >= width_ || y >= height_)
+		return std::numeric_limits<float>::infinity();
+
+	const uint32_t distance = distances_[size_t(y) * size_t(width_) + size_t(x)];
+
+	if (distance == UNREACHABLE)
+		return std::numeric_limits<float>::infinity();
+
+	return float(distance) / float(STRAIGHT_COST);
+}
+
+size_t FlowField::lastSolvedChunkCount() const
+{
+	return chunks_solved_;
+}
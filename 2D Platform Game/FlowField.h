@@ -0,0 +1,166 @@
+// 2D Platform Game
+// FlowField.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the FlowField class.
+
+#ifndef FLOWFIELD_H_INCLUDED
+#define FLOWFIELD_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/ThreadPool.h"
+#include "Jlib/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distance and direction to a single target from every tile of the level,
+// so any amount of agents can chase the target by looking up their tile.
+// Movement follows the same rules as GridPathfinder: 8 directions
+// without cutting corners.
+// The level is split into chunks of CHUNK_SIZE by CHUNK_SIZE tiles.
+// A chunk whose border distances drop queues its neighbours, until no
+// distance changes. Queued chunks are solved roughly in order of
+// distance: each round takes the ones that can be entered within one
+// chunk width of the closest queued distance, so few chunks are solved
+// twice. A round is split into 4 alternating groups, where no 2 chunks
+// in a group touch, and each group is solved in parallel.
+class FlowField
+{
+	public:
+
+	static constexpr std::int32_t CHUNK_SIZE = 64;
+
+	private:
+
+	// Distances are stored in fifths of a tile, so a diagonal step
+	// costs 7 instead of 7.07.
+	static constexpr std::uint32_t STRAIGHT_COST = 5;
+	static constexpr std::uint32_t DIAGONAL_COST = 7;
+	static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFF;
+	static constexpr std::uint8_t NO_DIRECTION = 8;
+
+	const Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	Jlib::ThreadPool* pool_ = nullptr;
+	std::int32_t width_ = 0;
+	std::int32_t height_ = 0;
+	std::int32_t chunks_x_ = 0;
+	std::int32_t chunks_y_ = 0;
+	Jlib::Point2i target_;
+	std::uint32_t max_distance_ = UNREACHABLE - 1;
+	bool needs_reset_ = true;
+
+	// Per tile.
+	std::vector<std::uint32_t> distances_;
+	std::vector<std::uint8_t> directions_;
+
+	// Per chunk. A queued chunk has a priority below UNREACHABLE: the
+	// lowest distance entering it. Bit n of spill_ is set if solving the
+	// chunk lowered distances next to neighbour n, the lowest of which
+	// is spill_distance_. touched_list_ holds the chunks solved since the
+	// last reset, which are the only ones reset needs to clear.
+	std::vector<std::uint32_t> priority_;
+	std::vector<std::uint8_t> rescan_;
+	std::vector<std::uint8_t> spill_;
+	std::vector<std::uint32_t> spill_distance_;
+	std::vector<std::uint8_t> touched_;
+	std::vector<std::uint32_t> touched_list_;
+	std::vector<std::uint32_t> batch_;
+	std::size_t active_count_ = 0;
+	std::size_t chunks_solved_ = 0;
+
+	// Returns true if the tile at (x, y) can be moved through.
+	bool walkable(std::int32_t x, std::int32_t y) const;
+
+	// Queues the given chunk to be solved.
+	// If rescan is true, every tile of the chunk is checked for a shorter
+	// way in instead of only its border.
+	void activate(std::int32_t chunk_x, std::int32_t chunk_y, std::uint32_t priority, bool rescan);
+
+	// Lowers the distances of the given chunk until they agree with
+	// its neighbours and with each other. Every tile that gets closer
+	// is pointed at the neighbour it got closer through.
+	void solveChunk(std::uint32_t chunk);
+
+	// Calls function(i) for every i in [0, count), in parallel if there is a ThreadPool.
+	template <typename F> void forEach(std::size_t count, const F& function);
+
+	// Solves queued chunks until no distance changes.
+	void solve();
+
+	// Clears the distances of every solved chunk and solves from the target.
+	void reset();
+
+	// Sets the distance of the target to 0 and queues the chunks around it.
+	void seedTarget();
+
+	// Moves the solved distances from the previous target to target_
+	// and lowers the ones the move brings closer.
+	// Returns false, changing nothing, if the FlowField has to be reset
+	// instead.
+	bool retarget(const Jlib::Point2i& previous);
+
+	public:
+
+	// Default constructor.
+	FlowField() = default;
+
+	// Level constructor.
+	// Sets the level layout and the ThreadPool used by the FlowField.
+	// Without a ThreadPool, chunks are solved on the calling thread.
+	FlowField(const Jlib::Matrix<std::uint8_t>& level, Jlib::ThreadPool* pool = nullptr);
+
+	// Sets the level layout and the ThreadPool used by the FlowField.
+	// The level must outlive the FlowField or the next call to setLevel.
+	void setLevel(const Jlib::Matrix<std::uint8_t>& level, Jlib::ThreadPool* pool = nullptr);
+
+	// Moves the target to the tile containing the given position
+	// and brings the FlowField up to date.
+	// Nothing is recomputed while the target stays on the same tile
+	// and no tile has changed.
+	// A target moving to a tile the FlowField reached reuses it: only
+	// the tiles the move brings closer are solved again. Those are
+	// still about half of the level, so on a large level a move costs
+	// three quarters of starting over, far more than a frame. Limit
+	// the FlowField with setMaxDistance so a move only costs the area
+	// around the target; limited FlowFields start over on every move.
+	// Returns true if anything was recomputed.
+	bool update(const Jlib::Point2f& target);
+
+	// Limits the FlowField to tiles within the given distance of the
+	// target, in tiles. Tiles further away are treated as unreachable,
+	// and chunks beyond the limit are never solved, so an update only
+	// costs as much as the area around the target.
+	// A negative distance removes the limit, which is the default.
+	void setMaxDistance(float distance);
+
+	// Tells the FlowField the tile at (x, y) has changed.
+	// A tile that opened up is handled incrementally by the next update:
+	// only the chunks it brings closer to the target are solved again.
+	// A tile that became solid makes the next update start over.
+	void tileChanged(std::int32_t x, std::int32_t y);
+
+	// Returns the unit vector pointing from the tile containing the
+	// given position to the next tile on the way to the target.
+	// Returns the zero vector on the target tile and on tiles that
+	// cannot reach it.
+	Jlib::Vector2f direction(const Jlib::Point2f& position) const;
+
+	// Returns the unit vector pointing from the tile at (x, y)
+	// to the next tile on the way to the target.
+	// Returns the zero vector on the target tile and on tiles that
+	// cannot reach it.
+	Jlib::Vector2f direction(std::int32_t x, std::int32_t y) const;
+
+	// Returns the distance from the tile at (x, y) to the target, in tiles.
+	// Returns infinity if the tile cannot reach the target.
+	float distance(std::int32_t x, std::int32_t y) const;
+
+	// Returns the amount of chunks solved by the last update.
+	std::size_t lastSolvedChunkCount() const;
+};
+
+#endif // FLOWFIELD_H_INCLUDED
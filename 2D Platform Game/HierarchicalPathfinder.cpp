@@ -0,0 +1,595 @@
+// 2D Platform Game
+// HierarchicalPathfinder.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the HierarchicalPathfinder class.
+
+#include "HierarchicalPathfinder.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2i;
+
+// <chrono>
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// <stdexcept>
+using std::invalid_argument;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr float INFINITE_COST = std::numeric_limits<float>::infinity();
+	constexpr float DIAGONAL_COST = 1.41421356f;
+	constexpr float DIAGONAL_EXTRA = 0.41421356f; // sqrt(2) - 1
+
+	// Returns the cost of the shortest 8-directional move between 2 tiles.
+	float octile(const Point2i& A, const Point2i& B)
+	{
+		const float dx = float(std::abs(B.x - A.x));
+		const float dy = float(std::abs(B.y - A.y));
+
+		return std::max(dx, dy) + DIAGONAL_EXTRA * std::min(dx, dy);
+	}
+}
+
+double PathCacheStats::hitRate() const
+{
+	if (lookups == 0)
+		return 0.0;
+
+	return double(hits) / double(lookups);
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(Matrix<uint8_t>& level, int32_t chunk_size)
+{
+	setLevel(level, chunk_size);
+}
+
+void HierarchicalPathfinder::setLevel(Matrix<uint8_t>& level, int32_t chunk_size)
+{
+	if (chunk_size < 2)
+		throw invalid_argument("ERROR: Chunk size must be at least 2.");
+
+	level_ = &level;
+	width_ = int32_t(level.colSize());
+	height_ = int32_t(level.rowSize());
+	chunk_size_ = chunk_size;
+	chunks_x_ = (width_ + chunk_size - 1) / chunk_size;
+	chunks_y_ = (height_ + chunk_size - 1) / chunk_size;
+
+	chunks_.assign(size_t(chunks_x_) * size_t(chunks_y_), Chunk());
+	local_open_tiles_.assign(size_t(chunk_size) * size_t(chunk_size), 0);
+	local_cost_.assign(size_t(chunk_size) * size_t(chunk_size), INFINITE_COST);
+	invalidateAll();
+	rebuild();
+}
+
+void HierarchicalPathfinder::setHeuristicWeight(float weight)
+{
+	if (weight < 1.0f)
+		throw invalid_argument("ERROR: Heuristic weight must be at least 1.");
+
+	heuristic_weight_ = weight;
+}
+
+uint32_t HierarchicalPathfinder::chunkAt(int32_t x, int32_t y) const
+{
+	return uint32_t((y / chunk_size_) * chunks_x_ + x / chunk_size_);
+}
+
+void HierarchicalPathfinder::markDirty(int32_t chunk_x, int32_t chunk_y)
+{
+	if (chunk_x < 0 || chunk_y < 0 || chunk_x >= chunks_x_ || chunk_y >= chunks_y_)
+		return;
+
+	const uint32_t chunk = uint32_t(chunk_y * chunks_x_ + chunk_x);
+
+	if (!chunks_[chunk].dirty)
+	{
+		chunks_[chunk].dirty = true;
+		dirty_chunks_.push_back(chunk);
+	}
+}
+
+void HierarchicalPathfinder::setTile(int32_t x, int32_t y, uint8_t tile)
+{
+	level_->set(size_t(y), size_t(x), tile);
+	invalidate(x, y);
+}
+
+void HierarchicalPathfinder::invalidate(int32_t x, int32_t y)
+{
+	if (x < 0 || y < 0 || x >= width_ || y >= height_)
+		return;
+
+	const int32_t chunk_x = x / chunk_size_;
+	const int32_t chunk_y = y / chunk_size_;
+	const int32_t local_x = x - chunk_x * chunk_size_;
+	const int32_t local_y = y - chunk_y * chunk_size_;
+
+	markDirty(chunk_x, chunk_y);
+
+	// A tile on the border of its chunk also decides the entrances
+	// of the chunk on the other side.
+	if (local_x == 0)
+		markDirty(chunk_x - 1, chunk_y);
+	if (local_x == chunk_size_ - 1)
+		markDirty(chunk_x + 1, chunk_y);
+	if (local_y == 0)
+		markDirty(chunk_x, chunk_y - 1);
+	if (local_y == chunk_size_ - 1)
+		markDirty(chunk_x, chunk_y + 1);
+}
+
+void HierarchicalPathfinder::invalidateAll()
+{
+	dirty_chunks_.clear();
+
+	for (uint32_t c = 0; c < chunks_.size(); ++c)
+	{
+		chunks_[c].dirty = true;
+		dirty_chunks_.push_back(c);
+	}
+}
+
+void HierarchicalPathfinder::findEntrances(uint32_t chunk)
+{
+	vector<Entrance>& entrances = chunks_[chunk].entrances;
+	entrances.clear();
+
+	const int32_t chunk_x = int32_t(chunk) % chunks_x_;
+	const int32_t chunk_y = int32_t(chunk) / chunks_x_;
+	const int32_t x0 = chunk_x * chunk_size_;
+	const int32_t y0 = chunk_y * chunk_size_;
+	const int32_t x1 = std::min(x0 + chunk_size_, width_) - 1;
+	const int32_t y1 = std::min(y0 + chunk_size_, height_) - 1;
+
+	// Walks along one side of the chunk, adding an entrance in the middle
+	// of every run of tiles that are open on both sides of the border.
+	// Both chunks sharing a border find the same runs, so their
+	// entrances always come in matching pairs.
+	const auto scan = [&](uint8_t side, Point2i first, int32_t length, Point2i step, Point2i across)
+	{
+		int32_t run_start = -1;
+
+		for (int32_t i = 0; i <= length; ++i)
+		{
+			const Point2i tile(first.x + step.x * i, first.y + step.y * i);
+			const bool open = i < length &&
+			                  !is_solid_at(*level_, tile.x, tile.y) &&
+			                  !is_solid_at(*level_, tile.x + across.x, tile.y + across.y);
+
+			if (open && run_start < 0)
+				run_start = i;
+			else if (!open && run_start >= 0)
+			{
+				const int32_t middle = (run_start + i - 1) / 2;
+				entrances.push_back(Entrance{ Point2i(first.x + step.x * middle, first.y + step.y * middle), side });
+				run_start = -1;
+			}
+		}
+	};
+
+	if (chunk_x > 0)
+		scan(0, Point2i(x0, y0), y1 - y0 + 1, Point2i(0, 1), Point2i(-1, 0));
+	if (chunk_x < chunks_x_ - 1)
+		scan(1, Point2i(x1, y0), y1 - y0 + 1, Point2i(0, 1), Point2i(1, 0));
+	if (chunk_y > 0)
+		scan(2, Point2i(x0, y0), x1 - x0 + 1, Point2i(1, 0), Point2i(0, -1));
+	if (chunk_y < chunks_y_ - 1)
+		scan(3, Point2i(x0, y1), x1 - x0 + 1, Point2i(1, 0), Point2i(0, 1));
+}
+
+void HierarchicalPathfinder::linkEntrances(uint32_t chunk)
+{
+	static constexpr int32_t SIDE_DX[4] = { -1, 1, 0, 0 };
+	static constexpr int32_t SIDE_DY[4] = { 0, 0, -1, 1 };
+	static constexpr uint8_t OPPOSITE_SIDE[4] = { 1, 0, 3, 2 };
+
+	for (Entrance& entrance : chunks_[chunk].entrances)
+	{
+		const Point2i across(entrance.tile.x + SIDE_DX[entrance.side], entrance.tile.y + SIDE_DY[entrance.side]);
+		const vector<Entrance>& others = chunks_[chunkAt(across.x, across.y)].entrances;
+
+		entrance.partner = NONE;
+
+		for (uint32_t i = 0; i < others.size(); ++i)
+		{
+			if (others[i].side == OPPOSITE_SIDE[entrance.side] && others[i].tile == across)
+			{
+				entrance.partner = i;
+				break;
+			}
+		}
+	}
+}
+
+void HierarchicalPathfinder::loadChunk(uint32_t chunk)
+{
+	const int32_t x0 = (int32_t(chunk) % chunks_x_) * chunk_size_;
+	const int32_t y0 = (int32_t(chunk) / chunks_x_) * chunk_size_;
+
+	// Tiles past the edge of the level are left closed.
+	for (int32_t y = 0; y < chunk_size_; ++y)
+	{
+		for (int32_t x = 0; x < chunk_size_; ++x)
+			local_open_tiles_[size_t(y * chunk_size_ + x)] = !is_solid_at(*level_, x0 + x, y0 + y);
+	}
+}
+
+void HierarchicalPathfinder::searchChunk(uint32_t chunk, const Point2i& from)
+{
+	const int32_t x0 = (int32_t(chunk) % chunks_x_) * chunk_size_;
+	const int32_t y0 = (int32_t(chunk) / chunks_x_) * chunk_size_;
+
+	std::fill(local_cost_.begin(), local_cost_.end(), INFINITE_COST);
+	local_open_.clear();
+
+	// Takes local coordinates.
+	const auto open = [&](int32_t x, int32_t y)
+	{
+		return x >= 0 && y >= 0 && x < chunk_size_ && y < chunk_size_ && local_open_tiles_[size_t(y * chunk_size_ + x)];
+	};
+
+	const uint32_t first = uint32_t((from.y - y0) * chunk_size_ + (from.x - x0));
+	local_cost_[first] = 0.0f;
+	local_open_.push(0.0f, first);
+
+	while (!local_open_.empty())
+	{
+		const OpenSet::Entry entry = local_open_.pop();
+
+		if (entry.cost > local_cost_[entry.node])
+			continue;
+
+		const int32_t x = int32_t(entry.node) % chunk_size_;
+		const int32_t y = int32_t(entry.node) / chunk_size_;
+
+		for (int32_t dy = -1; dy <= 1; ++dy)
+		{
+			for (int32_t dx = -1; dx <= 1; ++dx)
+			{
+				if ((dx == 0 && dy == 0) || !open(x + dx, y + dy))
+					continue;
+
+				float step = 1.0f;
+
+				if (dx != 0 && dy != 0)
+				{
+					if (!open(x + dx, y) || !open(x, y + dy))
+						continue;
+
+					step = DIAGONAL_COST;
+				}
+
+				const uint32_t next = uint32_t((y + dy) * chunk_size_ + (x + dx));
+				const float new_cost = entry.cost + step;
+
+				if (new_cost < local_cost_[next])
+				{
+					local_cost_[next] = new_cost;
+					local_open_.push(new_cost, next);
+				}
+			}
+		}
+	}
+}
+
+float HierarchicalPathfinder::localCost(uint32_t chunk, const Point2i& tile) const
+{
+	const int32_t x0 = (int32_t(chunk) % chunks_x_) * chunk_size_;
+	const int32_t y0 = (int32_t(chunk) / chunks_x_) * chunk_size_;
+
+	return local_cost_[size_t((tile.y - y0) * chunk_size_ + (tile.x - x0))];
+}
+
+void HierarchicalPathfinder::computeCosts(uint32_t chunk)
+{
+	const steady_clock::time_point start = steady_clock::now();
+
+	Chunk& c = chunks_[chunk];
+	const size_t count = c.entrances.size();
+
+	c.costs.assign(count * count, INFINITE_COST);
+	loadChunk(chunk);
+
+	// Moves cost the same in both directions, so each search fills
+	// a row and a column, and the last entrance needs no search.
+	for (size_t i = 0; i + 1 < count; ++i)
+	{
+		searchChunk(chunk, c.entrances[i].tile);
+
+		for (size_t j = i; j < count; ++j)
+		{
+			const float cost = localCost(chunk, c.entrances[j].tile);
+			c.costs[i * count + j] = cost;
+			c.costs[j * count + i] = cost;
+		}
+	}
+
+	if (count != 0)
+		c.costs[count * count - 1] = 0.0f;
+
+	c.costs_ready = true;
+	++stats_.chunk_rebuilds;
+	stats_.rebuild_milliseconds += duration<double>(steady_clock::now() - start).count() * 1000.0;
+}
+
+const vector<float>& HierarchicalPathfinder::costsOf(uint32_t chunk)
+{
+	++stats_.lookups;
+
+	if (chunks_[chunk].costs_ready)
+		++stats_.hits;
+	else
+		computeCosts(chunk);
+
+	return chunks_[chunk].costs;
+}
+
+void HierarchicalPathfinder::precompute()
+{
+	rebuild();
+
+	for (uint32_t chunk = 0; chunk < chunks_.size(); ++chunk)
+	{
+		if (!chunks_[chunk].costs_ready)
+			computeCosts(chunk);
+	}
+}
+
+void HierarchicalPathfinder::rebuild()
+{
+	if (dirty_chunks_.empty())
+		return;
+
+	const steady_clock::time_point start = steady_clock::now();
+
+	for (uint32_t chunk : dirty_chunks_)
+		findEntrances(chunk);
+
+	// The entrances of a dirty chunk may have moved, so the chunks
+	// around it have to find their partners again.
+	for (uint32_t chunk : dirty_chunks_)
+	{
+		const int32_t chunk_x = int32_t(chunk) % chunks_x_;
+		const int32_t chunk_y = int32_t(chunk) / chunks_x_;
+
+		linkEntrances(chunk);
+
+		if (chunk_x > 0 && !chunks_[chunk - 1].dirty)
+			linkEntrances(chunk - 1);
+		if (chunk_x < chunks_x_ - 1 && !chunks_[chunk + 1].dirty)
+			linkEntrances(chunk + 1);
+		if (chunk_y > 0 && !chunks_[chunk - chunks_x_].dirty)
+			linkEntrances(chunk - chunks_x_);
+		if (chunk_y < chunks_y_ - 1 && !chunks_[chunk + chunks_x_].dirty)
+			linkEntrances(chunk + chunks_x_);
+	}
+
+	for (uint32_t chunk : dirty_chunks_)
+	{
+		chunks_[chunk].dirty = false;
+		chunks_[chunk].costs_ready = false;
+	}
+
+	dirty_chunks_.clear();
+
+	node_offsets_.resize(chunks_.size() + 1);
+	node_offsets_[0] = 0;
+
+	for (size_t c = 0; c < chunks_.size(); ++c)
+		node_offsets_[c + 1] = node_offsets_[c] + uint32_t(chunks_[c].entrances.size());
+
+	// One extra node stands for the goal during a search.
+	const size_t node_count = size_t(node_offsets_.back()) + 1;
+
+	if (cost_.size() < node_count)
+	{
+		cost_.resize(node_count);
+		parent_.resize(node_count);
+		node_chunk_.resize(node_count);
+		visited_.resize(node_count, 0);
+		closed_.resize(node_count, 0);
+	}
+
+	stats_.rebuild_milliseconds += duration<double>(steady_clock::now() - start).count() * 1000.0;
+}
+
+bool HierarchicalPathfinder::findPath(const Point2i& start, const Point2i& goal, vector<Point2i>& path)
+{
+	path.clear();
+
+	if (level_ == nullptr)
+		return false;
+
+	++stats_.queries;
+	rebuild();
+
+	if (is_solid_at(*level_, start.x, start.y) || is_solid_at(*level_, goal.x, goal.y))
+		return false;
+
+	const uint32_t start_chunk = chunkAt(start.x, start.y);
+	const uint32_t goal_chunk = chunkAt(goal.x, goal.y);
+
+	loadChunk(start_chunk);
+	searchChunk(start_chunk, start);
+
+	if (start_chunk == goal_chunk && localCost(start_chunk, goal) != INFINITE_COST)
+	{
+		path.push_back(start);
+		path.push_back(goal);
+		return true;
+	}
+
+	const vector<Entrance>& start_entrances = chunks_[start_chunk].entrances;
+	bool start_leaves = false;
+	start_costs_.resize(start_entrances.size());
+
+	for (size_t i = 0; i < start_entrances.size(); ++i)
+	{
+		start_costs_[i] = localCost(start_chunk, start_entrances[i].tile);
+		start_leaves |= start_costs_[i] != INFINITE_COST;
+	}
+
+	loadChunk(goal_chunk);
+	searchChunk(goal_chunk, goal);
+
+	const vector<Entrance>& goal_entrances = chunks_[goal_chunk].entrances;
+	bool goal_leaves = false;
+	goal_costs_.resize(goal_entrances.size());
+
+	for (size_t i = 0; i < goal_entrances.size(); ++i)
+	{
+		goal_costs_[i] = localCost(goal_chunk, goal_entrances[i].tile);
+		goal_leaves |= goal_costs_[i] != INFINITE_COST;
+	}
+
+	// Without this, a start or goal walled in within its chunk
+	// would make the search visit every reachable entrance.
+	if (!start_leaves || !goal_leaves)
+		return false;
+
+	// Search ids mark which entries of the search state belong to
+	// this search, so nothing has to be cleared between queries.
+	if (++search_id_ == 0)
+	{
+		std::fill(visited_.begin(), visited_.end(), 0);
+		std::fill(closed_.begin(), closed_.end(), 0);
+		search_id_ = 1;
+	}
+
+	const uint32_t goal_node = node_offsets_.back();
+
+	const auto tile_of = [&](uint32_t node) -> const Point2i&
+	{
+		const uint32_t chunk = node_chunk_[node];
+		return chunks_[chunk].entrances[node - node_offsets_[chunk]].tile;
+	};
+
+	const auto relax = [&](uint32_t node, uint32_t chunk, const Point2i& tile, uint32_t parent, float new_cost)
+	{
+		if (visited_[node] != search_id_ || new_cost < cost_[node])
+		{
+			visited_[node] = search_id_;
+			cost_[node] = new_cost;
+			parent_[node] = parent;
+			node_chunk_[node] = chunk;
+			open_.push(new_cost + octile(tile, goal) * heuristic_weight_, node);
+		}
+	};
+
+	open_.clear();
+
+	for (size_t i = 0; i < start_entrances.size(); ++i)
+	{
+		if (start_costs_[i] != INFINITE_COST)
+			relax(node_offsets_[start_chunk] + uint32_t(i), start_chunk, start_entrances[i].tile, NONE, start_costs_[i]);
+	}
+
+	while (!open_.empty())
+	{
+		const uint32_t node = open_.pop().node;
+
+		if (closed_[node] == search_id_)
+			continue;
+
+		closed_[node] = search_id_;
+
+		if (node == goal_node)
+		{
+			path.push_back(goal);
+
+			for (uint32_t n = parent_[node]; n != NONE; n = parent_[n])
+			{
+				if (tile_of(n) != path.back())
+					path.push_back(tile_of(n));
+			}
+
+			if (start != path.back())
+				path.push_back(start);
+
+			std::reverse(path.begin(), path.end());
+			return true;
+		}
+
+		const uint32_t chunk = node_chunk_[node];
+		const uint32_t local = node - node_offsets_[chunk];
+		const vector<float>& costs = costsOf(chunk);
+		const Chunk& c = chunks_[chunk];
+		const size_t count = c.entrances.size();
+		const float cost = cost_[node];
+
+		for (size_t j = 0; j < count; ++j)
+		{
+			const float step = costs[local * count + j];
+
+			if (j != local && step != INFINITE_COST)
+				relax(node_offsets_[chunk] + uint32_t(j), chunk, c.entrances[j].tile, node, cost + step);
+		}
+
+		const Entrance& entrance = c.entrances[local];
+
+		if (entrance.partner != NONE)
+		{
+			uint32_t other = chunk;
+
+			switch (entrance.side)
+			{
+				case 0: other -= 1; break;
+				case 1: other += 1; break;
+				case 2: other -= uint32_t(chunks_x_); break;
+				default: other += uint32_t(chunks_x_); break;
+			}
+
+			relax(node_offsets_[other] + entrance.partner, other, chunks_[other].entrances[entrance.partner].tile, node, cost + 1.0f);
+		}
+
+		if (chunk == goal_chunk && goal_costs_[local] != INFINITE_COST)
+			relax(goal_node, goal_chunk, goal, node, cost + goal_costs_[local]);
+	}
+
+	return false;
+}
+
+size_t HierarchicalPathfinder::entranceCount() const
+{
+	return node_offsets_.empty() ? 0 : node_offsets_.back();
+}
+
+size_t HierarchicalPathfinder::dirtyChunkCount() const
+{
+	return dirty_chunks_.size();
+}
+
+const PathCacheStats& HierarchicalPathfinder::stats() const
+{
+	return stats_;
+}
+
+void HierarchicalPathfinder::resetStats()
+{
+	stats_ = PathCacheStats();
+}
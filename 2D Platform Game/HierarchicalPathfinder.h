@@ -0,0 +1,212 @@
+// 2D Platform Game
+// HierarchicalPathfinder.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the HierarchicalPathfinder class.
+
+#ifndef HIERARCHICALPATHFINDER_H_INCLUDED
+#define HIERARCHICALPATHFINDER_H_INCLUDED
+
+#include "Pathfinding.h"
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Counters kept by a HierarchicalPathfinder.
+struct PathCacheStats
+{
+	// Amount of calls to findPath.
+	std::size_t queries = 0;
+
+	// Amount of times a search needed the entrance costs of a chunk.
+	std::size_t lookups = 0;
+
+	// Amount of lookups that found the costs already computed.
+	std::size_t hits = 0;
+
+	// Amount of chunks whose entrance costs were computed.
+	std::size_t chunk_rebuilds = 0;
+
+	// Total time spent finding entrances and computing costs, in milliseconds.
+	double rebuild_milliseconds = 0.0;
+
+	// Returns the fraction of lookups that were hits,
+	// or 0 if there have been no lookups.
+	double hitRate() const;
+};
+
+// Finds paths over large levels using hierarchical pathfinding (HPA*).
+// The level is split into square chunks. Every run of open tiles
+// crossing the border of 2 chunks gets one entrance, and the costs
+// between the entrances of a chunk are cached, so a query only
+// searches the small graph of entrances.
+// The costs of a chunk are computed the first time a search enters it.
+// Tile edits made through setTile, or reported through invalidate,
+// mark the affected chunks dirty. Their entrances are found again by
+// the next query, and their costs when a search next enters them.
+// Movement follows the same rules as GridPathfinder: 8 directions
+// without cutting corners. Paths may be slightly longer than optimal.
+class HierarchicalPathfinder
+{
+	static constexpr std::uint32_t NONE = 0xFFFFFFFF;
+
+	// A tile on the border of a chunk that leads into the chunk next to it.
+	struct Entrance
+	{
+		Jlib::Point2i tile;
+
+		// The side of the chunk the entrance is on: 0 = left, 1 = right,
+		// 2 = top, 3 = bottom.
+		std::uint8_t side = 0;
+
+		// Index of the matching entrance in the chunk next to it.
+		std::uint32_t partner = NONE;
+	};
+
+	struct Chunk
+	{
+		std::vector<Entrance> entrances;
+
+		// Cost from entrance i to entrance j is costs[i * entrances.size() + j].
+		std::vector<float> costs;
+
+		// True if the entrances must be found again.
+		bool dirty = true;
+
+		// True if costs matches entrances.
+		bool costs_ready = false;
+	};
+
+	Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	std::int32_t width_ = 0;
+	std::int32_t height_ = 0;
+	std::int32_t chunk_size_ = 16;
+	std::int32_t chunks_x_ = 0;
+	std::int32_t chunks_y_ = 0;
+	float heuristic_weight_ = 1.25f;
+
+	std::vector<Chunk> chunks_;
+	std::vector<std::uint32_t> dirty_chunks_;
+
+	// The entrances of chunk c are the nodes node_offsets_[c] to node_offsets_[c + 1] - 1.
+	std::vector<std::uint32_t> node_offsets_;
+
+	// Search state, reused between queries.
+	std::vector<float> cost_;
+	std::vector<std::uint32_t> parent_;
+	std::vector<std::uint32_t> node_chunk_;
+	std::vector<std::uint32_t> visited_;
+	std::vector<std::uint32_t> closed_;
+	std::uint32_t search_id_ = 0;
+	OpenSet open_;
+
+	// Scratch state for searches within a single chunk.
+	std::vector<std::uint8_t> local_open_tiles_;
+	std::vector<float> local_cost_;
+	std::vector<float> start_costs_;
+	std::vector<float> goal_costs_;
+	OpenSet local_open_;
+
+	PathCacheStats stats_;
+
+	// Returns the index of the chunk containing (x, y).
+	std::uint32_t chunkAt(std::int32_t x, std::int32_t y) const;
+
+	// Marks the given chunk as needing a rebuild.
+	void markDirty(std::int32_t chunk_x, std::int32_t chunk_y);
+
+	// Finds the entrances of every dirty chunk.
+	void rebuild();
+
+	// Finds the entrances of the given chunk.
+	void findEntrances(std::uint32_t chunk);
+
+	// Finds the matching entrance of every entrance of the given chunk.
+	void linkEntrances(std::uint32_t chunk);
+
+	// Computes the costs between the entrances of the given chunk.
+	void computeCosts(std::uint32_t chunk);
+
+	// Returns the costs between the entrances of the given chunk,
+	// computing them first if needed.
+	const std::vector<float>& costsOf(std::uint32_t chunk);
+
+	// Copies which tiles of the given chunk are open into local_open_tiles_.
+	void loadChunk(std::uint32_t chunk);
+
+	// Computes the cost of moving from the given tile to every tile
+	// of its chunk without leaving it, storing them in local_cost_.
+	// The chunk must have been loaded by loadChunk.
+	void searchChunk(std::uint32_t chunk, const Jlib::Point2i& from);
+
+	// Returns the local_cost_ entry of the given tile.
+	float localCost(std::uint32_t chunk, const Jlib::Point2i& tile) const;
+
+	public:
+
+	// Default constructor.
+	HierarchicalPathfinder() = default;
+
+	// Level constructor.
+	// Builds the chunk graph for the given level layout.
+	// This function will throw if chunk_size is less than 2.
+	explicit HierarchicalPathfinder(Jlib::Matrix<std::uint8_t>& level, std::int32_t chunk_size = 16);
+
+	// Sets the level layout searched by the HierarchicalPathfinder
+	// and builds its chunk graph.
+	// The level must outlive the HierarchicalPathfinder or the next call to setLevel.
+	// This function will throw if chunk_size is less than 2.
+	void setLevel(Jlib::Matrix<std::uint8_t>& level, std::int32_t chunk_size = 16);
+
+	// Sets the tile at (x, y) through Jlib::Matrix::set
+	// and marks the affected chunks dirty.
+	// This function may throw if it is given an invalid position.
+	void setTile(std::int32_t x, std::int32_t y, std::uint8_t tile);
+
+	// Marks the chunks affected by a change of the tile at (x, y) dirty.
+	// Use this after editing the level layout directly.
+	void invalidate(std::int32_t x, std::int32_t y);
+
+	// Marks every chunk dirty.
+	void invalidateAll();
+
+	// Computes the entrance costs of every chunk now instead of
+	// during later searches, such as while a level is loading.
+	void precompute();
+
+	// Sets how much the search favours entrances closer to the goal.
+	// 1 finds the shortest path through the entrances. Higher values
+	// search fewer entrances but may return longer paths.
+	// The default is 1.25.
+	// This function will throw if weight is less than 1.
+	void setHeuristicWeight(float weight);
+
+	// Finds a path from start to goal, given as tile positions.
+	// On success, path holds waypoints from start to goal and true is
+	// returned. Each waypoint either can be reached from the previous
+	// one without leaving the chunk they share, or is the tile next to
+	// it across a chunk border, one step from an entrance to the one
+	// it faces. GridPathfinder can fill in the tiles between them when
+	// needed.
+	// Returns false if either position is solid or no path exists.
+	bool findPath(const Jlib::Point2i& start, const Jlib::Point2i& goal, std::vector<Jlib::Point2i>& path);
+
+	// Returns the amount of entrances in the chunk graph.
+	std::size_t entranceCount() const;
+
+	// Returns the amount of chunks waiting to be rebuilt.
+	std::size_t dirtyChunkCount() const;
+
+	// Returns the counters kept since the last call to resetStats.
+	const PathCacheStats& stats() const;
+
+	// Resets the counters.
+	void resetStats();
+};
+
+#endif // HIERARCHICALPATHFINDER_H_INCLUDED
@@ -0,0 +1,134 @@
+// 2D Platform Game
+// Input.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for input events and the InputQueue class.
+
+#include "Input.h"
+
+#include <algorithm>
+#include <chrono>
+
+// <chrono>
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int64_t;
+using std::uint64_t;
+
+namespace
+{
+	int64_t now_nanoseconds()
+	{
+		return std::chrono::duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+bool InputFrame::isHeld(InputButton button) const
+{
+	return (held & button_bit(button)) != 0;
+}
+
+bool InputFrame::wasPressed(InputButton button) const
+{
+	return (pressed & button_bit(button)) != 0;
+}
+
+bool InputFrame::wasReleased(InputButton button) const
+{
+	return (released & button_bit(button)) != 0;
+}
+
+bool InputQueue::push(InputButton button, bool pressed)
+{
+	InputEvent event;
+	event.tick = tick_.load(std::memory_order_relaxed);
+	event.time = now_nanoseconds();
+	event.button = button;
+	event.pressed = pressed;
+
+	if (queue_.tryPush(event))
+		return true;
+
+	dropped_.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+InputFrame InputQueue::collect(uint64_t tick)
+{
+	InputFrame frame;
+	frame.tick = tick;
+
+	const InputButtons previous = held_;
+	const int64_t now = now_nanoseconds();
+
+	// Buttons that already changed this tick, or have events waiting.
+	InputButtons blocked = 0;
+
+	const auto apply = [&](const InputEvent& event)
+	{
+		const InputButtons bit = button_bit(event.button);
+
+		if ((blocked & bit) != 0)
+		{
+			pending_.push_back(event);
+			return;
+		}
+
+		// A press of a held button, or a release of one that is not,
+		// changes nothing.
+		if (((held_ & bit) != 0) == event.pressed)
+			return;
+
+		held_ ^= bit;
+		blocked |= bit;
+	};
+
+	// Events waiting from the last tick come before the new ones.
+	carried_.swap(pending_);
+	pending_.clear();
+
+	for (const InputEvent& event : carried_)
+		apply(event);
+
+	queue_.popAll([&](const InputEvent& event)
+	{
+		apply(event);
+
+		const int64_t waited = std::max<int64_t>(now - event.time, 0);
+
+		++latency_events_;
+		latency_total_ += waited;
+		latency_max_ = std::max(latency_max_, waited);
+	});
+
+	tick_.store(tick, std::memory_order_relaxed);
+
+	frame.held = held_;
+	frame.pressed = InputButtons(held_ & ~previous);
+	frame.released = InputButtons(previous & ~held_);
+
+	return frame;
+}
+
+InputLatency InputQueue::takeLatency()
+{
+	InputLatency latency;
+	latency.events = latency_events_;
+	latency.max_milliseconds = double(latency_max_) / 1e6;
+	latency.dropped = dropped_.exchange(0, std::memory_order_relaxed);
+
+	if (latency_events_ != 0)
+		latency.mean_milliseconds = double(latency_total_) / double(latency_events_) / 1e6;
+
+	latency_events_ = 0;
+	latency_total_ = 0;
+	latency_max_ = 0;
+
+	return latency;
+}
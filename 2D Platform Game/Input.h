@@ -0,0 +1,148 @@
+// 2D Platform Game
+// Input.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for input events and the InputQueue class.
+
+#ifndef INPUT_H_INCLUDED
+#define INPUT_H_INCLUDED
+
+#include "Jlib/SpscQueue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Buttons the game reacts to, whatever key or pad button they are bound to.
+enum class InputButton : std::uint8_t
+{
+	Left,
+	Right,
+	Up,
+	Down,
+	Jump,
+	Action,
+	Pause
+};
+
+// Amount of InputButton values.
+constexpr std::size_t INPUT_BUTTON_COUNT = 7;
+
+// Set of buttons, one bit per InputButton.
+using InputButtons = std::uint16_t;
+
+// Returns the bit of the given button in an InputButtons.
+constexpr InputButtons button_bit(InputButton button)
+{
+	return InputButtons(1u << std::uint32_t(button));
+}
+
+// A button press or release, as sent from the event thread.
+struct InputEvent
+{
+	// Last tick collected when the event arrived.
+	std::uint64_t tick = 0;
+
+	// steady_clock time the event arrived, in nanoseconds.
+	std::int64_t time = 0;
+
+	InputButton button = InputButton::Left;
+	bool pressed = false;
+};
+
+// The buttons of one tick.
+struct InputFrame
+{
+	std::uint64_t tick = 0;
+
+	// Buttons down during the tick.
+	InputButtons held = 0;
+
+	// Buttons down this tick but not the one before, and the reverse.
+	InputButtons pressed = 0;
+	InputButtons released = 0;
+
+	// Returns true if button is down during the tick.
+	// Returns false otherwise.
+	bool isHeld(InputButton button) const;
+
+	// Returns true if button went down since the last tick.
+	// Returns false otherwise.
+	bool wasPressed(InputButton button) const;
+
+	// Returns true if button went up since the last tick.
+	// Returns false otherwise.
+	bool wasReleased(InputButton button) const;
+};
+
+// How long events waited between arriving and being collected.
+struct InputLatency
+{
+	std::size_t events = 0;
+	double mean_milliseconds = 0.0;
+	double max_milliseconds = 0.0;
+
+	// Events dropped because the queue was full.
+	std::size_t dropped = 0;
+};
+
+// Passes button events from the thread handling window events to the
+// simulation thread without locks, through a Jlib::SpscQueue.
+// Each tick the simulation collects every event that has arrived into
+// an InputFrame. A frame depends only on its held buttons and the ones
+// of the frame before, so recording held buttons per tick is enough to
+// replay the game exactly; see InputRecorder. To keep it so, a button
+// changes at most once per tick, and its later events wait, in order,
+// for the ticks after. A button pressed and released within one tick
+// is held for that tick and released in the next, and pressed again
+// in the one after if it was, so quick taps are never lost.
+class InputQueue
+{
+	public:
+
+	static constexpr std::size_t CAPACITY = 1024;
+
+	private:
+
+	Jlib::SpscQueue<InputEvent, CAPACITY> queue_;
+	std::atomic<std::uint64_t> tick_ = 0;
+	std::atomic<std::size_t> dropped_ = 0;
+
+	// Simulation thread only.
+	InputButtons held_ = 0;
+	std::vector<InputEvent> pending_;
+	std::vector<InputEvent> carried_;
+	std::size_t latency_events_ = 0;
+	std::int64_t latency_total_ = 0;
+	std::int64_t latency_max_ = 0;
+
+	public:
+
+	// Default constructor.
+	InputQueue() = default;
+
+	// Copy constructor. Deleted.
+	InputQueue(const InputQueue& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	InputQueue& operator = (const InputQueue& other) = delete;
+
+	// Event thread only.
+	// Sends a press or release of button, stamped with the time and tick.
+	// Returns false if the queue is full and the event was dropped.
+	bool push(InputButton button, bool pressed);
+
+	// Simulation thread only.
+	// Applies every event that has arrived and returns the buttons of
+	// the given tick.
+	InputFrame collect(std::uint64_t tick);
+
+	// Simulation thread only.
+	// Returns how long the events collected since the last call waited,
+	// and how many were dropped, then starts counting again.
+	InputLatency takeLatency();
+};
+
+#endif // INPUT_H_INCLUDED
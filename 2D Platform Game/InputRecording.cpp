@@ -0,0 +1,230 @@
+// 2D Platform Game
+// InputRecording.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the InputRecorder and InputReplay classes.
+
+#include "InputRecording.h"
+#include "ByteStream.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <fstream>
+using std::ifstream;
+using std::ofstream;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr char RECORDING_MAGIC[4] = { 'J', 'R', 'E', 'C' };
+	constexpr uint32_t RECORDING_VERSION = 1;
+
+	// Magic, version and button count.
+	constexpr size_t FIXED_HEADER_SIZE = 4 + 4 + 4;
+
+	// Returns the amount of bytes ByteWriter::writeVarint takes for value.
+	size_t varint_size(uint64_t value)
+	{
+		size_t size = 1;
+
+		while (value >= 0x80)
+		{
+			value >>= 7;
+			++size;
+		}
+
+		return size;
+	}
+}
+
+InputRecorder::InputRecorder(uint64_t start_tick)
+	: start_tick_(start_tick)
+{
+
+}
+
+void InputRecorder::writeBit(bool bit)
+{
+	if (bit_count_ % 8 == 0)
+		bits_.push_back(0);
+
+	if (bit)
+		bits_.back() |= uint8_t(1u << (bit_count_ % 8));
+
+	++bit_count_;
+}
+
+void InputRecorder::record(InputButtons held)
+{
+	if (held == last_)
+		writeBit(false);
+	else
+	{
+		writeBit(true);
+
+		for (size_t i = 0; i < INPUT_BUTTON_COUNT; ++i)
+			writeBit(((held >> i) & 1) != 0);
+
+		last_ = held;
+	}
+
+	++tick_count_;
+}
+
+void InputRecorder::record(const InputFrame& frame)
+{
+	record(frame.held);
+}
+
+uint64_t InputRecorder::tickCount() const
+{
+	return tick_count_;
+}
+
+size_t InputRecorder::byteSize() const
+{
+	return FIXED_HEADER_SIZE + varint_size(start_tick_) + varint_size(tick_count_) + bits_.size();
+}
+
+void InputRecorder::write(vector<uint8_t>& bytes) const
+{
+	ByteWriter writer(bytes);
+
+	writer.writeBytes(RECORDING_MAGIC, 4);
+	writer.writeU32(RECORDING_VERSION);
+	writer.writeU32(uint32_t(INPUT_BUTTON_COUNT));
+	writer.writeVarint(start_tick_);
+	writer.writeVarint(tick_count_);
+	writer.writeBytes(bits_.data(), bits_.size());
+}
+
+void InputRecorder::save(const string& path) const
+{
+	vector<uint8_t> bytes;
+	bytes.reserve(byteSize());
+	write(bytes);
+
+	ofstream fout(path, std::ios::binary | std::ios::trunc);
+	fout.write(reinterpret_cast<const char*>(bytes.data()), std::streamsize(bytes.size()));
+
+	if (!fout)
+		throw runtime_error("InputRecorder: could not write " + path);
+}
+
+InputReplay::InputReplay(const uint8_t* data, size_t size)
+{
+	open(data, size);
+}
+
+InputReplay::InputReplay(const string& path)
+{
+	ifstream fin(path, std::ios::binary | std::ios::ate);
+
+	if (!fin.is_open())
+		throw runtime_error("InputReplay: could not open " + path);
+
+	vector<uint8_t> bytes(size_t(fin.tellg()));
+	fin.seekg(0);
+
+	if (!fin.read(reinterpret_cast<char*>(bytes.data()), std::streamsize(bytes.size())))
+		throw runtime_error("InputReplay: could not read " + path);
+
+	open(bytes.data(), bytes.size());
+}
+
+void InputReplay::open(const uint8_t* data, size_t size)
+{
+	if (size < 4 || std::memcmp(data, RECORDING_MAGIC, 4) != 0)
+		throw runtime_error("InputReplay: not an input recording");
+
+	ByteReader reader(data + 4, size - 4);
+
+	if (reader.readU32() != RECORDING_VERSION)
+		throw runtime_error("InputReplay: unsupported version");
+
+	if (reader.readU32() != INPUT_BUTTON_COUNT)
+		throw runtime_error("InputReplay: recorded with a different set of buttons");
+
+	start_tick_ = reader.readVarint();
+	tick_count_ = reader.readVarint();
+
+	// Every tick takes at least one bit.
+	if (tick_count_ > uint64_t(reader.remaining()) * 8)
+		throw runtime_error("InputReplay: more ticks than the recording holds");
+
+	const size_t bit_bytes = reader.remaining();
+	const uint8_t* const bits = reader.readBytes(bit_bytes);
+
+	bits_.assign(bits, bits + bit_bytes);
+}
+
+bool InputReplay::readBit()
+{
+	if (bit_position_ >= bits_.size() * 8)
+		throw runtime_error("InputReplay: the recording is damaged");
+
+	const bool bit = ((bits_[bit_position_ / 8] >> (bit_position_ % 8)) & 1) != 0;
+	++bit_position_;
+
+	return bit;
+}
+
+uint64_t InputReplay::startTick() const
+{
+	return start_tick_;
+}
+
+uint64_t InputReplay::tickCount() const
+{
+	return tick_count_;
+}
+
+bool InputReplay::finished() const
+{
+	return ticks_read_ == tick_count_;
+}
+
+bool InputReplay::next(InputFrame& frame)
+{
+	if (finished())
+		return false;
+
+	InputButtons held = last_;
+
+	if (readBit())
+	{
+		held = 0;
+
+		for (size_t i = 0; i < INPUT_BUTTON_COUNT; ++i)
+			held |= InputButtons(readBit() ? 1u << i : 0u);
+	}
+
+	frame.tick = start_tick_ + ticks_read_;
+	frame.held = held;
+	frame.pressed = InputButtons(held & ~last_);
+	frame.released = InputButtons(last_ & ~held);
+
+	last_ = held;
+	++ticks_read_;
+
+	return true;
+}
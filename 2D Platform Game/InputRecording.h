@@ -0,0 +1,107 @@
+// 2D Platform Game
+// InputRecording.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the InputRecorder and InputReplay classes.
+
+#ifndef INPUTRECORDING_H_INCLUDED
+#define INPUTRECORDING_H_INCLUDED
+
+#include "Input.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Records the held buttons of every tick, as given by InputQueue, so
+// the game can be played back by feeding the frames of an InputReplay
+// to the simulation instead.
+// Ticks are bit-packed: a 0 bit for a tick whose buttons did not change,
+// or a 1 bit followed by one bit per InputButton. Buttons change on few
+// ticks, so an hour at 60 ticks a second takes around 30 KB.
+//
+// File layout: magic "JREC", version and button count as uint32_t,
+// then the first tick and the amount of ticks as varints, then the bits,
+// low bit of each byte first.
+class InputRecorder
+{
+	std::uint64_t start_tick_ = 0;
+	std::uint64_t tick_count_ = 0;
+	InputButtons last_ = 0;
+	std::vector<std::uint8_t> bits_;
+	std::size_t bit_count_ = 0;
+
+	void writeBit(bool bit);
+
+	public:
+
+	// Tick constructor.
+	// The first tick recorded is start_tick.
+	explicit InputRecorder(std::uint64_t start_tick = 0);
+
+	// Records the held buttons of the next tick.
+	void record(InputButtons held);
+
+	// Records frame.held. The frames must come one tick after another.
+	void record(const InputFrame& frame);
+
+	// Returns the amount of ticks recorded.
+	std::uint64_t tickCount() const;
+
+	// Returns the size of the recording as written by write, in bytes.
+	std::size_t byteSize() const;
+
+	// Appends the recording to bytes.
+	void write(std::vector<std::uint8_t>& bytes) const;
+
+	// Writes the recording to the file at path.
+	// This function will throw if the file cannot be written.
+	void save(const std::string& path) const;
+};
+
+// Plays back a recording made by InputRecorder, one InputFrame per tick.
+class InputReplay
+{
+	std::vector<std::uint8_t> bits_;
+	std::size_t bit_position_ = 0;
+	std::uint64_t start_tick_ = 0;
+	std::uint64_t tick_count_ = 0;
+	std::uint64_t ticks_read_ = 0;
+	InputButtons last_ = 0;
+
+	// This function will throw if the bits run out.
+	bool readBit();
+
+	// Reads the header and keeps the bits of a whole recording.
+	void open(const std::uint8_t* data, std::size_t size);
+
+	public:
+
+	// Bytes constructor.
+	// Reads a recording from bytes written by InputRecorder::write.
+	// This function will throw if the bytes are not a valid recording.
+	InputReplay(const std::uint8_t* data, std::size_t size);
+
+	// Path constructor.
+	// This function will throw if the file cannot be read or is not a valid recording.
+	explicit InputReplay(const std::string& path);
+
+	// Returns the first tick of the recording.
+	std::uint64_t startTick() const;
+
+	// Returns the amount of ticks in the recording.
+	std::uint64_t tickCount() const;
+
+	// Returns true if every tick has been read.
+	// Returns false otherwise.
+	bool finished() const;
+
+	// Reads the frame of the next tick into frame.
+	// Returns false if every tick has already been read.
+	// This function will throw if the recording is damaged.
+	bool next(InputFrame& frame);
+};
+
+#endif // INPUTRECORDING_H_INCLUDED
@@ -2,12 +2,13 @@
 // Color.h
 // Justyn Durnford
 // Created on 2020-10-12
-// Last updated on 2021-02-09
+// Last updated on 2026-10-19
 // Header file for the Color class.
 
 #ifndef COLOR_H_INCLUDED
 #define COLOR_H_INCLUDED
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <string>
@@ -45,6 +46,10 @@ namespace Jlib
 		// Sets alpha = new_alpha.
 		Color(std::uint8_t new_red, std::uint8_t new_green, std::uint8_t new_blue, std::uint8_t new_alpha);
 
+		// Packed integer constructor.
+		// Takes the channels from an integer laid out as 0xRRGGBBAA.
+		explicit Color(std::uint32_t rgba);
+
 		// Copy assignment.
 		Color& operator = (const Color& other) = default;
 
@@ -60,10 +65,17 @@ namespace Jlib
 		// Sets alpha = new_alpha.
 		void setAll(std::uint8_t new_red, std::uint8_t new_green, std::uint8_t new_blue, std::uint8_t new_alpha);
 
+		// Returns the Color packed into an integer laid out as 0xRRGGBBAA.
+		std::uint32_t toInteger() const;
+
 		// Returns a std::string representation of the Color.
 		std::string toString() const;
 	};
 
+	// The span functions and operator == rely on a Color being 4 bytes
+	// in the order red, green, blue, alpha.
+	static_assert(sizeof(Color) == 4, "Jlib::Color must be 4 bytes.");
+
 	///////////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -73,6 +85,7 @@ namespace Jlib
 	/////////////////////////////////////////////////////////////////////////////////////////////////// 
 
 	// Equality comparison operator.
+	// Compares the 4 bytes of each Color as a single integer.
 	// Returns true if:
 	//  - A.red == B.red      AND
 	//  - A.green == B.green  AND
@@ -82,6 +95,7 @@ namespace Jlib
 	bool operator == (const Color& A, const Color& B);
 
 	// Inequality comparison operator.
+	// Compares the 4 bytes of each Color as a single integer.
 	// Returns true if:
 	//  - A.red != B.red      OR
 	//  - A.green != B.green  OR
@@ -96,6 +110,59 @@ namespace Jlib
 	void print(const Color& c);
 
 	void println(const Color& c);
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                  COLOR SPAN FUNCTIONS                                 //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// The span functions work on count Colors at a time and use SSE2
+	// when it is available, 4 Colors at a time. Channel products are
+	// divided by 255 and rounded to nearest, so a channel multiplied
+	// by 255 is unchanged. The SSE2 and scalar versions give the same
+	// results. Source and destination spans may be the same span but
+	// must not otherwise overlap.
+
+	// Draws source[i] over destination[i] by source alpha:
+	//  - color = source * source.alpha + destination * (255 - source.alpha)
+	//  - alpha = source.alpha + destination.alpha * (255 - source.alpha)
+	void blend_colors(const Color* source, Color* destination, std::size_t count);
+
+	// Draws premultiplied source[i] over premultiplied destination[i]:
+	//  - every channel = source + destination * (255 - source.alpha)
+	// Channels saturate at 255.
+	void blend_premultiplied_colors(const Color* source, Color* destination, std::size_t count);
+
+	// Multiplies the red, green and blue of colors[i] by its alpha.
+	void premultiply_colors(Color* colors, std::size_t count);
+
+	// Sets result[i] to colors[i] multiplied by tint, channel by channel.
+	void tint_colors(const Color* colors, const Color& tint, Color* result, std::size_t count);
+
+	// Sets result[i] to A[i] multiplied by B[i], channel by channel.
+	void multiply_colors(const Color* A, const Color* B, Color* result, std::size_t count);
+
+	// Sets result[i] to the Color t of the way from A[i] to B[i].
+	// t is clamped to [0, 1] and rounded to a step of 1/255.
+	void lerp_colors(const Color* A, const Color* B, float t, Color* result, std::size_t count);
+
+	// Packs colors[i] into packed[i] laid out as 0xRRGGBBAA.
+	void colors_to_integers(const Color* colors, std::uint32_t* packed, std::size_t count);
+
+	// Unpacks packed[i], laid out as 0xRRGGBBAA, into colors[i].
+	void integers_to_colors(const std::uint32_t* packed, Color* colors, std::size_t count);
+
+	// Converts colors[i] into 4 floats in [0, 1] at rgba[4 * i],
+	// in the order red, green, blue, alpha.
+	void colors_to_floats(const Color* colors, float* rgba, std::size_t count);
+
+	// Converts 4 floats at rgba[4 * i], in the order red, green, blue,
+	// alpha, into colors[i]. Each float is clamped to [0, 1] and rounded
+	// to the nearest step of 1/255.
+	void floats_to_colors(const float* rgba, Color* colors, std::size_t count);
 }
 
 #endif // COLOR_H_INCLUDED
\ No newline at end of file
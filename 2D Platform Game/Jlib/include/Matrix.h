@@ -2,24 +2,45 @@
 // Matrix.h
 // Justyn Durnford
 // Created on 2020-10-12
-// Last updated on 2021-02-09
+// Last updated on 2026-10-19
 // Header file for the Matrix template class.
 
 #ifndef MATRIX_H_INCLUDED
 #define MATRIX_H_INCLUDED
 
+#include "Arithmetic.h"
+
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace Jlib
 {
+	// Anything with matrix dimensions whose elements can be read by a flat,
+	// row-major index. Both Jlib::Matrix and the lazy arithmetic expressions
+	// built from it satisfy this concept.
+	template <typename E> concept matrix_expression = requires(const E& expr, std::size_t index)
+	{
+		{ expr.rowSize() } -> std::convertible_to<std::size_t>;
+		{ expr.colSize() } -> std::convertible_to<std::size_t>;
+		expr[index];
+	};
 
-	// This class is able to function as a 
-	//
-	//
+	// Expands to the type of the elements produced by the given matrix_expression.
+	template <matrix_expression E> using matrix_element_t = std::remove_cvref_t<decltype(std::declval<const E&>()[0])>;
+
+	// This class is able to function as a two-dimensional array
+	// whose dimensions are decided at runtime.
+	// The elements are stored contiguously in row-major order, and
+	// the buffer is kept and reused by assignment and resize() as long
+	// as it is large enough, so reloading data of the same size does
+	// not allocate.
 	template <std::semiregular T> class Matrix
 	{
 		public:
@@ -29,13 +50,19 @@ namespace Jlib
 
 		private:
 
-		value_type** matrix_ = nullptr;
+		value_type* matrix_ = nullptr;
 		size_type row_ = 0;
 		size_type col_ = 0;
+		size_type capacity_ = 0;
+
+		// True if elements can be rearranged inside the current buffer
+		// without risking an exception halfway through.
+		static constexpr bool nothrow_reuse_ = std::is_nothrow_copy_assignable_v<value_type>
+			&& std::is_nothrow_move_assignable_v<value_type>;
 
 		// This function will check the given position and will throw
 		// if it is given an invalid position.
-		void checkBounds(size_type row, size_type col)
+		void checkBounds(size_type row, size_type col) const
 		{
 			if (row >= row_)
 				throw std::out_of_range("Invalid row index");
@@ -44,31 +71,40 @@ namespace Jlib
 				throw std::out_of_range("Invalid column index");
 		}
 
-		// This function will allocate memory sufficient to store the
-		// amount of elements given by row * col.
+		// This function will allocate a value-initialized buffer able
+		// to hold count elements.
 		// This function will throw if it is unable to do this.
-		void allocate(size_type row, size_type col)
+		static value_type* allocate(size_type count)
 		{
-			try
-			{
-				row_ = row;
-				col_ = col;
-				matrix_ = new value_type * [row];
+			if (count == 0)
+				return nullptr;
 
-				for (size_type r = 0; r < row_; r++)
-					matrix_[r] = new value_type[col_];
-			}
-			catch (...) { throw; }
+			return new value_type[count]();
 		}
 
 		// This function releases the memory held by the Jlib::Matrix.
 		// This function may not throw.
 		void deallocate() noexcept
 		{
-			for (size_type r = 0; r < row_; r++)
-				delete[] matrix_[r];
-
 			delete[] matrix_;
+
+			matrix_ = nullptr;
+			row_ = 0;
+			col_ = 0;
+			capacity_ = 0;
+		}
+
+		// This function writes every element of the given expression into
+		// the Jlib::Matrix, which must already have the dimensions of expr.
+		// Each element only reads the same position of its operands, so expr
+		// may refer to this Jlib::Matrix.
+		template <matrix_expression E> void evaluate(const E& expr)
+		{
+			const size_type count = size();
+			value_type* out = matrix_;
+
+			for (size_type i = 0; i < count; ++i)
+				out[i] = static_cast<value_type>(expr[i]);
 		}
 
 		public:
@@ -79,10 +115,14 @@ namespace Jlib
 
 		// 2-parameter constructor.
 		// Creates a new Jlib::Matrix with the dimensions row x col.
+		// Every element is value-initialized.
 		// This function may throw if it is unable to allocate enough memory.
 		Matrix(size_type row, size_type col)
 		{
-			allocate(row, col);
+			matrix_ = allocate(row * col);
+			row_ = row;
+			col_ = col;
+			capacity_ = row * col;
 		}
 
 		// 3-parameter constructor.
@@ -90,126 +130,133 @@ namespace Jlib
 		// with each element being a copy of value.
 		// This function may throw if it is unable to allocate enough memory.
 		Matrix(size_type row, size_type col, const value_type& value)
+			: Matrix(row, col)
 		{
-			allocate(row, col);
-
-			for (size_type r = 0; r < row_; ++r)
-			{
-				for (size_type c = 0; c < col_; ++c)
-					matrix_[r][c] = value;
-			}
+			fill(value);
 		}
 
 		// Copy constructor.
 		// Creates a copy of the passed Jlib::Matrix.
 		// This function may throw if it is unable to allocate enough memory.
-		explicit Matrix(const Matrix& other)
+		Matrix(const Matrix& other)
+			: Matrix(other.row_, other.col_)
 		{
-			allocate(other.row_, other.col_);
-
-			try
-			{
-				for (size_type r = 0; r < row_; ++r)
-				{
-					for (size_type c = 0; c < col_; ++c)
-						matrix_[r][c] = other.matrix_[r][c];
-				}
-			}
-			catch (...) { throw; }
+			std::copy(other.matrix_, other.matrix_ + other.size(), matrix_);
 		}
 
 		// Move constructor.
 		// Moves the passed Jlib::Matrix into the new Jlib::Matrix.
 		// This function may not throw.
-		explicit Matrix(Matrix&& other) noexcept
+		Matrix(Matrix&& other) noexcept
+		{
+			swap(other);
+		}
+
+		// std::initializer_list<std::initializer_list> constructor.
+		// Copies the elements from the given std::initializer_list<std::initializer_list<value_type>>.
+		// Rows shorter than the longest row are padded with value-initialized elements.
+		// This function may throw if it is unable to allocate enough memory.
+		Matrix(std::initializer_list<std::initializer_list<value_type>> matrix)
 		{
-			row_ = other.row_;
-			col_ = other.col_;
-			matrix_ = other.matrix_;
+			size_type col = 0;
 
-			other.row_ = 0;
-			other.col_ = 0;
-			other.matrix_ = nullptr;
+			for (const std::initializer_list<value_type>& list : matrix)
+			{
+				if (list.size() > col)
+					col = list.size();
+			}
+
+			Matrix temp(matrix.size(), col);
+			size_type r = 0;
+
+			for (const std::initializer_list<value_type>& list : matrix)
+			{
+				std::copy(list.begin(), list.end(), temp.matrix_ + r * col);
+				++r;
+			}
+
+			swap(temp);
+		}
+
+		// Expression constructor.
+		// Creates a new Jlib::Matrix holding the result of the given expression,
+		// such as A + B * 2.0f. No intermediate Jlib::Matrix is created.
+		// This function may throw if it is unable to allocate enough memory.
+		template <matrix_expression E> requires (!std::same_as<E, Matrix>)
+		Matrix(const E& expr)
+			: Matrix(expr.rowSize(), expr.colSize())
+		{
+			evaluate(expr);
 		}
 
 		// Copy assignment operator.
-		// Creates a copy of the passed Jlib::Matrix.
+		// Copies the passed Jlib::Matrix into this Jlib::Matrix.
+		// The current buffer is reused if it is large enough.
+		// Provides the strong exception guarantee.
 		// This function may throw if it is unable to allocate enough memory.
 		Matrix& operator = (const Matrix& other)
 		{
-			deallocate();
-			allocate(other.row_, other.col_);
+			if (this == &other)
+				return *this;
 
-			try
+			if constexpr (nothrow_reuse_)
 			{
-				for (size_type r = 0; r < row_; ++r)
+				if (other.size() <= capacity_)
 				{
-					for (size_type c = 0; c < col_; ++c)
-						matrix_[r][c] = other.matrix_[r][c];
+					std::copy(other.matrix_, other.matrix_ + other.size(), matrix_);
+					row_ = other.row_;
+					col_ = other.col_;
+
+					return *this;
 				}
 			}
-			catch (...) { throw; }
+
+			Matrix temp(other);
+			swap(temp);
 
 			return *this;
 		}
 
 		// Move assignment operator.
-		// Moves the passed Jlib::Matrix into the new Jlib::Matrix.
+		// Moves the passed Jlib::Matrix into this Jlib::Matrix.
 		// This function may not throw.
 		Matrix& operator = (Matrix&& other) noexcept
 		{
-			deallocate();
-
-			row_ = other.row_;
-			col_ = other.col_;
-			matrix_ = other.matrix_;
-
-			other.row_ = 0;
-			other.col_ = 0;
-			other.matrix_ = nullptr;
+			if (this != &other)
+			{
+				deallocate();
+				swap(other);
+			}
 
 			return *this;
 		}
 
 		// std::initializer_list<std::initializer_list> assignment operator.
 		// Copies the elements from the given std::initializer_list<std::initializer_list<value_type>>.
-		// This function may throw if it is unable to do this.
-		Matrix& operator = (const std::initializer_list<std::initializer_list<value_type>>& matrix)
+		// Provides the strong exception guarantee.
+		// This function may throw if it is unable to allocate enough memory.
+		Matrix& operator = (std::initializer_list<std::initializer_list<value_type>> matrix)
 		{
-			deallocate();
-			size_type col = 0;
-
-			for (const std::initializer_list<value_type>& list : matrix)
-			{
-				if (list.size() > col)
-					col = list.size();
-			}
+			Matrix temp(matrix);
+			swap(temp);
 
-			allocate(matrix.size(), col);
+			return *this;
+		}
 
-			try
+		// Expression assignment operator.
+		// Evaluates the given expression into this Jlib::Matrix.
+		// The current buffer is reused if the dimensions match.
+		// This function may throw if it is unable to allocate enough memory.
+		template <matrix_expression E> requires (!std::same_as<E, Matrix>)
+		Matrix& operator = (const E& expr)
+		{
+			if (expr.rowSize() == row_ && expr.colSize() == col_)
+				evaluate(expr);
+			else
 			{
-				auto row_iter(matrix.begin());
-				std::size_t r(0);
-				std::size_t c(0);
-
-				while (row_iter != matrix.end())
-				{
-					auto col_iter(row_iter->begin());
-
-					while (col_iter != row_iter->end())
-					{
-						matrix_[r][c] = *col_iter;
-						++c;
-						++col_iter;
-					}
-
-					c = 0;
-					++r;
-					++row_iter;
-				}
+				Matrix temp(expr);
+				swap(temp);
 			}
-			catch (...) { throw; }
 
 			return *this;
 		}
@@ -223,22 +270,149 @@ namespace Jlib
 		}
 
 		// Returns the row count of the Jlib::Matrix.
-		size_type rowSize() const
+		size_type rowSize() const noexcept
 		{
 			return row_;
 		}
 
 		// Returns the column count of the Jlib::Matrix.
-		size_type colSize() const
+		size_type colSize() const noexcept
 		{
 			return col_;
 		}
 
+		// Returns the total amount of elements in the Jlib::Matrix.
+		size_type size() const noexcept
+		{
+			return row_ * col_;
+		}
+
+		// Returns the amount of elements the Jlib::Matrix can hold
+		// without allocating.
+		size_type capacity() const noexcept
+		{
+			return capacity_;
+		}
+
 		// Returns true if the Jlib::Matrix is empty.
 		// Returns false otherwise.
-		bool empty() const
+		bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+
+		// Returns a pointer to the first element of the Jlib::Matrix.
+		// Row r starts at data() + r * colSize().
+		value_type* data() noexcept
+		{
+			return matrix_;
+		}
+
+		// Returns a const pointer to the first element of the Jlib::Matrix.
+		// Row r starts at data() + r * colSize().
+		const value_type* data() const noexcept
+		{
+			return matrix_;
+		}
+
+		// Makes sure the Jlib::Matrix can hold at least count elements
+		// without allocating. The dimensions and elements are unchanged.
+		// Provides the strong exception guarantee.
+		// This function may throw if it is unable to allocate enough memory.
+		void reserve(size_type count)
+		{
+			if (count <= capacity_)
+				return;
+
+			value_type* buffer = allocate(count);
+
+			try
+			{
+				std::copy(matrix_, matrix_ + size(), buffer);
+			}
+			catch (...)
+			{
+				delete[] buffer;
+				throw;
+			}
+
+			delete[] matrix_;
+			matrix_ = buffer;
+			capacity_ = count;
+		}
+
+		// Changes the dimensions of the Jlib::Matrix to row x col.
+		// Elements inside both the old and the new dimensions keep their
+		// position, new elements are value-initialized.
+		// The current buffer is reused if it is large enough.
+		// Provides the strong exception guarantee.
+		// This function may throw if it is unable to allocate enough memory.
+		void resize(size_type row, size_type col)
+		{
+			if (row == row_ && col == col_)
+				return;
+
+			const size_type keep_rows = std::min(row, row_);
+			const size_type keep_cols = std::min(col, col_);
+
+			if constexpr (nothrow_reuse_)
+			{
+				if (row * col <= capacity_)
+				{
+					// Shrinking rows move towards the front, growing rows towards
+					// the back, so each pass only reads elements it has not yet written.
+					if (col < col_)
+					{
+						for (size_type r = 1; r < keep_rows; ++r)
+							std::move(matrix_ + r * col_, matrix_ + r * col_ + col, matrix_ + r * col);
+					}
+					else if (col > col_)
+					{
+						for (size_type r = keep_rows; r-- > 0;)
+						{
+							std::move_backward(matrix_ + r * col_, matrix_ + r * col_ + col_, matrix_ + r * col + col_);
+							std::fill(matrix_ + r * col + col_, matrix_ + (r + 1) * col, value_type());
+						}
+					}
+
+					std::fill(matrix_ + keep_rows * col, matrix_ + row * col, value_type());
+					row_ = row;
+					col_ = col;
+
+					return;
+				}
+			}
+
+			Matrix temp(row, col);
+
+			for (size_type r = 0; r < keep_rows; ++r)
+				std::copy(matrix_ + r * col_, matrix_ + r * col_ + keep_cols, temp.matrix_ + r * col);
+
+			swap(temp);
+		}
+
+		// Sets the dimensions of the Jlib::Matrix to 0 x 0.
+		// The buffer is kept for later reuse.
+		void clear() noexcept
+		{
+			row_ = 0;
+			col_ = 0;
+		}
+
+		// Sets every element of the Jlib::Matrix to value.
+		void fill(const value_type& value)
+		{
+			std::fill(matrix_, matrix_ + size(), value);
+		}
+
+		// Swaps the contents of this Jlib::Matrix with other.
+		// This function may not throw.
+		void swap(Matrix& other) noexcept
 		{
-			return row_ == 0;
+			std::swap(matrix_, other.matrix_);
+			std::swap(row_, other.row_);
+			std::swap(col_, other.col_);
+			std::swap(capacity_, other.capacity_);
 		}
 
 		// Returns a reference to the element at the position [row][col].
@@ -246,7 +420,7 @@ namespace Jlib
 		value_type& at(size_type row, size_type col)
 		{
 			checkBounds(row, col);
-			return matrix_[row][col];
+			return matrix_[row * col_ + col];
 		}
 
 		// Returns a const reference to the element at the position [row][col].
@@ -254,19 +428,31 @@ namespace Jlib
 		const value_type& at(size_type row, size_type col) const
 		{
 			checkBounds(row, col);
-			return matrix_[row][col];
+			return matrix_[row * col_ + col];
 		}
 
 		// Returns a reference to the element at the position [row][col].
 		value_type& operator () (size_type row, size_type col)
 		{
-			return matrix_[row][col];
+			return matrix_[row * col_ + col];
 		}
 
 		// Returns a const reference to the element at the position [row][col].
 		const value_type& operator () (size_type row, size_type col) const
 		{
-			return matrix_[row][col];
+			return matrix_[row * col_ + col];
+		}
+
+		// Returns a reference to the element at the given row-major index.
+		value_type& operator [] (size_type index)
+		{
+			return matrix_[index];
+		}
+
+		// Returns a const reference to the element at the given row-major index.
+		const value_type& operator [] (size_type index) const
+		{
+			return matrix_[index];
 		}
 
 		// Sets the element at the position [row][col] to value.
@@ -274,9 +460,450 @@ namespace Jlib
 		void set(size_type row, size_type col, const value_type& value)
 		{
 			checkBounds(row, col);
-			matrix_[row][col] = value;
+			matrix_[row * col_ + col] = value;
+		}
+
+		// Addition assignment operator.
+		// Adds the elements of the given expression onto the
+		// corresponding elements of this Jlib::Matrix.
+		// This function will throw if the dimensions do not match.
+		template <matrix_expression E> Matrix& operator += (const E& expr);
+
+		// Subtraction assignment operator.
+		// Subtracts the elements of the given expression from the
+		// corresponding elements of this Jlib::Matrix.
+		// This function will throw if the dimensions do not match.
+		template <matrix_expression E> Matrix& operator -= (const E& expr);
+
+		// Multiplication assignment operator.
+		// Multiplies the elements of this Jlib::Matrix by value.
+		template <arithmetic Ty> Matrix& operator *= (Ty value)
+		{
+			const size_type count = size();
+
+			for (size_type i = 0; i < count; ++i)
+				matrix_[i] *= value;
+
+			return *this;
+		}
+
+		// Division assignment operator.
+		// Divides the elements of this Jlib::Matrix by value.
+		template <arithmetic Ty> Matrix& operator /= (Ty value)
+		{
+			const size_type count = size();
+
+			for (size_type i = 0; i < count; ++i)
+				matrix_[i] /= value;
+
+			return *this;
+		}
+	};
+
+	template <std::semiregular T> template <matrix_expression E> Matrix<T>& Matrix<T>::operator += (const E& expr)
+	{
+		if (expr.rowSize() != row_ || expr.colSize() != col_)
+			throw std::invalid_argument("Matrix dimensions do not match");
+
+		const size_type count = size();
+
+		for (size_type i = 0; i < count; ++i)
+			matrix_[i] += expr[i];
+
+		return *this;
+	}
+
+	template <std::semiregular T> template <matrix_expression E> Matrix<T>& Matrix<T>::operator -= (const E& expr)
+	{
+		if (expr.rowSize() != row_ || expr.colSize() != col_)
+			throw std::invalid_argument("Matrix dimensions do not match");
+
+		const size_type count = size();
+
+		for (size_type i = 0; i < count; ++i)
+			matrix_[i] -= expr[i];
+
+		return *this;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                      EXPRESSIONS                                      //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// A matrix_expression given as an lvalue or rvalue of any constness.
+	template <typename E> concept forwarded_matrix_expression = matrix_expression<std::remove_cvref_t<E>>;
+
+	// Expressions hold a Jlib::Matrix lvalue by reference, and anything
+	// else by value: nested expressions, which are a few pointers, and
+	// Jlib::Matrix temporaries such as the result of transpose, which
+	// are moved in. An expression can therefore be kept, as in
+	// auto e = transpose(X) + Y, as long as the named matrices it reads
+	// outlive it, and is only evaluated once it is assigned to a
+	// Jlib::Matrix.
+	// E is the type an operand was given as, deduced by forwarding.
+	template <typename E> struct matrix_operand
+	{
+		using type = std::remove_cvref_t<E>;
+	};
+
+	template <std::semiregular T> struct matrix_operand<Matrix<T>&>
+	{
+		using type = const Matrix<T>&;
+	};
+
+	template <std::semiregular T> struct matrix_operand<const Matrix<T>&>
+	{
+		using type = const Matrix<T>&;
+	};
+
+	template <typename E> using matrix_operand_t = typename matrix_operand<E>::type;
+
+	// Lazy element-wise operation on a single matrix_expression.
+	// E is the matrix_operand_t of the operand.
+	template <typename E, typename Op> class MatrixUnaryExpression
+	{
+		E expr_;
+		Op op_;
+
+		public:
+
+		using size_type = std::size_t;
+
+		template <typename Arg> MatrixUnaryExpression(Arg&& expr, Op op)
+			: expr_(std::forward<Arg>(expr)), op_(op) {}
+
+		size_type rowSize() const { return expr_.rowSize(); }
+
+		size_type colSize() const { return expr_.colSize(); }
+
+		auto operator [] (size_type index) const
+		{
+			return op_(expr_[index]);
+		}
+	};
+
+	// Lazy element-wise operation on 2 matrix_expressions of the same dimensions.
+	// L and R are the matrix_operand_t of the operands.
+	template <typename L, typename R, typename Op> class MatrixBinaryExpression
+	{
+		L lhs_;
+		R rhs_;
+
+		public:
+
+		using size_type = std::size_t;
+
+		// This function will throw if the dimensions of lhs and rhs do not match.
+		template <typename LArg, typename RArg> MatrixBinaryExpression(LArg&& lhs, RArg&& rhs)
+			: lhs_(std::forward<LArg>(lhs)), rhs_(std::forward<RArg>(rhs))
+		{
+			if (lhs_.rowSize() != rhs_.rowSize() || lhs_.colSize() != rhs_.colSize())
+				throw std::invalid_argument("Matrix dimensions do not match");
+		}
+
+		size_type rowSize() const { return lhs_.rowSize(); }
+
+		size_type colSize() const { return lhs_.colSize(); }
+
+		auto operator [] (size_type index) const
+		{
+			return Op()(lhs_[index], rhs_[index]);
+		}
+	};
+
+	// Lazy element-wise operation between a matrix_expression and a scalar.
+	// E is the matrix_operand_t of the operand.
+	template <typename E, arithmetic S, typename Op> class MatrixScalarExpression
+	{
+		E expr_;
+		S scalar_;
+
+		public:
+
+		using size_type = std::size_t;
+
+		template <typename Arg> MatrixScalarExpression(Arg&& expr, S scalar)
+			: expr_(std::forward<Arg>(expr)), scalar_(scalar) {}
+
+		size_type rowSize() const { return expr_.rowSize(); }
+
+		size_type colSize() const { return expr_.colSize(); }
+
+		auto operator [] (size_type index) const
+		{
+			return Op()(expr_[index], scalar_);
 		}
 	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                    GLOBAL OPERATORS                                   //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Element-wise addition operator.
+	// Will throw a std::invalid_argument exception if the dimensions do not match.
+	template <forwarded_matrix_expression L, forwarded_matrix_expression R> auto operator + (L&& A, R&& B)
+	{
+		return MatrixBinaryExpression<matrix_operand_t<L>, matrix_operand_t<R>, std::plus<>>(std::forward<L>(A), std::forward<R>(B));
+	}
+
+	// Element-wise subtraction operator.
+	// Will throw a std::invalid_argument exception if the dimensions do not match.
+	template <forwarded_matrix_expression L, forwarded_matrix_expression R> auto operator - (L&& A, R&& B)
+	{
+		return MatrixBinaryExpression<matrix_operand_t<L>, matrix_operand_t<R>, std::minus<>>(std::forward<L>(A), std::forward<R>(B));
+	}
+
+	// Element-wise negation operator.
+	template <forwarded_matrix_expression E> auto operator - (E&& A)
+	{
+		return MatrixUnaryExpression<matrix_operand_t<E>, std::negate<>>(std::forward<E>(A), std::negate<>());
+	}
+
+	// Scalar multiplication operator.
+	template <forwarded_matrix_expression E, arithmetic S> auto operator * (E&& A, S value)
+	{
+		return MatrixScalarExpression<matrix_operand_t<E>, S, std::multiplies<>>(std::forward<E>(A), value);
+	}
+
+	// Scalar multiplication operator.
+	template <forwarded_matrix_expression E, arithmetic S> auto operator * (S value, E&& A)
+	{
+		return MatrixScalarExpression<matrix_operand_t<E>, S, std::multiplies<>>(std::forward<E>(A), value);
+	}
+
+	// Scalar division operator.
+	template <forwarded_matrix_expression E, arithmetic S> auto operator / (E&& A, S value)
+	{
+		return MatrixScalarExpression<matrix_operand_t<E>, S, std::divides<>>(std::forward<E>(A), value);
+	}
+
+	// Equality comparison operator.
+	// Returns true if A and B have the same dimensions and elements.
+	// Returns false otherwise.
+	template <std::semiregular T> bool operator == (const Matrix<T>& A, const Matrix<T>& B)
+	{
+		if (A.rowSize() != B.rowSize() || A.colSize() != B.colSize())
+			return false;
+
+		return std::equal(A.data(), A.data() + A.size(), B.data());
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                    GLOBAL FUNCTIONS                                   //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Swaps the contents of the 2 given Jlib::Matrix objects.
+	// This function may not throw.
+	template <std::semiregular T> void swap(Matrix<T>& A, Matrix<T>& B) noexcept
+	{
+		A.swap(B);
+	}
+
+	// Returns the given expression as a Jlib::Matrix<T>.
+	// A Jlib::Matrix<T> is returned by reference without copying.
+	template <std::semiregular T, matrix_expression E> decltype(auto) as_matrix(const E& expr)
+	{
+		if constexpr (std::same_as<E, Matrix<T>>)
+			return (expr);
+		else
+			return Matrix<T>(expr);
+	}
+
+	// Returns an expression applying func to every element of A.
+	template <forwarded_matrix_expression E, typename Func> auto apply(E&& A, Func func)
+	{
+		return MatrixUnaryExpression<matrix_operand_t<E>, Func>(std::forward<E>(A), func);
+	}
+
+	// Returns the element-wise product of A and B.
+	// Will throw a std::invalid_argument exception if the dimensions do not match.
+	template <forwarded_matrix_expression L, forwarded_matrix_expression R> auto hadamard_product(L&& A, R&& B)
+	{
+		return MatrixBinaryExpression<matrix_operand_t<L>, matrix_operand_t<R>, std::multiplies<>>(std::forward<L>(A), std::forward<R>(B));
+	}
+
+	// Returns the element-wise quotient of A and B.
+	// Will throw a std::invalid_argument exception if the dimensions do not match.
+	template <forwarded_matrix_expression L, forwarded_matrix_expression R> auto hadamard_quotient(L&& A, R&& B)
+	{
+		return MatrixBinaryExpression<matrix_operand_t<L>, matrix_operand_t<R>, std::divides<>>(std::forward<L>(A), std::forward<R>(B));
+	}
+
+	// Returns the matrix product of A and B.
+	// The product is computed in square blocks so that the rows of A, B
+	// and the result that are being combined stay in cache, and the inner
+	// loop runs over contiguous memory so it can be vectorized.
+	// Will throw a std::invalid_argument exception if
+	// A.colSize() != B.rowSize()
+	template <std::semiregular T> Matrix<T> matrix_product(const Matrix<T>& A, const Matrix<T>& B)
+	{
+		using size_type = std::size_t;
+
+		if (A.colSize() != B.rowSize())
+			throw std::invalid_argument("Matrix dimensions do not match");
+
+		constexpr size_type block = 64;
+
+		const size_type n = A.rowSize();
+		const size_type m = A.colSize();
+		const size_type p = B.colSize();
+
+		Matrix<T> C(n, p);
+
+		for (size_type ii = 0; ii < n; ii += block)
+		{
+			const size_type i_end = std::min(ii + block, n);
+
+			for (size_type kk = 0; kk < m; kk += block)
+			{
+				const size_type k_end = std::min(kk + block, m);
+
+				for (size_type jj = 0; jj < p; jj += block)
+				{
+					const size_type j_end = std::min(jj + block, p);
+
+					for (size_type i = ii; i < i_end; ++i)
+					{
+						T* c_row = C.data() + i * p;
+						const T* a_row = A.data() + i * m;
+
+						for (size_type k = kk; k < k_end; ++k)
+						{
+							const T a = a_row[k];
+							const T* b_row = B.data() + k * p;
+
+							for (size_type j = jj; j < j_end; ++j)
+								c_row[j] += a * b_row[j];
+						}
+					}
+				}
+			}
+		}
+
+		return C;
+	}
+
+	// Matrix multiplication operator.
+	// Returns the matrix product of A and B.
+	// Unlike the element-wise operators, this is evaluated immediately.
+	// Will throw a std::invalid_argument exception if
+	// A.colSize() != B.rowSize()
+	template <matrix_expression L, matrix_expression R> auto operator * (const L& A, const R& B)
+	{
+		using value_type = std::common_type_t<matrix_element_t<L>, matrix_element_t<R>>;
+
+		const auto& lhs = as_matrix<value_type>(A);
+		const auto& rhs = as_matrix<value_type>(B);
+
+		return matrix_product(lhs, rhs);
+	}
+
+	// Returns the transpose of A.
+	// The transpose is copied in square tiles so that both the rows read
+	// and the rows written stay in cache.
+	template <matrix_expression E> auto transpose(const E& A)
+	{
+		using value_type = matrix_element_t<E>;
+		using size_type = std::size_t;
+
+		constexpr size_type tile = 32;
+
+		const auto& src = as_matrix<value_type>(A);
+		const size_type rows = src.rowSize();
+		const size_type cols = src.colSize();
+
+		Matrix<value_type> result(cols, rows);
+
+		for (size_type rr = 0; rr < rows; rr += tile)
+		{
+			const size_type r_end = std::min(rr + tile, rows);
+
+			for (size_type cc = 0; cc < cols; cc += tile)
+			{
+				const size_type c_end = std::min(cc + tile, cols);
+
+				for (size_type r = rr; r < r_end; ++r)
+				{
+					for (size_type c = cc; c < c_end; ++c)
+						result(c, r) = src(r, c);
+				}
+			}
+		}
+
+		return result;
+	}
+
+	// Returns the sum of the elements of A.
+	// Four partial sums are kept so that consecutive additions do not
+	// depend on each other.
+	template <matrix_expression E> matrix_element_t<E> sum(const E& A)
+	{
+		using value_type = matrix_element_t<E>;
+		using size_type = std::size_t;
+
+		const size_type count = A.rowSize() * A.colSize();
+		value_type partial[4] = { };
+		size_type i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			partial[0] += A[i];
+			partial[1] += A[i + 1];
+			partial[2] += A[i + 2];
+			partial[3] += A[i + 3];
+		}
+
+		for (; i < count; ++i)
+			partial[0] += A[i];
+
+		return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+	}
+
+	// Returns the smallest element of A.
+	// Will throw a std::domain_error exception if A is empty.
+	template <matrix_expression E> matrix_element_t<E> minimum(const E& A)
+	{
+		const std::size_t count = A.rowSize() * A.colSize();
+
+		if (count == 0)
+			throw std::domain_error("Invalid argument for Jlib::minimum");
+
+		matrix_element_t<E> result = A[0];
+
+		for (std::size_t i = 1; i < count; ++i)
+			result = std::min<matrix_element_t<E>>(result, A[i]);
+
+		return result;
+	}
+
+	// Returns the largest element of A.
+	// Will throw a std::domain_error exception if A is empty.
+	template <matrix_expression E> matrix_element_t<E> maximum(const E& A)
+	{
+		const std::size_t count = A.rowSize() * A.colSize();
+
+		if (count == 0)
+			throw std::domain_error("Invalid argument for Jlib::maximum");
+
+		matrix_element_t<E> result = A[0];
+
+		for (std::size_t i = 1; i < count; ++i)
+			result = std::max<matrix_element_t<E>>(result, A[i]);
+
+		return result;
+	}
 }
 
-#endif // MATRIX_H_INCLUDED
\ No newline at end of file
+#endif // MATRIX_H_INCLUDED
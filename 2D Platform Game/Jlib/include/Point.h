@@ -2,7 +2,7 @@
 // Point.h
 // Justyn Durnford
 // Created on 2020-10-12
-// Last updated on 2021-02-24
+// Last updated on 2026-10-19
 // Header file for the Point2, Point2Fr, Point3 and Point3Fr template structs.
 
 #ifndef POINT_H_INCLUDED
@@ -42,7 +42,7 @@ namespace Jlib
 		// 2-parameter constructor.
 		// Sets the x component of the Point2 to new_x.
 		// Sets the y component of the Point2 to new_y.
-		Point2(T new_x, T new_y)
+		constexpr Point2(T new_x, T new_y)
 		{
 			x = new_x;
 			y = new_y;
@@ -182,7 +182,7 @@ namespace Jlib
 		// Sets the x component of the Point3 to new_x.
 		// Sets the y component of the Point3 to new_y.
 		// Sets the z component of the Point3 to new_z.
-		Point3(T new_x, T new_y, T new_z)
+		constexpr Point3(T new_x, T new_y, T new_z)
 		{
 			x = new_x;
 			y = new_y;
@@ -191,7 +191,7 @@ namespace Jlib
 
 		// Point2 copy constructor.
 		// Allows for the conversion from a Point2 to a Point3.
-		Point3(const Point2<T>& other)
+		constexpr Point3(const Point2<T>& other)
 		{
 			x = other.x;
 			y = other.y;
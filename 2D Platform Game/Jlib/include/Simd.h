@@ -0,0 +1,21 @@
+// Jlib
+// Simd.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file that detects and includes the available SIMD instruction sets.
+
+#ifndef SIMD_H_INCLUDED
+#define SIMD_H_INCLUDED
+
+// JLIB_SSE2 is defined when SSE2 intrinsics can be used.
+// Every x64 processor supports SSE2, so MSVC x64 builds always get it.
+// Code using the intrinsics must also provide a scalar fallback.
+#if !defined(JLIB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JLIB_SSE2
+
+#include <emmintrin.h>
+
+#endif // JLIB_SSE2
+
+#endif // SIMD_H_INCLUDED
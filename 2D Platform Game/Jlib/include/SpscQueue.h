@@ -0,0 +1,149 @@
+// Jlib
+// SpscQueue.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the SpscQueue class template.
+
+#ifndef SPSCQUEUE_H_INCLUDED
+#define SPSCQUEUE_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Jlib
+{
+	// Fixed size ring buffer passing values from exactly one producer
+	// thread to exactly one consumer thread without locks.
+	// Each side keeps its own copy of the other side's index and only
+	// reads the shared one when its copy says the queue is full or
+	// empty, so the two threads rarely touch the same cache line.
+	// Capacity must be a power of 2.
+	template <typename T, std::size_t Capacity> class SpscQueue
+	{
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue: Capacity must be a power of 2");
+
+		static constexpr std::size_t CACHE_LINE = 64;
+		static constexpr std::size_t MASK = Capacity - 1;
+
+		// Written by the consumer only.
+		alignas(CACHE_LINE) std::atomic<std::size_t> head_ = 0;
+		std::size_t cached_tail_ = 0;
+
+		// Written by the producer only.
+		alignas(CACHE_LINE) std::atomic<std::size_t> tail_ = 0;
+		std::size_t cached_head_ = 0;
+
+		alignas(CACHE_LINE) T slots_[Capacity];
+
+		public:
+
+		// Default constructor.
+		SpscQueue() = default;
+
+		// Copy constructor. Deleted.
+		SpscQueue(const SpscQueue& other) = delete;
+
+		// Move constructor. Deleted.
+		SpscQueue(SpscQueue&& other) = delete;
+
+		// Copy assignment operator. Deleted.
+		SpscQueue& operator = (const SpscQueue& other) = delete;
+
+		// Move assignment operator. Deleted.
+		SpscQueue& operator = (SpscQueue&& other) = delete;
+
+		// Destructor.
+		~SpscQueue() = default;
+
+		// Returns the most values the SpscQueue can hold.
+		static constexpr std::size_t capacity()
+		{
+			return Capacity;
+		}
+
+		// Producer only.
+		// Adds value to the back of the SpscQueue.
+		// Returns true if it was added.
+		// Returns false if the SpscQueue is full.
+		bool tryPush(const T& value)
+		{
+			const std::size_t tail = tail_.load(std::memory_order_relaxed);
+
+			if (tail - cached_head_ == Capacity)
+			{
+				cached_head_ = head_.load(std::memory_order_acquire);
+
+				if (tail - cached_head_ == Capacity)
+					return false;
+			}
+
+			slots_[tail & MASK] = value;
+			tail_.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// Consumer only.
+		// Moves the front value into value and removes it.
+		// Returns true if there was a value.
+		// Returns false if the SpscQueue is empty.
+		bool tryPop(T& value)
+		{
+			const std::size_t head = head_.load(std::memory_order_relaxed);
+
+			if (head == cached_tail_)
+			{
+				cached_tail_ = tail_.load(std::memory_order_acquire);
+
+				if (head == cached_tail_)
+					return false;
+			}
+
+			value = std::move(slots_[head & MASK]);
+			head_.store(head + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		// Consumer only.
+		// Calls function(value) for every value in the SpscQueue, front
+		// to back, then removes them all at once. Values pushed while
+		// this runs are left for the next call.
+		// Returns the amount of values removed.
+		template <typename F> std::size_t popAll(F&& function)
+		{
+			const std::size_t head = head_.load(std::memory_order_relaxed);
+			const std::size_t tail = tail_.load(std::memory_order_acquire);
+
+			cached_tail_ = tail;
+
+			for (std::size_t i = head; i != tail; ++i)
+				function(slots_[i & MASK]);
+
+			head_.store(tail, std::memory_order_release);
+
+			return tail - head;
+		}
+
+		// Returns the amount of values in the SpscQueue. Only exact when
+		// neither side is pushing or popping at the same time.
+		std::size_t size() const
+		{
+			// head is read first, so tail can only have moved further on.
+			const std::size_t head = head_.load(std::memory_order_acquire);
+			return tail_.load(std::memory_order_acquire) - head;
+		}
+
+		// Returns true if the SpscQueue holds no values, with the same
+		// caveat as size.
+		// Returns false otherwise.
+		bool empty() const
+		{
+			return size() == 0;
+		}
+	};
+}
+
+#endif // SPSCQUEUE_H_INCLUDED
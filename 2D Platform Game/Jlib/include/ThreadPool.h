@@ -0,0 +1,87 @@
+// Jlib
+// ThreadPool.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ThreadPool class.
+
+#ifndef THREADPOOL_H_INCLUDED
+#define THREADPOOL_H_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Jlib
+{
+	// Fixed set of worker threads for splitting loops across cores.
+	// The thread calling parallelFor works on the loop too, so a
+	// ThreadPool with 0 worker threads runs everything serially.
+	class ThreadPool
+	{
+		std::vector<std::thread> threads_;
+
+		std::mutex mutex_;
+		std::condition_variable start_;
+		std::condition_variable finish_;
+
+		// Current loop. Written under mutex_ before the generation changes.
+		const std::function<void(std::size_t)>* function_ = nullptr;
+		std::size_t count_ = 0;
+		std::atomic<std::size_t> next_ = 0;
+		std::size_t generation_ = 0;
+		std::size_t busy_threads_ = 0;
+		std::exception_ptr exception_;
+		bool stopping_ = false;
+
+		// Runs iterations of the current loop until none are left.
+		void work();
+
+		// Body of each worker thread.
+		void run();
+
+		public:
+
+		// Default constructor.
+		// Starts one worker thread for each hardware thread except the calling one.
+		ThreadPool();
+
+		// Thread count constructor.
+		// Starts the given amount of worker threads.
+		explicit ThreadPool(std::size_t thread_count);
+
+		// Copy constructor. Deleted.
+		ThreadPool(const ThreadPool& other) = delete;
+
+		// Move constructor. Deleted.
+		ThreadPool(ThreadPool&& other) = delete;
+
+		// Copy assignment operator. Deleted.
+		ThreadPool& operator = (const ThreadPool& other) = delete;
+
+		// Move assignment operator. Deleted.
+		ThreadPool& operator = (ThreadPool&& other) = delete;
+
+		// Destructor.
+		// Waits for the worker threads to finish.
+		~ThreadPool();
+
+		// Returns the amount of worker threads.
+		std::size_t threadCount() const;
+
+		// Calls function(i) for every i in [0, count), spread across
+		// the worker threads and the calling thread, and returns once
+		// every call has finished.
+		// If any call throws, the first exception is rethrown here
+		// after the others finish.
+		// Must not be called from inside function.
+		void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function);
+	};
+}
+
+#endif // THREADPOOL_H_INCLUDED
@@ -0,0 +1,249 @@
+// Jlib
+// Transform.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the Mat3 template struct.
+
+#ifndef TRANSFORM_H_INCLUDED
+#define TRANSFORM_H_INCLUDED
+
+#include "Angle.h"
+#include "Point.h"
+#include "Simd.h"
+#include "Vector.h"
+
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+
+namespace Jlib
+{
+	// This struct provides a 3x3 matrix used as an affine transform
+	// in two-dimensional space.
+	// The elements are stored in row-major order and points are treated
+	// as column vectors, so A * B applies B first and then A.
+	// The bottom row is expected to stay (0, 0, 1).
+	template <arithmetic T> struct Mat3
+	{
+		T m[9] = { 1, 0, 0,
+		           0, 1, 0,
+		           0, 0, 1 };
+
+		// Default constructor.
+		// Creates the identity transform.
+		constexpr Mat3() = default;
+
+		// 9-T constructor.
+		// Sets the elements of the Mat3 row by row.
+		constexpr Mat3(T m00, T m01, T m02,
+		               T m10, T m11, T m12,
+		               T m20, T m21, T m22)
+		{
+			m[0] = m00; m[1] = m01; m[2] = m02;
+			m[3] = m10; m[4] = m11; m[5] = m12;
+			m[6] = m20; m[7] = m21; m[8] = m22;
+		}
+
+		// Returns the identity transform.
+		static constexpr Mat3 identity()
+		{
+			return Mat3();
+		}
+
+		// Returns a transform that moves points by (x, y).
+		static constexpr Mat3 translation(T x, T y)
+		{
+			return Mat3(1, 0, x,
+			            0, 1, y,
+			            0, 0, 1);
+		}
+
+		// Returns a transform that scales points by (x, y) around the origin.
+		static constexpr Mat3 scale(T x, T y)
+		{
+			return Mat3(x, 0, 0,
+			            0, y, 0,
+			            0, 0, 1);
+		}
+
+		// Returns a transform that rotates points around the origin, given
+		// the cosine and sine of the angle of rotation.
+		static constexpr Mat3 rotation(T cos_value, T sin_value)
+		{
+			return Mat3(cos_value, -sin_value, 0,
+			            sin_value,  cos_value, 0,
+			            0,          0,         1);
+		}
+
+		// Returns a transform that rotates points around the origin by ang.
+		static Mat3 rotation(const Angle& ang)
+		{
+			return rotation(T(Jlib::cos(ang)), T(Jlib::sin(ang)));
+		}
+
+		// Returns a transform that rotates points around the origin, given
+		// the cosine and sine of the angle of rotation, and then moves them
+		// by (x, y).
+		// Equal to translation(x, y) * rotation(cos_value, sin_value), without
+		// the multiplications by 0 and 1 the product would make.
+		static constexpr Mat3 rotationTranslation(T cos_value, T sin_value, T x, T y)
+		{
+			return Mat3(cos_value, -sin_value, x,
+			            sin_value,  cos_value, y,
+			            0,          0,         1);
+		}
+
+		// Returns a reference to the element at the position [row][col].
+		constexpr T& operator () (std::size_t row, std::size_t col)
+		{
+			return m[row * 3 + col];
+		}
+
+		// Returns a const reference to the element at the position [row][col].
+		constexpr const T& operator () (std::size_t row, std::size_t col) const
+		{
+			return m[row * 3 + col];
+		}
+
+		// Returns the given Point2 with the transform applied.
+		constexpr Point2<T> transformPoint(const Point2<T>& P) const
+		{
+			return Point2<T>(m[0] * P.x + m[1] * P.y + m[2],
+			                 m[3] * P.x + m[4] * P.y + m[5]);
+		}
+
+		// Returns the given Vector2 with the transform applied.
+		// Translation does not affect vectors.
+		constexpr Vector2<T> transformVector(const Vector2<T>& V) const
+		{
+			return Vector2<T>(m[0] * V.x + m[1] * V.y,
+			                  m[3] * V.x + m[4] * V.y);
+		}
+
+		// Returns the determinant of the Mat3.
+		constexpr T determinant() const
+		{
+			return m[0] * (m[4] * m[8] - m[5] * m[7])
+			     - m[1] * (m[3] * m[8] - m[5] * m[6])
+			     + m[2] * (m[3] * m[7] - m[4] * m[6]);
+		}
+
+		// Returns the inverse of the Mat3.
+		// Will throw a std::domain_error exception if
+		// determinant() == 0
+		constexpr Mat3 inverse() const requires std::floating_point<T>
+		{
+			const T det = determinant();
+
+			if (det == 0)
+				throw std::domain_error("Invalid argument for Jlib::Mat3::inverse");
+
+			const T inv = T(1) / det;
+
+			return Mat3((m[4] * m[8] - m[5] * m[7]) * inv,
+			            (m[2] * m[7] - m[1] * m[8]) * inv,
+			            (m[1] * m[5] - m[2] * m[4]) * inv,
+			            (m[5] * m[6] - m[3] * m[8]) * inv,
+			            (m[0] * m[8] - m[2] * m[6]) * inv,
+			            (m[2] * m[3] - m[0] * m[5]) * inv,
+			            (m[3] * m[7] - m[4] * m[6]) * inv,
+			            (m[1] * m[6] - m[0] * m[7]) * inv,
+			            (m[0] * m[4] - m[1] * m[3]) * inv);
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                    GLOBAL OPERATORS                                   //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Multiplication operator.
+	// Returns the transform that applies B and then A.
+	template <arithmetic T> constexpr Mat3<T> operator * (const Mat3<T>& A, const Mat3<T>& B)
+	{
+		Mat3<T> C;
+
+		for (std::size_t r = 0; r < 3; ++r)
+		{
+			for (std::size_t c = 0; c < 3; ++c)
+				C.m[r * 3 + c] = A.m[r * 3] * B.m[c] + A.m[r * 3 + 1] * B.m[3 + c] + A.m[r * 3 + 2] * B.m[6 + c];
+		}
+
+		return C;
+	}
+
+	// Equality comparison operator.
+	// Returns true if every element of A equals the matching element of B.
+	// Returns false otherwise.
+	template <arithmetic T> constexpr bool operator == (const Mat3<T>& A, const Mat3<T>& B)
+	{
+		for (std::size_t i = 0; i < 9; ++i)
+		{
+			if (A.m[i] != B.m[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                    GLOBAL FUNCTIONS                                   //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Writes M.transformPoint(in[i]) to out[i] for every i < count.
+	// in and out may be the same array.
+	template <arithmetic T> void transform_points(const Mat3<T>& M, const Point2<T>* in, Point2<T>* out, std::size_t count)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SSE2
+		if constexpr (std::same_as<T, float>)
+		{
+			static_assert(sizeof(Point2<float>) == 2 * sizeof(float));
+
+			// 2 points per register: (x0, y0, x1, y1).
+			const __m128 col_x = _mm_setr_ps(M.m[0], M.m[3], M.m[0], M.m[3]);
+			const __m128 col_y = _mm_setr_ps(M.m[1], M.m[4], M.m[1], M.m[4]);
+			const __m128 col_t = _mm_setr_ps(M.m[2], M.m[5], M.m[2], M.m[5]);
+
+			for (; i + 2 <= count; i += 2)
+			{
+				const __m128 xy = _mm_loadu_ps(reinterpret_cast<const float*>(in + i));
+				const __m128 xx = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));
+				const __m128 yy = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));
+
+				__m128 result = _mm_add_ps(_mm_mul_ps(xx, col_x), _mm_mul_ps(yy, col_y));
+				result = _mm_add_ps(result, col_t);
+				_mm_storeu_ps(reinterpret_cast<float*>(out + i), result);
+			}
+		}
+		#endif // JLIB_SSE2
+
+		for (; i < count; ++i)
+			out[i] = M.transformPoint(in[i]);
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	//////                                        TYPEDEFS                                       //////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Expands to Mat3<float>
+	typedef Mat3<float> Mat3f;
+
+	// Expands to Mat3<double>
+	typedef Mat3<double> Mat3d;
+}
+
+#endif // TRANSFORM_H_INCLUDED
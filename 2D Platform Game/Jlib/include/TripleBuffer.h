@@ -0,0 +1,104 @@
+// Jlib
+// TripleBuffer.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the TripleBuffer class template.
+
+#ifndef TRIPLEBUFFER_H_INCLUDED
+#define TRIPLEBUFFER_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+
+namespace Jlib
+{
+	// Three values handed from one writer thread to one reader thread
+	// without locks or copies. The writer fills the back value and
+	// publishes it; the reader takes the newest published value as its
+	// front. Neither side ever waits for the other: the third value sits
+	// between them, and a value published again before the reader takes
+	// it is overwritten, so the reader always gets the newest.
+	// The values are reused, so containers in them keep their memory.
+	template <typename T> class TripleBuffer
+	{
+		static constexpr std::uint8_t INDEX_MASK = 3;
+
+		// Set in middle_ while it holds a value the reader has not taken.
+		static constexpr std::uint8_t NEW_BIT = 4;
+
+		T values_[3];
+
+		// Shared: index of the middle value, and NEW_BIT.
+		std::atomic<std::uint8_t> middle_ = 1;
+
+		// Writer only.
+		std::uint8_t back_ = 0;
+
+		// Reader only.
+		std::uint8_t front_ = 2;
+
+		public:
+
+		// Default constructor.
+		TripleBuffer() = default;
+
+		// Copy constructor. Deleted.
+		TripleBuffer(const TripleBuffer& other) = delete;
+
+		// Move constructor. Deleted.
+		TripleBuffer(TripleBuffer&& other) = delete;
+
+		// Copy assignment operator. Deleted.
+		TripleBuffer& operator = (const TripleBuffer& other) = delete;
+
+		// Move assignment operator. Deleted.
+		TripleBuffer& operator = (TripleBuffer&& other) = delete;
+
+		// Destructor.
+		~TripleBuffer() = default;
+
+		// Writer only.
+		// Returns the value to fill before the next publish. It holds
+		// whatever was written to it some publishes ago.
+		T& back()
+		{
+			return values_[back_];
+		}
+
+		// Writer only.
+		// Hands the back value to the reader.
+		// Returns true if this replaced a value the reader never took.
+		// Returns false otherwise.
+		bool publish()
+		{
+			const std::uint8_t previous = middle_.exchange(back_ | NEW_BIT, std::memory_order_acq_rel);
+			back_ = previous & INDEX_MASK;
+
+			return (previous & NEW_BIT) != 0;
+		}
+
+		// Reader only.
+		// Makes the newest published value the front one, if there is
+		// one the reader has not taken.
+		// Returns true if the front value changed.
+		// Returns false otherwise.
+		bool update()
+		{
+			if ((middle_.load(std::memory_order_relaxed) & NEW_BIT) == 0)
+				return false;
+
+			front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+			return true;
+		}
+
+		// Reader only.
+		// Returns the value taken by the last update.
+		const T& front() const
+		{
+			return values_[front_];
+		}
+	};
+}
+
+#endif // TRIPLEBUFFER_H_INCLUDED
@@ -2,7 +2,7 @@
 // Vector.h
 // Justyn Durnford
 // Created on 2020-10-12
-// Last updated on 2021-02-24
+// Last updated on 2026-10-19
 // Header file for the Vector2, Vector2Fr, Vector3 and Vector3Fr template structs.
 
 #ifndef VECTOR_H_INCLUDED
@@ -15,9 +15,37 @@
 
 #include "Angle.h"
 #include "Point.h"
+#include "Simd.h"
+
+#include <concepts>
+#include <type_traits>
 
 namespace Jlib
 {
+	// Expands to T for floating-point types and to double otherwise.
+	// Lengths and projections are computed in this type, so float
+	// vectors stay in float instead of being promoted to double.
+	template <arithmetic T> using real_t = std::conditional_t<std::floating_point<T>, T, double>;
+
+	// Returns an approximation of 1 / std::sqrt(value) for value > 0.
+	// Uses the SSE reciprocal square root estimate refined by one
+	// Newton-Raphson step, giving a relative error below 1e-6.
+	inline float fast_inverse_sqrt(float value)
+	{
+		#ifdef JLIB_SSE2
+		const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+		return estimate * (1.5f - 0.5f * value * estimate * estimate);
+		#else
+		return 1.0f / std::sqrt(value);
+		#endif // JLIB_SSE2
+	}
+
+	// Returns 1 / std::sqrt(value).
+	inline double fast_inverse_sqrt(double value)
+	{
+		return 1.0 / std::sqrt(value);
+	}
+
 	// This struct provides a representation of a mathematical 
 	// vector in two-dimensional space.
 	template <arithmetic T> struct Vector2
@@ -39,7 +67,7 @@ namespace Jlib
 		// 2-T constructor.
 		// Sets the x component of the Vector2 to new_x.
 		// Sets the y component of the Vector2 to new_y.
-		Vector2(T new_x, T new_y)
+		constexpr Vector2(T new_x, T new_y)
 		{
 			x = new_x;
 			y = new_y;
@@ -48,16 +76,32 @@ namespace Jlib
 		// Angle constructor.
 		// Sets the x component of the Vector2 to magnitude * cos(ang).
 		// Sets the y component of the Vector2 to magnitude * sin(ang).
+		// Vector2f uses Jlib::fast_sincos on the wrapped angle, which is
+		// accurate to float precision for an Angle of any size.
 		Vector2(const Angle& ang, T magnitude)
 		{
-			x = T(magnitude * Jlib::cos(ang));
-			y = T(magnitude * Jlib::sin(ang));
+			if constexpr (std::same_as<T, float>)
+			{
+				float sin_value, cos_value;
+				Jlib::fast_sincos(Jlib::wrapped_radians(ang), sin_value, cos_value);
+
+				x = magnitude * cos_value;
+				y = magnitude * sin_value;
+			}
+			else
+			{
+				double sin_value, cos_value;
+				Jlib::sincos(ang, sin_value, cos_value);
+
+				x = T(magnitude * cos_value);
+				y = T(magnitude * sin_value);
+			}
 		}
 
 		// 1-Point2 constructor.
 		// Sets the x component of the Vector2 to P.x.
 		// Sets the y component of the Vector2 to P.y.
-		Vector2(const Point2<T>& P)
+		constexpr Vector2(const Point2<T>& P)
 		{
 			x = P.x;
 			y = P.y;
@@ -66,7 +110,7 @@ namespace Jlib
 		// 2-Point2 constructor.
 		// Creates the Vector2 as the displacement vector from
 		// the Point2 P to the Point2 Q.
-		Vector2(const Point2<T>& P, const Point2<T>& Q)
+		constexpr Vector2(const Point2<T>& P, const Point2<T>& Q)
 		{
 			x = Q.x - P.x;
 			y = Q.y - P.y;
@@ -86,7 +130,7 @@ namespace Jlib
 
 		// Sets the x component of the Vector2 to new_x.
 		// Sets the y component of the Vector2 to new_y.
-		void setAll(T new_x, T new_y)
+		constexpr void setAll(T new_x, T new_y)
 		{
 			x = new_x;
 			y = new_y;
@@ -94,16 +138,27 @@ namespace Jlib
 
 		// Sets the x component of the Vector2 to P.x
 		// Sets the y component of the Vector2 to P.y
-		void setAll(const Point2<T>& P)
+		constexpr void setAll(const Point2<T>& P)
 		{
 			x = P.x;
 			y = P.y;
 		}
 
+		// Returns the square of the magnitude of the Vector2.
+		// Prefer this over magnitude() when only comparing lengths.
+		constexpr T lengthSquared() const
+		{
+			return x * x + y * y;
+		}
+
 		// Returns the magnitude of the Vector2.
-		double magnitude() const
+		// Computed in T for floating-point types and in double otherwise.
+		real_t<T> magnitude() const
 		{
-			return std::sqrt(std::pow(x, 2) + std::pow(y, 2));
+			const real_t<T> rx = x;
+			const real_t<T> ry = y;
+
+			return std::sqrt(rx * rx + ry * ry);
 		}
 
 		// Returns the angle between the Vector2 and the x-axis.
@@ -113,20 +168,37 @@ namespace Jlib
 		}
 
 		// Returns the endpoint of the Vector2.
-		Point2<T> endpoint() const
+		constexpr Point2<T> endpoint() const
 		{
 			return Point2<T>(x, y);
 		}
 
 		// Returns a unit vector in the direction of the Vector2.
-		Vector2<double> unitVector() const
+		// Computed in T for floating-point types and in double otherwise.
+		Vector2<real_t<T>> unitVector() const
 		{
-			double m = magnitude();
-			return Vector2<double>(x / m, y / m);
+			const real_t<T> m = magnitude();
+			return Vector2<real_t<T>>(x / m, y / m);
+		}
+
+		// Returns an approximate unit vector in the direction of the Vector2,
+		// multiplying by Jlib::fast_inverse_sqrt instead of dividing by the magnitude.
+		// Returns the zero vector if the Vector2 is the zero vector.
+		// To normalize an array of Vector2f, use Jlib::fast_normalize instead:
+		// called once per vector in a loop, this is no faster than unitVector().
+		Vector2 fastUnitVector() const requires std::floating_point<T>
+		{
+			const T length_squared = lengthSquared();
+
+			if (length_squared == 0)
+				return Vector2();
+
+			const T inverse = fast_inverse_sqrt(length_squared);
+			return Vector2(x * inverse, y * inverse);
 		}
 
 		// Clears the values of the Vector2.
-		void clear()
+		constexpr void clear()
 		{
 			x = 0;
 			y = 0;
@@ -141,7 +213,7 @@ namespace Jlib
 		// Addition assignment operator.
 		// Adds the components of the given Vector2 V onto the
 		// corresponding components of this Vector2.
-		Vector2& operator += (const Vector2& V)
+		constexpr Vector2& operator += (const Vector2& V)
 		{
 			x += V.x;
 			y += V.y;
@@ -152,7 +224,7 @@ namespace Jlib
 		// Subtraction assignment operator.
 		// Subtracts the components of the given Vector2 V from the
 		// corresponding components of this Vector2.
-		Vector2& operator -= (const Vector2& V)
+		constexpr Vector2& operator -= (const Vector2& V)
 		{
 			x -= V.x;
 			y -= V.y;
@@ -162,7 +234,7 @@ namespace Jlib
 
 		// Multiplication assignment operator.
 		// Multiplies the components of this Vector2 by value.
-		template <arithmetic Ty> Vector2& operator *= (Ty value)
+		template <arithmetic Ty> constexpr Vector2& operator *= (Ty value)
 		{
 			x *= value;
 			y *= value;
@@ -172,7 +244,7 @@ namespace Jlib
 
 		// Division assignment operator.
 		// Divides the components of this Vector2 by value.
-		template <arithmetic Ty> Vector2& operator /= (Ty value)
+		template <arithmetic Ty> constexpr Vector2& operator /= (Ty value)
 		{
 			x /= value;
 			y /= value;
@@ -333,7 +405,7 @@ namespace Jlib
 
 		// Multiplication assignment operator.
 		// Multiplies the components of this Vector2Fr by value.
-		template <arithmetic T> Vector2Fr& operator *= (T value)
+		template <arithmetic Ty> Vector2Fr& operator *= (Ty value)
 		{
 			x *= value;
 			y *= value;
@@ -343,7 +415,7 @@ namespace Jlib
 
 		// Division assignment operator.
 		// Divides the components of this Vector2Fr by value.
-		template <arithmetic T> Vector2Fr& operator /= (T value)
+		template <arithmetic Ty> Vector2Fr& operator /= (Ty value)
 		{
 			x /= value;
 			y /= value;
@@ -393,7 +465,7 @@ namespace Jlib
 
 		// Vector2 copy constructor.
 		// Allows for the conversion from a Vector2 to a Vector3.
-		Vector3(const Vector2<T>& other)
+		constexpr Vector3(const Vector2<T>& other)
 		{
 			x = other.x;
 			y = other.y;
@@ -412,7 +484,7 @@ namespace Jlib
 		// Sets the x component of the Vector3 to new_x.
 		// Sets the y component of the Vector3 to new_y.
 		// Sets the z component of the Vector3 to new_z.
-		Vector3(T new_x, T new_y, T new_z)
+		constexpr Vector3(T new_x, T new_y, T new_z)
 		{
 			x = new_x;
 			y = new_y;
@@ -422,7 +494,7 @@ namespace Jlib
 		// 1-Point2 constructor.
 		// Sets the x component of the Vector3 to P.x.
 		// Sets the y component of the Vector3 to P.y.
-		Vector3(const Point2<T>& P)
+		constexpr Vector3(const Point2<T>& P)
 		{
 			x = P.x;
 			y = P.y;
@@ -433,7 +505,7 @@ namespace Jlib
 		// Sets the x component of the Vector3 to P.x.
 		// Sets the y component of the Vector3 to P.y.
 		// Sets the z component of the Vector3 to P.z.
-		Vector3(const Point3<T>& P)
+		constexpr Vector3(const Point3<T>& P)
 		{
 			x = P.x;
 			y = P.y;
@@ -443,7 +515,7 @@ namespace Jlib
 		// 2-Point2 constructor.
 		// Creates the Vector3 as the displacement vector from
 		// the Point2 P to the Point2 Q.
-		Vector3(const Point2<T>& P, const Point2<T>& Q)
+		constexpr Vector3(const Point2<T>& P, const Point2<T>& Q)
 		{
 			x = Q.x - P.x;
 			y = Q.y - P.y;
@@ -453,7 +525,7 @@ namespace Jlib
 		// 2-Point3 constructor.
 		// Creates the Vector3 as the displacement vector from
 		// the Point3 P to the Point3 Q.
-		Vector3(const Point3<T>& P, const Point3<T>& Q)
+		constexpr Vector3(const Point3<T>& P, const Point3<T>& Q)
 		{
 			x = Q.x - P.x;
 			y = Q.y - P.y;
@@ -722,7 +794,7 @@ namespace Jlib
 		Vector3<double> unitVector() const
 		{
 			double m = magnitude();
-			return Vector3Fr<double>(double(x.evaluate()) / m, double(y.evaluate()) / m, double(z.evaluate()) / m);
+			return Vector3<double>(double(x.evaluate()) / m, double(y.evaluate()) / m, double(z.evaluate()) / m);
 		}
 
 		// Clears the values of the Vector3Fr.
@@ -809,25 +881,25 @@ namespace Jlib
 	/////////////////////////////////////////////////////////////////////////////////////////////////// 
 
 	// Addition operator.
-	template <arithmetic T> Vector2<T> operator + (const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr Vector2<T> operator + (const Vector2<T>& V, const Vector2<T>& U)
 	{
 		return Vector2<T>(V.x + U.x, V.y + U.y);
 	}
 
 	// Subtraction operator.
-	template <arithmetic T> Vector2<T> operator - (const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr Vector2<T> operator - (const Vector2<T>& V, const Vector2<T>& U)
 	{
 		return Vector2<T>(V.x - U.x, V.y - U.y);
 	}
 
 	// Multiplication operator.
-	template <arithmetic T> Vector2<T> operator * (const Vector2<T>& V, const T& value)
+	template <arithmetic T> constexpr Vector2<T> operator * (const Vector2<T>& V, const T& value)
 	{
 		return Vector2<T>(V.x * value, V.y * value);
 	}
 
 	// Division operator.
-	template <arithmetic T> Vector2<T> operator / (const Vector2<T>& V, const T& value)
+	template <arithmetic T> constexpr Vector2<T> operator / (const Vector2<T>& V, const T& value)
 	{
 		return Vector2<T>(V.x / value, V.y / value);
 	}
@@ -838,7 +910,7 @@ namespace Jlib
 	//  - V.x == U.x AND
 	//  - V.y == U.y
 	// Returns false otherwise.
-	template <arithmetic T> bool operator == (const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr bool operator == (const Vector2<T>& V, const Vector2<T>& U)
 	{
 		if (V.x != U.x)
 			return false;
@@ -855,7 +927,7 @@ namespace Jlib
 	//  - V.x != U.x OR
 	//  - V.y != U.y
 	// Returns false otherwise.
-	template <arithmetic T> bool operator != (const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr bool operator != (const Vector2<T>& V, const Vector2<T>& U)
 	{
 		if (V.x != U.x)
 			return true;
@@ -1125,28 +1197,69 @@ namespace Jlib
 	// Determines if the 2 given Vector2s are orthogonal to eachother.
 	// Returns true if dot_product(V, U) == 0.
 	// Returns false otherwise.
-	template <arithmetic T> bool are_normal(const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr bool are_normal(const Vector2<T>& V, const Vector2<T>& U)
 	{
 		return dot_product(V, U) == 0;
 	}
 
 	// Returns the dot product of the 2 given Vector2s.
-	template <arithmetic T> T dot_product(const Vector2<T>& V, const Vector2<T>& U)
+	template <arithmetic T> constexpr T dot_product(const Vector2<T>& V, const Vector2<T>& U)
 	{
 		return ( V.x * U.x + V.y * U.y );
 	}
 
 	// Returns the scalar projection of U onto V.
-	template <arithmetic T> double scalar_proj(const Vector2<T>& V, const Vector2<T>& U)
+	// Computed in T for floating-point types and in double otherwise.
+	template <arithmetic T> real_t<T> scalar_proj(const Vector2<T>& V, const Vector2<T>& U)
 	{
-		return dot_product(V, U) / V.magnitude();
+		return real_t<T>(dot_product(V, U)) / V.magnitude();
 	}
 
 	// Returns the vector projection of U onto V.
-	template <arithmetic T> Vector2<double> vector_proj(const Vector2<T>& V, const Vector2<T>& U)
+	// Computed in T for floating-point types and in double otherwise.
+	template <arithmetic T> constexpr Vector2<real_t<T>> vector_proj(const Vector2<T>& V, const Vector2<T>& U)
 	{
-		double d = ( dot_product(V, U) * 1.0 / dot_product(V, V) * 1.0 );
-		return Vector2<double>(V.x * d, V.y * d);
+		const real_t<T> d = real_t<T>(dot_product(V, U)) / real_t<T>(dot_product(V, V));
+		return Vector2<real_t<T>>(V.x * d, V.y * d);
+	}
+
+	// Replaces every Vector2f in the given array with vectors[i].fastUnitVector().
+	// Uses SSE2 when it is available, 4 vectors at a time.
+	inline void fast_normalize(Vector2<float>* vectors, std::size_t count)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SSE2
+		static_assert(sizeof(Vector2<float>) == 2 * sizeof(float));
+
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 three_halves = _mm_set1_ps(1.5f);
+
+		for (; i + 4 <= count; i += 4)
+		{
+			float* data = reinterpret_cast<float*>(vectors + i);
+			const __m128 a = _mm_loadu_ps(data);
+			const __m128 b = _mm_loadu_ps(data + 4);
+
+			// (x0, y0, x1, y1), (x2, y2, x3, y3) -> (x0, x1, x2, x3), (y0, y1, y2, y3)
+			__m128 xs = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+			__m128 ys = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+			const __m128 length_squared = _mm_add_ps(_mm_mul_ps(xs, xs), _mm_mul_ps(ys, ys));
+			const __m128 estimate = _mm_rsqrt_ps(length_squared);
+			__m128 inverse = _mm_mul_ps(estimate, _mm_sub_ps(three_halves, _mm_mul_ps(_mm_mul_ps(half, length_squared), _mm_mul_ps(estimate, estimate))));
+			inverse = _mm_and_ps(inverse, _mm_cmpneq_ps(length_squared, _mm_setzero_ps()));
+
+			xs = _mm_mul_ps(xs, inverse);
+			ys = _mm_mul_ps(ys, inverse);
+
+			_mm_storeu_ps(data, _mm_unpacklo_ps(xs, ys));
+			_mm_storeu_ps(data + 4, _mm_unpackhi_ps(xs, ys));
+		}
+		#endif // JLIB_SSE2
+
+		for (; i < count; ++i)
+			vectors[i] = vectors[i].fastUnitVector();
 	}
 
 	template <arithmetic T> void print(const Vector2<T>& V)
@@ -2,13 +2,42 @@
 // Angle.cpp
 // Justyn Durnford
 // Created on 2021-01-17
-// Last updated on 2021-02-09
+// Last updated on 2026-10-19
 // Source file for the Angle class.
 
 #include "Angle.h"
+#include "Simd.h"
 
+#include <bit>
+#include <cstdint>
 #include <stdexcept>
 
+namespace
+{
+	// Cody-Waite split of pi/4 for the range reduction of the fast functions.
+	// DP1 and DP2 have few enough bits that y * DP1 and y * DP2 are exact.
+	constexpr float FOUR_OVER_PI = 1.27323954473516f;
+	constexpr float DP1 = 0.78515625f;
+	constexpr float DP2 = 2.4187564849853515625e-4f;
+	constexpr float DP3 = 3.77489497744594108e-8f;
+
+	// Largest |radians| whose quadrant fits in an int32 with room to round up.
+	constexpr float MAX_QUADRANT_RADIANS = 1073741824.0f / FOUR_OVER_PI;
+
+	// 1.5 * 2^52: doubles around it are whole numbers, so adding it rounds
+	// to one, for values below 2^51 in magnitude.
+	constexpr double ROUNDING_MAGIC = 6755399441055744.0;
+	constexpr double ROUNDING_LIMIT = 2251799813685248.0;
+
+	// Minimax coefficients for sin(z) and cos(z) on [-pi/4, pi/4].
+	constexpr float SIN_C1 = -1.9515295891e-4f;
+	constexpr float SIN_C2 = 8.3321608736e-3f;
+	constexpr float SIN_C3 = -1.6666654611e-1f;
+	constexpr float COS_C1 = 2.443315711809948e-5f;
+	constexpr float COS_C2 = -1.388731625493765e-3f;
+	constexpr float COS_C3 = 4.166664568298827e-2f;
+}
+
 Jlib::Angle::Angle(double value)
 	: value_(value) {}
 
@@ -28,6 +57,11 @@ void Jlib::Angle::setValue(double value)
 	value_ = value;
 }
 
+double Jlib::Angle::radians() const
+{
+	return toRad(value_);
+}
+
 std::string Jlib::Angle::toString() const
 {
 	return std::to_string(value_) + '\370';
@@ -200,6 +234,14 @@ double Jlib::sin(const Angle& ang)
 	return std::sin(toRad(ang.value()));
 }
 
+void Jlib::sincos(const Angle& ang, double& sin_value, double& cos_value)
+{
+	const double rad = toRad(ang.value());
+
+	sin_value = std::sin(rad);
+	cos_value = std::cos(rad);
+}
+
 double Jlib::tan(const Angle& ang)
 {
 	if (std::fmod(ang.value(), 90.0) == 0 && std::fmod(ang.value() / 90.0, 2.0) != 0)
@@ -229,6 +271,160 @@ Jlib::Angle Jlib::arctan(double d)
 	return Angle(toDeg(std::atan(d)));
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//////                                  FAST TRIG FUNCTIONS                                  //////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+float Jlib::wrapped_radians(const Angle& ang)
+{
+	const double degrees = ang.value();
+	const double turns = degrees * (1.0 / 360.0);
+
+	// NaN and infinities come out as NaN, through std::remainder.
+	if (!(std::fabs(turns) < ROUNDING_LIMIT))
+		return float(std::remainder(degrees, 360.0) * (M_PI / 180.0));
+
+	// Adding and subtracting ROUNDING_MAGIC rounds turns to the nearest
+	// whole number without a branch that random angles would mispredict.
+	const double whole_turns = (turns + ROUNDING_MAGIC) - ROUNDING_MAGIC;
+
+	return float((degrees - 360.0 * whole_turns) * (M_PI / 180.0));
+}
+
+float Jlib::fast_sin(float radians)
+{
+	float sin_value, cos_value;
+	fast_sincos(radians, sin_value, cos_value);
+
+	return sin_value;
+}
+
+float Jlib::fast_cos(float radians)
+{
+	float sin_value, cos_value;
+	fast_sincos(radians, sin_value, cos_value);
+
+	return cos_value;
+}
+
+void Jlib::fast_sincos(float radians, float& sin_value, float& cos_value)
+{
+	// radians = j * pi/4 + z with j even and |z| <= pi/4.
+	// sin is odd and cos is even, so reduce |radians| and fix the sign after.
+	const float x = std::fabs(radians);
+
+	// Past 2^30 / (4 / pi) the quadrant does not fit the conversion
+	// below, which is undefined for it and for NaN.
+	if (!(x <= MAX_QUADRANT_RADIANS))
+	{
+		sin_value = std::sin(radians);
+		cos_value = std::cos(radians);
+		return;
+	}
+
+	std::int32_t j = std::int32_t(x * FOUR_OVER_PI);
+	j = (j + 1) & ~1;
+
+	const float y = float(j);
+	const float z = ((x - y * DP1) - y * DP2) - y * DP3;
+	const float zz = z * z;
+
+	const float s = ((SIN_C1 * zz + SIN_C2) * zz + SIN_C3) * zz * z + z;
+	const float c = ((COS_C1 * zz + COS_C2) * zz + COS_C3) * zz * zz - 0.5f * zz + 1.0f;
+
+	// Quadrants 1 and 3 swap the polynomials, and sin is negated in
+	// quadrants 2 and 3, cos in quadrants 1 and 2. The quadrant of random
+	// angles is unpredictable, so this is done on the bits instead of branching.
+	const std::uint32_t quadrant = std::uint32_t(j >> 1) & 3;
+	const std::uint32_t swap = 0u - (quadrant & 1);
+	const std::uint32_t s_bits = std::bit_cast<std::uint32_t>(s);
+	const std::uint32_t c_bits = std::bit_cast<std::uint32_t>(c);
+	const std::uint32_t sin_sign = ((quadrant & 2) << 30) ^ (std::bit_cast<std::uint32_t>(radians) & 0x80000000u);
+	const std::uint32_t cos_sign = ((quadrant + 1) & 2) << 30;
+
+	sin_value = std::bit_cast<float>(((c_bits & swap) | (s_bits & ~swap)) ^ sin_sign);
+	cos_value = std::bit_cast<float>(((s_bits & swap) | (c_bits & ~swap)) ^ cos_sign);
+}
+
+void Jlib::fast_sincos(const float* radians, float* sin_values, float* cos_values, std::size_t count)
+{
+	std::size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	// Same algorithm as the scalar version, with the quadrant
+	// selection done by masks instead of a switch.
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(std::int32_t(0x80000000u)));
+	const __m128i one = _mm_set1_epi32(1);
+	const __m128i two = _mm_set1_epi32(2);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128 v = _mm_loadu_ps(radians + i);
+		const __m128 x = _mm_and_ps(v, abs_mask);
+		const __m128 input_sign = _mm_and_ps(v, sign_mask);
+
+		__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(FOUR_OVER_PI)));
+		j = _mm_andnot_si128(one, _mm_add_epi32(j, one));
+
+		const __m128 y = _mm_cvtepi32_ps(j);
+		__m128 z = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(DP1)));
+		z = _mm_sub_ps(z, _mm_mul_ps(y, _mm_set1_ps(DP2)));
+		z = _mm_sub_ps(z, _mm_mul_ps(y, _mm_set1_ps(DP3)));
+		const __m128 zz = _mm_mul_ps(z, z);
+
+		__m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C1), zz), _mm_set1_ps(SIN_C2));
+		s = _mm_add_ps(_mm_mul_ps(s, zz), _mm_set1_ps(SIN_C3));
+		s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, zz), z), z);
+
+		__m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C1), zz), _mm_set1_ps(COS_C2));
+		c = _mm_add_ps(_mm_mul_ps(c, zz), _mm_set1_ps(COS_C3));
+		c = _mm_mul_ps(_mm_mul_ps(c, zz), zz);
+		c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(_mm_set1_ps(0.5f), zz)), _mm_set1_ps(1.0f));
+
+		// Quadrants 1 and 3 swap the polynomials.
+		const __m128i quadrant = _mm_srli_epi32(j, 1);
+		const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, one), one));
+		__m128 sin_result = _mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s));
+		__m128 cos_result = _mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c));
+
+		// sin is negated in quadrants 2 and 3, cos in quadrants 1 and 2.
+		const __m128 sin_flip = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, two), 30));
+		const __m128 cos_flip = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, one), two), 30));
+
+		sin_result = _mm_xor_ps(sin_result, _mm_xor_ps(sin_flip, input_sign));
+		cos_result = _mm_xor_ps(cos_result, cos_flip);
+
+		_mm_storeu_ps(sin_values + i, sin_result);
+		_mm_storeu_ps(cos_values + i, cos_result);
+	}
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+		fast_sincos(radians[i], sin_values[i], cos_values[i]);
+}
+
+void Jlib::fast_sincos(const Angle* angles, float* sin_values, float* cos_values, std::size_t count)
+{
+	// Converted in blocks so the radians stay on the stack.
+	constexpr std::size_t block = 256;
+	float radians[block];
+
+	for (std::size_t start = 0; start < count; start += block)
+	{
+		const std::size_t size = (count - start < block) ? count - start : block;
+
+		for (std::size_t i = 0; i < size; ++i)
+			radians[i] = wrapped_radians(angles[start + i]);
+
+		fast_sincos(radians, sin_values + start, cos_values + start, size);
+	}
+}
+
 void Jlib::print(const Jlib::Angle& ang)
 {
 	std::cout << ang;
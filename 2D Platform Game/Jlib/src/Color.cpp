@@ -2,13 +2,23 @@
 // Color.cpp
 // Justyn Durnford
 // Created on 2020-10-12
-// Last updated on 2021-02-09
+// Last updated on 2026-10-19
 // Source file for the Color class.
 
 #include "Color.h"
+#include "Simd.h"
+
+#include <algorithm>
+#include <bit>
+
+// <cstddef>
+using std::size_t;
 
 // <cstdint>
+using std::int16_t;
+using std::int32_t;
 using std::uint8_t;
+using std::uint32_t;
 
 // <iostream>
 using std::ostream;
@@ -19,6 +29,69 @@ using std::endl;
 using std::string;
 using std::to_string;
 
+namespace
+{
+	// Returns x / 255 rounded to nearest, for x up to 255 * 255.
+	constexpr uint32_t div_255(uint32_t x)
+	{
+		x += 128;
+		return (x + (x >> 8)) >> 8;
+	}
+
+	// Returns the given integer with its bytes in reverse order,
+	// which converts between the memory order of a Color and 0xRRGGBBAA.
+	constexpr uint32_t reverse_bytes(uint32_t x)
+	{
+		return (x << 24) | ((x << 8) & 0x00FF0000u) | ((x >> 8) & 0x0000FF00u) | (x >> 24);
+	}
+
+	#ifdef JLIB_SSE2
+	// The 16-bit lane versions below work on 2 Colors widened to 8 lanes.
+
+	// Divides every 16-bit lane by 255, rounding to nearest.
+	inline __m128i div_255(__m128i x)
+	{
+		x = _mm_add_epi16(x, _mm_set1_epi16(128));
+		return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+	}
+
+	// Copies the alpha lane of each Color to its other 3 lanes.
+	inline __m128i broadcast_alpha(__m128i x)
+	{
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF);
+	}
+
+	// Replaces the alpha lane of each Color with 255.
+	inline __m128i opaque_alpha(__m128i x)
+	{
+		const __m128i alpha_lanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+		return _mm_or_si128(_mm_andnot_si128(_mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0), x), alpha_lanes);
+	}
+
+	// Runs kernel(a, b) on the 16-bit lanes of A[i] and B[i], 4 Colors
+	// at a time, storing the results in result[i]. B may be null, in
+	// which case b is 0. Returns the amount of Colors done.
+	template <typename Kernel>
+	size_t simd_colors(const Jlib::Color* A, const Jlib::Color* B, Jlib::Color* result, size_t count, const Kernel& kernel)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(A + i));
+			const __m128i b = B != nullptr ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(B + i)) : zero;
+			const __m128i low = kernel(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+			const __m128i high = kernel(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(result + i), _mm_packus_epi16(low, high));
+		}
+
+		return i;
+	}
+	#endif // JLIB_SSE2
+}
+
 Jlib::Color::Color(uint8_t new_red, uint8_t new_green, uint8_t new_blue)
 {
 	red = new_red;
@@ -35,6 +108,14 @@ Jlib::Color::Color(uint8_t new_red, uint8_t new_green, uint8_t new_blue, uint8_t
 	alpha = new_alpha;
 }
 
+Jlib::Color::Color(uint32_t rgba)
+{
+	red = uint8_t(rgba >> 24);
+	green = uint8_t(rgba >> 16);
+	blue = uint8_t(rgba >> 8);
+	alpha = uint8_t(rgba);
+}
+
 void Jlib::Color::setAll(uint8_t new_red, uint8_t new_green, uint8_t new_blue, uint8_t new_alpha)
 {
 	red = new_red;
@@ -43,6 +124,11 @@ void Jlib::Color::setAll(uint8_t new_red, uint8_t new_green, uint8_t new_blue, u
 	alpha = new_alpha;
 }
 
+uint32_t Jlib::Color::toInteger() const
+{
+	return (uint32_t(red) << 24) | (uint32_t(green) << 16) | (uint32_t(blue) << 8) | uint32_t(alpha);
+}
+
 string Jlib::Color::toString() const
 {
 	return "R: " + to_string(red) + ", G: " + to_string(green) + ", B: " + to_string(blue) + ", A: " + to_string(alpha);
@@ -50,30 +136,12 @@ string Jlib::Color::toString() const
 
 bool Jlib::operator == (const Color& A, const Color& B)
 {
-	if (A.red != B.red)
-		return false;
-
-	if (A.green != B.green)
-		return false;
-
-	if (A.blue != B.blue)
-		return false;
-
-	return true;
+	return std::bit_cast<uint32_t>(A) == std::bit_cast<uint32_t>(B);
 }
 
 bool Jlib::operator != (const Color& A, const Color& B)
 {
-	if (A.red != B.red)
-		return true;
-
-	if (A.green != B.green)
-		return true;
-
-	if (A.blue != B.blue)
-		return true;
-
-	return false;
+	return std::bit_cast<uint32_t>(A) != std::bit_cast<uint32_t>(B);
 }
 
 ostream& Jlib::operator << (ostream& os, const Color& c)
@@ -90,4 +158,279 @@ void Jlib::print(const Jlib::Color& c)
 void Jlib::println(const Jlib::Color& c)
 {
 	cout << c << endl;
-}
\ No newline at end of file
+}
+
+void Jlib::blend_colors(const Color* source, Color* destination, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	i = simd_colors(source, destination, destination, count, [](__m128i s, __m128i d)
+	{
+		const __m128i source_alpha = broadcast_alpha(s);
+		const __m128i inverse_alpha = _mm_sub_epi16(_mm_set1_epi16(255), source_alpha);
+		const __m128i sum = _mm_add_epi16(_mm_mullo_epi16(s, opaque_alpha(source_alpha)), _mm_mullo_epi16(d, inverse_alpha));
+		return div_255(sum);
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		const Color s = source[i];
+		Color& d = destination[i];
+		const uint32_t inverse_alpha = 255u - s.alpha;
+
+		d.red = uint8_t(div_255(s.red * uint32_t(s.alpha) + d.red * inverse_alpha));
+		d.green = uint8_t(div_255(s.green * uint32_t(s.alpha) + d.green * inverse_alpha));
+		d.blue = uint8_t(div_255(s.blue * uint32_t(s.alpha) + d.blue * inverse_alpha));
+		d.alpha = uint8_t(div_255(s.alpha * 255u + d.alpha * inverse_alpha));
+	}
+}
+
+void Jlib::blend_premultiplied_colors(const Color* source, Color* destination, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	// The final pack saturates the sums at 255.
+	i = simd_colors(source, destination, destination, count, [](__m128i s, __m128i d)
+	{
+		const __m128i inverse_alpha = _mm_sub_epi16(_mm_set1_epi16(255), broadcast_alpha(s));
+		return _mm_add_epi16(s, div_255(_mm_mullo_epi16(d, inverse_alpha)));
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		const Color s = source[i];
+		Color& d = destination[i];
+		const uint32_t inverse_alpha = 255u - s.alpha;
+
+		d.red = uint8_t(std::min(255u, s.red + div_255(d.red * inverse_alpha)));
+		d.green = uint8_t(std::min(255u, s.green + div_255(d.green * inverse_alpha)));
+		d.blue = uint8_t(std::min(255u, s.blue + div_255(d.blue * inverse_alpha)));
+		d.alpha = uint8_t(std::min(255u, s.alpha + div_255(d.alpha * inverse_alpha)));
+	}
+}
+
+void Jlib::premultiply_colors(Color* colors, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	i = simd_colors(colors, nullptr, colors, count, [](__m128i c, __m128i)
+	{
+		return div_255(_mm_mullo_epi16(c, opaque_alpha(broadcast_alpha(c))));
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		Color& c = colors[i];
+
+		c.red = uint8_t(div_255(c.red * uint32_t(c.alpha)));
+		c.green = uint8_t(div_255(c.green * uint32_t(c.alpha)));
+		c.blue = uint8_t(div_255(c.blue * uint32_t(c.alpha)));
+	}
+}
+
+void Jlib::tint_colors(const Color* colors, const Color& tint, Color* result, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128i tint_lanes = _mm_unpacklo_epi8(_mm_set1_epi32(std::bit_cast<int32_t>(tint)), _mm_setzero_si128());
+
+	i = simd_colors(colors, nullptr, result, count, [&](__m128i c, __m128i)
+	{
+		return div_255(_mm_mullo_epi16(c, tint_lanes));
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		const Color c = colors[i];
+
+		result[i].red = uint8_t(div_255(c.red * uint32_t(tint.red)));
+		result[i].green = uint8_t(div_255(c.green * uint32_t(tint.green)));
+		result[i].blue = uint8_t(div_255(c.blue * uint32_t(tint.blue)));
+		result[i].alpha = uint8_t(div_255(c.alpha * uint32_t(tint.alpha)));
+	}
+}
+
+void Jlib::multiply_colors(const Color* A, const Color* B, Color* result, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	i = simd_colors(A, B, result, count, [](__m128i a, __m128i b)
+	{
+		return div_255(_mm_mullo_epi16(a, b));
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		const Color a = A[i];
+		const Color b = B[i];
+
+		result[i].red = uint8_t(div_255(a.red * uint32_t(b.red)));
+		result[i].green = uint8_t(div_255(a.green * uint32_t(b.green)));
+		result[i].blue = uint8_t(div_255(a.blue * uint32_t(b.blue)));
+		result[i].alpha = uint8_t(div_255(a.alpha * uint32_t(b.alpha)));
+	}
+}
+
+void Jlib::lerp_colors(const Color* A, const Color* B, float t, Color* result, size_t count)
+{
+	// Also sends NaN to 0.
+	t = t > 0.0f ? t : 0.0f;
+	t = t < 1.0f ? t : 1.0f;
+
+	const uint32_t weight = uint32_t(t * 255.0f + 0.5f);
+	const uint32_t inverse_weight = 255u - weight;
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128i weight_lanes = _mm_set1_epi16(int16_t(weight));
+	const __m128i inverse_weight_lanes = _mm_set1_epi16(int16_t(inverse_weight));
+
+	i = simd_colors(A, B, result, count, [&](__m128i a, __m128i b)
+	{
+		return div_255(_mm_add_epi16(_mm_mullo_epi16(a, inverse_weight_lanes), _mm_mullo_epi16(b, weight_lanes)));
+	});
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		const Color a = A[i];
+		const Color b = B[i];
+
+		result[i].red = uint8_t(div_255(a.red * inverse_weight + b.red * weight));
+		result[i].green = uint8_t(div_255(a.green * inverse_weight + b.green * weight));
+		result[i].blue = uint8_t(div_255(a.blue * inverse_weight + b.blue * weight));
+		result[i].alpha = uint8_t(div_255(a.alpha * inverse_weight + b.alpha * weight));
+	}
+}
+
+void Jlib::colors_to_integers(const Color* colors, uint32_t* packed, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128i middle_bytes = _mm_set1_epi32(0x00FF0000);
+	const __m128i low_bytes = _mm_set1_epi32(0x0000FF00);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + i));
+		__m128i p = _mm_or_si128(_mm_slli_epi32(c, 24), _mm_srli_epi32(c, 24));
+		p = _mm_or_si128(p, _mm_and_si128(_mm_slli_epi32(c, 8), middle_bytes));
+		p = _mm_or_si128(p, _mm_and_si128(_mm_srli_epi32(c, 8), low_bytes));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(packed + i), p);
+	}
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+		packed[i] = colors[i].toInteger();
+}
+
+void Jlib::integers_to_colors(const uint32_t* packed, Color* colors, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128i middle_bytes = _mm_set1_epi32(0x00FF0000);
+	const __m128i low_bytes = _mm_set1_epi32(0x0000FF00);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + i));
+		__m128i c = _mm_or_si128(_mm_slli_epi32(p, 24), _mm_srli_epi32(p, 24));
+		c = _mm_or_si128(c, _mm_and_si128(_mm_slli_epi32(p, 8), middle_bytes));
+		c = _mm_or_si128(c, _mm_and_si128(_mm_srli_epi32(p, 8), low_bytes));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(colors + i), c);
+	}
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+		colors[i] = std::bit_cast<Color>(reverse_bytes(packed[i]));
+}
+
+void Jlib::colors_to_floats(const Color* colors, float* rgba, size_t count)
+{
+	constexpr float SCALE = 1.0f / 255.0f;
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128 scale = _mm_set1_ps(SCALE);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + i));
+		const __m128i low = _mm_unpacklo_epi8(c, zero);
+		const __m128i high = _mm_unpackhi_epi8(c, zero);
+		float* out = rgba + 4 * i;
+
+		_mm_storeu_ps(out, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(low, zero)), scale));
+		_mm_storeu_ps(out + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(low, zero)), scale));
+		_mm_storeu_ps(out + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(high, zero)), scale));
+		_mm_storeu_ps(out + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(high, zero)), scale));
+	}
+	#endif // JLIB_SSE2
+
+	for (; i < count; ++i)
+	{
+		rgba[4 * i] = float(colors[i].red) * SCALE;
+		rgba[4 * i + 1] = float(colors[i].green) * SCALE;
+		rgba[4 * i + 2] = float(colors[i].blue) * SCALE;
+		rgba[4 * i + 3] = float(colors[i].alpha) * SCALE;
+	}
+}
+
+void Jlib::floats_to_colors(const float* rgba, Color* colors, size_t count)
+{
+	size_t i = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 scale = _mm_set1_ps(255.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+
+	// _mm_min_ps returns its second operand for NaN, so NaN becomes 1.
+	auto convert = [&](const float* in)
+	{
+		const __m128 v = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(in), one), zero);
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+	};
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const float* in = rgba + 4 * i;
+		const __m128i low = _mm_packs_epi32(convert(in), convert(in + 4));
+		const __m128i high = _mm_packs_epi32(convert(in + 8), convert(in + 12));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(colors + i), _mm_packus_epi16(low, high));
+	}
+	#endif // JLIB_SSE2
+
+	// Written to match the SSE2 version, NaN included.
+	auto convert_channel = [](float v)
+	{
+		v = v < 1.0f ? v : 1.0f;
+		v = v > 0.0f ? v : 0.0f;
+		return uint8_t(v * 255.0f + 0.5f);
+	};
+
+	for (; i < count; ++i)
+	{
+		colors[i].red = convert_channel(rgba[4 * i]);
+		colors[i].green = convert_channel(rgba[4 * i + 1]);
+		colors[i].blue = convert_channel(rgba[4 * i + 2]);
+		colors[i].alpha = convert_channel(rgba[4 * i + 3]);
+	}
+}
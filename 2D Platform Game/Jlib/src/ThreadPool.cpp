@@ -0,0 +1,156 @@
+// Jlib
+// ThreadPool.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ThreadPool class.
+
+#include "ThreadPool.h"
+
+// <cstddef>
+using std::size_t;
+
+// <exception>
+using std::current_exception;
+using std::exception_ptr;
+using std::rethrow_exception;
+
+// <functional>
+using std::function;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+using std::unique_lock;
+
+// <thread>
+using std::thread;
+
+Jlib::ThreadPool::ThreadPool()
+	: ThreadPool(thread::hardware_concurrency() > 1 ? thread::hardware_concurrency() - 1 : 0)
+{
+
+}
+
+Jlib::ThreadPool::ThreadPool(size_t thread_count)
+{
+	threads_.reserve(thread_count);
+
+	for (size_t i = 0; i < thread_count; ++i)
+		threads_.emplace_back(&ThreadPool::run, this);
+}
+
+Jlib::ThreadPool::~ThreadPool()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	start_.notify_all();
+
+	for (thread& t : threads_)
+		t.join();
+}
+
+size_t Jlib::ThreadPool::threadCount() const
+{
+	return threads_.size();
+}
+
+void Jlib::ThreadPool::work()
+{
+	while (true)
+	{
+		const size_t i = next_.fetch_add(1, std::memory_order_relaxed);
+
+		if (i >= count_)
+			return;
+
+		try
+		{
+			(*function_)(i);
+		}
+		catch (...)
+		{
+			lock_guard<mutex> lock(mutex_);
+
+			if (!exception_)
+				exception_ = current_exception();
+		}
+	}
+}
+
+void Jlib::ThreadPool::run()
+{
+	size_t seen_generation = 0;
+
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(mutex_);
+			start_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+
+			if (stopping_)
+				return;
+
+			seen_generation = generation_;
+			++busy_threads_;
+		}
+
+		work();
+
+		{
+			lock_guard<mutex> lock(mutex_);
+			--busy_threads_;
+		}
+
+		finish_.notify_one();
+	}
+}
+
+void Jlib::ThreadPool::parallelFor(size_t count, const function<void(size_t)>& function)
+{
+	if (count == 0)
+		return;
+
+	// Not worth waking the workers for a single call.
+	if (threads_.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+			function(i);
+
+		return;
+	}
+
+	{
+		// A worker that woke up too late for the previous loop may still
+		// be finding out there is nothing left to do.
+		unique_lock<mutex> lock(mutex_);
+		finish_.wait(lock, [&] { return busy_threads_ == 0; });
+
+		function_ = &function;
+		count_ = count;
+		next_.store(0, std::memory_order_relaxed);
+		exception_ = nullptr;
+		++generation_;
+	}
+
+	start_.notify_all();
+	work();
+
+	exception_ptr exception;
+
+	{
+		// Workers that have not woken up yet find no iterations left
+		// and go straight back to waiting, so only busy ones are waited on.
+		unique_lock<mutex> lock(mutex_);
+		finish_.wait(lock, [&] { return busy_threads_ == 0; });
+		function_ = nullptr;
+		exception = exception_;
+		exception_ = nullptr;
+	}
+
+	if (exception)
+		rethrow_exception(exception);
+}
@@ -0,0 +1,370 @@
+// 2D Platform Game
+// Level.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the Level struct and level file parsing.
+
+#include "Level.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// <charconv>
+using std::from_chars;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+
+// <fstream>
+using std::ifstream;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+using std::to_string;
+
+// <string_view>
+using std::string_view;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	bool is_space(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	const char* skip_spaces(const char* begin, const char* end)
+	{
+		while (begin != end && is_space(*begin))
+			++begin;
+
+		return begin;
+	}
+
+	constexpr string_view LAYERED_MAGIC = "JLEVEL";
+	constexpr std::uint32_t LAYERED_VERSION = 1;
+	constexpr string_view LAYER_NAMES[LEVEL_LAYER_COUNT] = { "background", "collision", "foreground" };
+
+	// Parses the number at the start of [begin, end) after any whitespace,
+	// and returns a pointer past it.
+	template <typename T> const char* read_number(const char* begin, const char* end, T& value)
+	{
+		begin = skip_spaces(begin, end);
+		const auto [next, error] = from_chars(begin, end, value);
+
+		if (error != std::errc())
+			throw runtime_error("parse_level: expected a number");
+
+		return next;
+	}
+
+	Level parse_plain_level(const char* text, size_t size)
+	{
+		const char* it = text;
+		const char* const end = text + size;
+
+		size_t width = 0;
+		size_t height = 0;
+		Level level;
+
+		it = read_number(it, end, width);
+		it = read_number(it, end, height);
+		it = read_number(it, end, level.spawn.x);
+		it = read_number(it, end, level.spawn.y);
+
+		// Each tile takes at least one character.
+		if (width != 0 && height > size_t(end - it) / width)
+			throw runtime_error("parse_level: fewer tiles than the level size");
+
+		level.layout.resize(height, width);
+		uint8_t* tile = level.layout.data();
+		uint8_t* const last_tile = tile + width * height;
+
+		for (; tile != last_tile; ++tile)
+		{
+			it = skip_spaces(it, end);
+
+			if (it == end)
+				throw runtime_error("parse_level: fewer tiles than the level size");
+
+			*tile = uint8_t(*it++);
+		}
+
+		return level;
+	}
+
+	// Walks text one line at a time, without the line breaks.
+	struct LineReader
+	{
+		const char* it = nullptr;
+		const char* end = nullptr;
+		size_t number = 0;
+
+		bool next(string_view& line)
+		{
+			if (it == end)
+				return false;
+
+			const char* const newline = static_cast<const char*>(std::memchr(it, '\n', size_t(end - it)));
+			const char* const line_end = newline != nullptr ? newline : end;
+
+			line = string_view(it, size_t(line_end - it));
+
+			if (!line.empty() && line.back() == '\r')
+				line.remove_suffix(1);
+
+			it = newline != nullptr ? newline + 1 : end;
+			++number;
+
+			return true;
+		}
+	};
+
+	[[noreturn]] void fail(size_t line, const string& message)
+	{
+		throw runtime_error("parse_layered_level: line " + to_string(line) + ": " + message);
+	}
+
+	// Removes the first word of line, after any spaces, and returns it.
+	string_view next_word(string_view& line)
+	{
+		size_t start = 0;
+
+		while (start < line.size() && (line[start] == ' ' || line[start] == '\t'))
+			++start;
+
+		size_t end = start;
+
+		while (end < line.size() && line[end] != ' ' && line[end] != '\t')
+			++end;
+
+		const string_view word = line.substr(start, end - start);
+		line.remove_prefix(end);
+
+		return word;
+	}
+
+	template <typename T> T parse_word(string_view word, size_t line)
+	{
+		T value {};
+		const auto [next, error] = from_chars(word.data(), word.data() + word.size(), value);
+
+		if (word.empty() || error != std::errc() || next != word.data() + word.size())
+			fail(line, "expected a number, found \"" + string(word) + "\"");
+
+		return value;
+	}
+
+	// Throws unless nothing but spaces is left of line.
+	void expect_end(string_view line, size_t number)
+	{
+		const string_view extra = next_word(line);
+
+		if (!extra.empty())
+			fail(number, "unexpected text \"" + string(extra) + "\"");
+	}
+}
+
+const Matrix<uint8_t>& LayeredLevel::layer(LevelLayer layer) const
+{
+	return layers[size_t(layer)];
+}
+
+const string* LayeredLevel::meta(string_view key) const
+{
+	for (const auto& [entry_key, value] : metadata)
+	{
+		if (entry_key == key)
+			return &value;
+	}
+
+	return nullptr;
+}
+
+Level LayeredLevel::toLevel() const
+{
+	Level level;
+
+	level.layout = layer(LevelLayer::Collision);
+	level.spawn = spawn;
+
+	return level;
+}
+
+bool is_layered_level(const char* text, size_t size)
+{
+	return string_view(text, size).starts_with(LAYERED_MAGIC);
+}
+
+Level parse_level(const char* text, size_t size)
+{
+	if (!is_layered_level(text, size))
+		return parse_plain_level(text, size);
+
+	LayeredLevel layered = parse_layered_level(text, size);
+	Level level;
+
+	level.layout = std::move(layered.layers[size_t(LevelLayer::Collision)]);
+	level.spawn = layered.spawn;
+
+	return level;
+}
+
+LayeredLevel parse_layered_level(const char* text, size_t size)
+{
+	LineReader lines { text, text + size };
+	string_view line;
+
+	if (!lines.next(line) || next_word(line) != LAYERED_MAGIC)
+		fail(1, "expected " + string(LAYERED_MAGIC));
+
+	if (parse_word<std::uint32_t>(next_word(line), 1) != LAYERED_VERSION)
+		fail(1, "unsupported version");
+
+	LayeredLevel level;
+	bool has_size = false;
+	bool has_layer[LEVEL_LAYER_COUNT] = {};
+
+	// Entities tend to come in runs of the same type.
+	size_t last_type = 0;
+
+	while (lines.next(line))
+	{
+		const size_t number = lines.number;
+		const string_view keyword = next_word(line);
+
+		if (keyword.empty() || keyword[0] == ';')
+			continue;
+
+		if (keyword == "size")
+		{
+			if (has_size)
+				fail(number, "size given twice");
+
+			level.width = parse_word<size_t>(next_word(line), number);
+			level.height = parse_word<size_t>(next_word(line), number);
+			has_size = true;
+			expect_end(line, number);
+		}
+		else if (keyword == "spawn")
+		{
+			level.spawn.x = parse_word<float>(next_word(line), number);
+			level.spawn.y = parse_word<float>(next_word(line), number);
+			expect_end(line, number);
+		}
+		else if (keyword == "meta")
+		{
+			const string_view key = next_word(line);
+
+			if (key.empty())
+				fail(number, "meta needs a key");
+
+			while (!line.empty() && (line.front() == ' ' || line.front() == '\t'))
+				line.remove_prefix(1);
+
+			while (!line.empty() && (line.back() == ' ' || line.back() == '\t'))
+				line.remove_suffix(1);
+
+			level.metadata.emplace_back(string(key), string(line));
+		}
+		else if (keyword == "layer")
+		{
+			const string_view name = next_word(line);
+			const size_t index = size_t(std::find(LAYER_NAMES, LAYER_NAMES + LEVEL_LAYER_COUNT, name) - LAYER_NAMES);
+
+			if (index == LEVEL_LAYER_COUNT)
+				fail(number, "unknown layer \"" + string(name) + "\"");
+
+			if (!has_size)
+				fail(number, "layer before size");
+
+			if (has_layer[index])
+				fail(number, "layer " + string(name) + " given twice");
+
+			expect_end(line, number);
+			has_layer[index] = true;
+
+			// Each row takes at least width characters, so a bad size
+			// cannot make the layer bigger than the file.
+			if (level.height != 0 && level.width > size_t(lines.end - lines.it) / level.height)
+				fail(number, "layer " + string(name) + " is larger than the rest of the file");
+
+			Matrix<uint8_t>& layer = level.layers[index];
+			layer.resize(level.height, level.width);
+
+			for (size_t r = 0; r < level.height; ++r)
+			{
+				string_view row;
+
+				if (!lines.next(row))
+					fail(lines.number, "layer " + string(name) + " ends after " + to_string(r) + " rows");
+
+				if (row.size() != level.width)
+					fail(lines.number, "row has " + to_string(row.size()) + " tiles instead of " + to_string(level.width));
+
+				std::memcpy(layer.data() + r * level.width, row.data(), level.width);
+			}
+		}
+		else if (keyword == "entity")
+		{
+			const string_view type = next_word(line);
+
+			if (type.empty())
+				fail(number, "entity needs a type");
+
+			EntitySpawn spawn;
+			spawn.position.x = parse_word<float>(next_word(line), number);
+			spawn.position.y = parse_word<float>(next_word(line), number);
+			expect_end(line, number);
+
+			if (last_type >= level.entity_types.size() || level.entity_types[last_type] != type)
+			{
+				last_type = size_t(std::find(level.entity_types.begin(), level.entity_types.end(), type) - level.entity_types.begin());
+
+				if (last_type == level.entity_types.size())
+					level.entity_types.emplace_back(type);
+			}
+
+			spawn.type = std::uint32_t(last_type);
+			level.entities.push_back(spawn);
+		}
+		else
+			fail(number, "unknown keyword \"" + string(keyword) + "\"");
+	}
+
+	if (!has_layer[size_t(LevelLayer::Collision)])
+		fail(lines.number, "no collision layer");
+
+	return level;
+}
+
+Level load_level_file(const string& path)
+{
+	ifstream fin(path, std::ios::binary | std::ios::ate);
+
+	if (!fin.is_open())
+		throw runtime_error("load_level_file: could not open " + path);
+
+	vector<char> text(size_t(fin.tellg()));
+	fin.seekg(0);
+
+	if (!fin.read(text.data(), std::streamsize(text.size())))
+		throw runtime_error("load_level_file: could not read " + path);
+
+	return parse_level(text.data(), text.size());
+}
@@ -0,0 +1,118 @@
+// 2D Platform Game
+// Level.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the Level struct and level file parsing.
+
+#ifndef LEVEL_H_INCLUDED
+#define LEVEL_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// A level as stored in level.txt.
+struct Level
+{
+	// See Tile.h.
+	Jlib::Matrix<std::uint8_t> layout;
+
+	// Where the player starts, in tiles.
+	Jlib::Point2f spawn;
+};
+
+// Tile layers of a LayeredLevel, from back to front.
+enum class LevelLayer : std::uint8_t
+{
+	Background,
+	Collision,
+	Foreground
+};
+
+// Amount of LevelLayer values.
+constexpr std::size_t LEVEL_LAYER_COUNT = 3;
+
+// An entity placed in a LayeredLevel.
+struct EntitySpawn
+{
+	// Index into LayeredLevel::entity_types.
+	std::uint32_t type = 0;
+
+	// Position in tiles.
+	Jlib::Point2f position;
+};
+
+// A level in the layered format:
+//
+//     JLEVEL 1
+//     size <width> <height>
+//     spawn <x> <y>
+//     meta <key> <value, up to the end of the line>
+//     layer <background | collision | foreground>
+//     <height lines of exactly width tile characters>
+//     entity <type> <x> <y>
+//
+// The JLEVEL line comes first and size comes before any layer; other
+// lines may come in any order, and meta and entity lines may repeat.
+// The collision layer is required. Blank lines and lines starting
+// with ';' are ignored outside of layers.
+struct LayeredLevel
+{
+	std::size_t width = 0;
+	std::size_t height = 0;
+
+	// Indexed by LevelLayer. Layers missing from the file are empty (0 by 0).
+	Jlib::Matrix<std::uint8_t> layers[LEVEL_LAYER_COUNT];
+
+	Jlib::Point2f spawn;
+
+	// Every entity type name, once each, in the order first seen.
+	std::vector<std::string> entity_types;
+	std::vector<EntitySpawn> entities;
+
+	// Key and value pairs, in file order.
+	std::vector<std::pair<std::string, std::string>> metadata;
+
+	// Returns the given layer.
+	const Jlib::Matrix<std::uint8_t>& layer(LevelLayer layer) const;
+
+	// Returns the value of the first metadata entry with the given key,
+	// or nullptr if there is none.
+	const std::string* meta(std::string_view key) const;
+
+	// Returns the collision layer and spawn as a Level.
+	Level toLevel() const;
+};
+
+// Returns true if text starts like a LayeredLevel file.
+// Returns false otherwise.
+bool is_layered_level(const char* text, std::size_t size);
+
+// Parses a level from the contents of a level file, in either format:
+// a LayeredLevel, of which the collision layer and spawn are kept, or
+// the level.txt format: the width, height, spawn x and spawn y,
+// followed by one character per tile, row by row, with whitespace
+// between any of these ignored.
+// Does no I/O, so it can run on any thread.
+// This function will throw if the text is not a valid level.
+Level parse_level(const char* text, std::size_t size);
+
+// Parses a LayeredLevel in a single pass over text. Tile rows are
+// copied straight into one contiguous Matrix per layer, and nothing
+// else is allocated per tile or per line.
+// This function will throw if the text is not a valid LayeredLevel,
+// naming the line at fault.
+LayeredLevel parse_layered_level(const char* text, std::size_t size);
+
+// Reads and parses the level file at the given path.
+// This function will throw if the file cannot be read or is not a valid level.
+Level load_level_file(const std::string& path);
+
+#endif // LEVEL_H_INCLUDED
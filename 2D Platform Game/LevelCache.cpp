@@ -0,0 +1,469 @@
+// 2D Platform Game
+// LevelCache.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ChunkedLevel and LevelCache classes.
+
+#include "LevelCache.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// <atomic>
+using std::atomic;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int64_t;
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <filesystem>
+namespace fs = std::filesystem;
+
+// <fstream>
+using std::ifstream;
+using std::ofstream;
+
+// <memory>
+using std::make_shared;
+using std::shared_ptr;
+using std::weak_ptr;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+
+// <stdexcept>
+using std::out_of_range;
+using std::runtime_error;
+
+// <string>
+using std::getline;
+using std::string;
+using std::to_string;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// Start of every cached binary level, followed by the width and
+	// height as uint32_t, the spawn as two floats and then the tiles.
+	constexpr char BINARY_MAGIC[4] = { 'J', 'L', 'V', '1' };
+	constexpr size_t BINARY_HEADER_SIZE = 4 + 4 + 4 + 4 + 4;
+
+	constexpr const char* INDEX_NAME = "index.txt";
+
+	// Numbers the temporary files of write_binary, so that workers
+	// writing the same level at once never write to the same file.
+	atomic<uint64_t> temporary_count = 0;
+
+	// Returns the line of the index for the given source path.
+	string index_line(uint64_t hash, int64_t modified, uint64_t size, const string& path)
+	{
+		char fields[64];
+		std::snprintf(fields, sizeof(fields), "%016llx %lld %llu ", static_cast<unsigned long long>(hash), static_cast<long long>(modified), static_cast<unsigned long long>(size));
+
+		return fields + path + '\n';
+	}
+
+	void read_source(const string& path, vector<char>& bytes)
+	{
+		ifstream fin(path, std::ios::binary | std::ios::ate);
+
+		if (!fin.is_open())
+			throw runtime_error("LevelCache: could not open " + path);
+
+		bytes.resize(size_t(fin.tellg()));
+		fin.seekg(0);
+
+		if (!fin.read(bytes.data(), std::streamsize(bytes.size())))
+			throw runtime_error("LevelCache: could not read " + path);
+	}
+
+	// Reads the cached binary level at path into level.
+	// Returns false if it is missing or damaged.
+	bool read_binary(const string& path, Level& level)
+	{
+		ifstream fin(path, std::ios::binary | std::ios::ate);
+		const std::streamoff file_size = fin.tellg();
+		char header[BINARY_HEADER_SIZE];
+
+		if (!fin.seekg(0) || !fin.read(header, BINARY_HEADER_SIZE) || std::memcmp(header, BINARY_MAGIC, 4) != 0)
+			return false;
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+
+		std::memcpy(&width, header + 4, 4);
+		std::memcpy(&height, header + 8, 4);
+
+		// A truncated or damaged file must not size the layout.
+		if (uint64_t(file_size) != BINARY_HEADER_SIZE + uint64_t(width) * uint64_t(height))
+			return false;
+
+		std::memcpy(&level.spawn.x, header + 12, 4);
+		std::memcpy(&level.spawn.y, header + 16, 4);
+
+		level.layout.resize(height, width);
+
+		return bool(fin.read(reinterpret_cast<char*>(level.layout.data()), std::streamsize(level.layout.size())));
+	}
+
+	// Writes level to path, through a temporary file so a reader never
+	// sees half of it. Failing only means the cache is skipped next time.
+	void write_binary(const string& path, const Level& level)
+	{
+		const string temporary = path + "." + to_string(temporary_count.fetch_add(1)) + ".tmp";
+		ofstream fout(temporary, std::ios::binary | std::ios::trunc);
+		char header[BINARY_HEADER_SIZE];
+		const uint32_t width = uint32_t(level.layout.colSize());
+		const uint32_t height = uint32_t(level.layout.rowSize());
+
+		std::memcpy(header, BINARY_MAGIC, 4);
+		std::memcpy(header + 4, &width, 4);
+		std::memcpy(header + 8, &height, 4);
+		std::memcpy(header + 12, &level.spawn.x, 4);
+		std::memcpy(header + 16, &level.spawn.y, 4);
+
+		fout.write(header, BINARY_HEADER_SIZE);
+		fout.write(reinterpret_cast<const char*>(level.layout.data()), std::streamsize(level.layout.size()));
+		fout.close();
+
+		std::error_code error;
+
+		if (fout)
+			fs::rename(temporary, path, error);
+
+		// No later write uses the same name, so a temporary file that
+		// was not renamed would never be replaced.
+		if (!fout || error)
+			fs::remove(temporary, error);
+	}
+}
+
+ChunkedLevel::ChunkedLevel(const Level& level, ContentStore& store)
+{
+	width_ = level.layout.colSize();
+	height_ = level.layout.rowSize();
+	chunks_x_ = (width_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	chunks_y_ = (height_ + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	spawn_ = level.spawn;
+	chunks_.reserve(chunks_x_ * chunks_y_);
+
+	uint8_t tiles[CHUNK_SIZE * CHUNK_SIZE];
+	const uint8_t* const layout = level.layout.data();
+
+	for (size_t cy = 0; cy < chunks_y_; ++cy)
+	{
+		for (size_t cx = 0; cx < chunks_x_; ++cx)
+		{
+			const size_t x0 = cx * CHUNK_SIZE;
+			const size_t y0 = cy * CHUNK_SIZE;
+			const size_t columns = std::min(CHUNK_SIZE, width_ - x0);
+			const size_t rows = std::min(CHUNK_SIZE, height_ - y0);
+
+			if (columns < CHUNK_SIZE || rows < CHUNK_SIZE)
+				std::fill(tiles, tiles + CHUNK_SIZE * CHUNK_SIZE, TILE_EMPTY);
+
+			for (size_t r = 0; r < rows; ++r)
+				std::copy_n(layout + (y0 + r) * width_ + x0, columns, tiles + r * CHUNK_SIZE);
+
+			chunks_.push_back(store.intern(tiles, sizeof(tiles)));
+		}
+	}
+}
+
+size_t ChunkedLevel::width() const
+{
+	return width_;
+}
+
+size_t ChunkedLevel::height() const
+{
+	return height_;
+}
+
+Point2f ChunkedLevel::spawn() const
+{
+	return spawn_;
+}
+
+size_t ChunkedLevel::chunkCount() const
+{
+	return chunks_.size();
+}
+
+uint8_t ChunkedLevel::at(size_t x, size_t y) const
+{
+	if (x >= width_ || y >= height_)
+		throw out_of_range("ChunkedLevel::at: position outside of the level");
+
+	const ContentBlob& chunk = *chunks_[(y / CHUNK_SIZE) * chunks_x_ + x / CHUNK_SIZE];
+	return chunk[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE];
+}
+
+void ChunkedLevel::copyTo(Matrix<uint8_t>& layout) const
+{
+	layout.resize(height_, width_);
+	uint8_t* const tiles = layout.data();
+
+	for (size_t cy = 0; cy < chunks_y_; ++cy)
+	{
+		for (size_t cx = 0; cx < chunks_x_; ++cx)
+		{
+			const uint8_t* const chunk = chunks_[cy * chunks_x_ + cx]->data();
+			const size_t x0 = cx * CHUNK_SIZE;
+			const size_t y0 = cy * CHUNK_SIZE;
+			const size_t columns = std::min(CHUNK_SIZE, width_ - x0);
+			const size_t rows = std::min(CHUNK_SIZE, height_ - y0);
+
+			for (size_t r = 0; r < rows; ++r)
+				std::copy_n(chunk + r * CHUNK_SIZE, columns, tiles + (y0 + r) * width_ + x0);
+		}
+	}
+}
+
+Level ChunkedLevel::toLevel() const
+{
+	Level level;
+
+	copyTo(level.layout);
+	level.spawn = spawn_;
+
+	return level;
+}
+
+LevelCache::LevelCache(const string& directory, ContentStore& store)
+	: directory_(directory), store_(store)
+{
+	std::error_code error;
+	fs::create_directories(directory_, error);
+
+	if (error)
+		throw runtime_error("LevelCache: could not create " + directory_);
+
+	// Later lines override earlier ones for the same path.
+	vector<uint64_t> superseded;
+	size_t lines = 0;
+
+	{
+		ifstream fin(fs::path(directory_) / INDEX_NAME);
+		string line;
+
+		while (getline(fin, line))
+		{
+			std::istringstream fields(line);
+			IndexEntry entry;
+			string path;
+
+			++lines;
+
+			if (fields >> std::hex >> entry.hash >> std::dec >> entry.modified >> entry.size && getline(fields >> std::ws, path))
+			{
+				IndexEntry& slot = index_[path];
+
+				if (slot.hash != 0 && slot.hash != entry.hash)
+					superseded.push_back(slot.hash);
+
+				slot = entry;
+			}
+		}
+	}
+
+	// load only appends to the index, so it is compacted here, once per
+	// run, along with the binaries of the sources it replaced.
+	if (lines != index_.size())
+		writeIndex();
+
+	for (const uint64_t hash : superseded)
+		removeUnused(hash);
+}
+
+void LevelCache::writeIndex() const
+{
+	const fs::path path = fs::path(directory_) / INDEX_NAME;
+	fs::path temporary = path;
+	temporary += ".tmp";
+
+	{
+		ofstream fout(temporary, std::ios::trunc);
+
+		for (const auto& [source, entry] : index_)
+			fout << index_line(entry.hash, entry.modified, entry.size, source);
+
+		if (!fout)
+			return;
+	}
+
+	std::error_code error;
+	fs::rename(temporary, path, error);
+}
+
+void LevelCache::removeUnused(uint64_t hash) const
+{
+	for (const auto& [source, entry] : index_)
+	{
+		if (entry.hash == hash)
+			return;
+	}
+
+	std::error_code error;
+	fs::remove(binaryPath(hash), error);
+}
+
+string LevelCache::binaryPath(uint64_t hash) const
+{
+	char name[24];
+	std::snprintf(name, sizeof(name), "%016llx.lvl", static_cast<unsigned long long>(hash));
+
+	return (fs::path(directory_) / name).string();
+}
+
+shared_ptr<const ChunkedLevel> LevelCache::findLoaded(uint64_t hash)
+{
+	lock_guard<mutex> lock(mutex_);
+	const auto it = loaded_.find(hash);
+
+	if (it == loaded_.end())
+		return nullptr;
+
+	shared_ptr<const ChunkedLevel> level = it->second.lock();
+
+	if (level)
+		++stats_.memory_hits;
+
+	return level;
+}
+
+shared_ptr<const ChunkedLevel> LevelCache::addLoaded(uint64_t hash, shared_ptr<const ChunkedLevel> level)
+{
+	lock_guard<mutex> lock(mutex_);
+	weak_ptr<const ChunkedLevel>& slot = loaded_[hash];
+
+	if (shared_ptr<const ChunkedLevel> existing = slot.lock())
+		return existing;
+
+	slot = level;
+	return level;
+}
+
+shared_ptr<const ChunkedLevel> LevelCache::load(const string& path)
+{
+	std::error_code time_error;
+	std::error_code size_error;
+	const fs::path source = fs::absolute(path).lexically_normal();
+	const string key = source.string();
+	const int64_t modified = int64_t(fs::last_write_time(source, time_error).time_since_epoch().count());
+	const uint64_t size = uint64_t(fs::file_size(source, size_error));
+
+	if (time_error || size_error)
+		throw runtime_error("LevelCache: could not open " + path);
+
+	// While the index matches, the source is not read at all.
+	{
+		uint64_t hash = 0;
+		bool indexed = false;
+
+		{
+			lock_guard<mutex> lock(mutex_);
+			const auto it = index_.find(key);
+
+			if (it != index_.end() && it->second.modified == modified && it->second.size == size)
+			{
+				hash = it->second.hash;
+				indexed = true;
+			}
+		}
+
+		if (indexed)
+		{
+			if (shared_ptr<const ChunkedLevel> level = findLoaded(hash))
+				return level;
+
+			Level level;
+
+			if (read_binary(binaryPath(hash), level))
+			{
+				{
+					lock_guard<mutex> lock(mutex_);
+					++stats_.disk_hits;
+				}
+
+				return addLoaded(hash, make_shared<const ChunkedLevel>(level, store_));
+			}
+		}
+	}
+
+	vector<char> text;
+	read_source(path, text);
+
+	const uint64_t hash = content_hash(text.data(), text.size());
+	shared_ptr<const ChunkedLevel> level = findLoaded(hash);
+
+	if (!level)
+	{
+		const string binary = binaryPath(hash);
+		Level parsed;
+		const bool from_disk = read_binary(binary, parsed);
+
+		if (!from_disk)
+		{
+			parsed = parse_level(text.data(), text.size());
+			write_binary(binary, parsed);
+		}
+
+		{
+			lock_guard<mutex> lock(mutex_);
+
+			if (from_disk)
+				++stats_.disk_hits;
+			else
+				++stats_.parses;
+		}
+
+		level = addLoaded(hash, make_shared<const ChunkedLevel>(parsed, store_));
+	}
+
+	lock_guard<mutex> lock(mutex_);
+	IndexEntry& entry = index_[key];
+
+	if (entry.modified == modified && entry.size == size && entry.hash == hash)
+		return level;
+
+	const uint64_t replaced = entry.hash;
+	entry = IndexEntry { modified, size, hash };
+
+	// The binary of the old contents is only kept while another source has them.
+	if (replaced != 0 && replaced != hash)
+		removeUnused(replaced);
+
+	ofstream fout(fs::path(directory_) / INDEX_NAME, std::ios::app);
+	fout << index_line(hash, modified, size, key);
+
+	return level;
+}
+
+LevelCacheStats LevelCache::stats() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return stats_;
+}
@@ -0,0 +1,160 @@
+// 2D Platform Game
+// LevelCache.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ChunkedLevel and LevelCache classes.
+
+#ifndef LEVELCACHE_H_INCLUDED
+#define LEVELCACHE_H_INCLUDED
+
+#include "ContentStore.h"
+#include "Level.h"
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Level whose tiles are stored as square chunks interned in a
+// ContentStore, so every level made of the same chunks shares them.
+// Chunks on the right and bottom edges are padded with TILE_EMPTY.
+class ChunkedLevel
+{
+	public:
+
+	static constexpr std::size_t CHUNK_SIZE = 16;
+
+	private:
+
+	std::size_t width_ = 0;
+	std::size_t height_ = 0;
+	std::size_t chunks_x_ = 0;
+	std::size_t chunks_y_ = 0;
+	std::vector<std::shared_ptr<const ContentBlob>> chunks_;
+	Jlib::Point2f spawn_;
+
+	public:
+
+	// Default constructor.
+	// The ChunkedLevel is empty.
+	ChunkedLevel() = default;
+
+	// Level constructor.
+	// Splits the layout of level into chunks interned in store.
+	ChunkedLevel(const Level& level, ContentStore& store);
+
+	// Returns the width of the level in tiles.
+	std::size_t width() const;
+
+	// Returns the height of the level in tiles.
+	std::size_t height() const;
+
+	// Returns where the player starts.
+	Jlib::Point2f spawn() const;
+
+	// Returns the amount of chunks, shared or not.
+	std::size_t chunkCount() const;
+
+	// Returns the tile at (x, y).
+	// This function will throw if (x, y) is outside of the level.
+	std::uint8_t at(std::size_t x, std::size_t y) const;
+
+	// Writes the tiles into layout, resizing it to fit.
+	void copyTo(Jlib::Matrix<std::uint8_t>& layout) const;
+
+	// Returns the level as a Level.
+	Level toLevel() const;
+};
+
+// What LevelCache::load had to do for each level, counted since construction.
+struct LevelCacheStats
+{
+	// The same contents were already loaded; nothing was read.
+	std::size_t memory_hits = 0;
+
+	// Read from the disk cache; the source was not parsed.
+	std::size_t disk_hits = 0;
+
+	// Parsed from the source and added to the disk cache.
+	std::size_t parses = 0;
+};
+
+// Loads level files through a content-addressed cache.
+//  - Each parsed level is written to the cache directory in a binary
+//    form named after the content_hash of its source, and later runs
+//    read that instead of parsing the source again.
+//  - The index in the cache directory maps each source path to its
+//    modification time, size and hash. While those match, the
+//    source is not even read. Changes are appended to the index,
+//    which is compacted by the next LevelCache on the directory.
+//  - The binary form of contents no source has any more is removed.
+//  - Loaded levels with the same source contents are the same
+//    ChunkedLevel, and every level shares equal chunks through the
+//    ContentStore, so memory grows with distinct content only.
+// Safe to use from several threads at once, such as AssetManager workers.
+class LevelCache
+{
+	struct IndexEntry
+	{
+		std::int64_t modified = 0;
+		std::uint64_t size = 0;
+		std::uint64_t hash = 0;
+	};
+
+	std::string directory_;
+	ContentStore& store_;
+
+	mutable std::mutex mutex_;
+	std::unordered_map<std::string, IndexEntry> index_;
+	std::unordered_map<std::uint64_t, std::weak_ptr<const ChunkedLevel>> loaded_;
+	LevelCacheStats stats_;
+
+	// Returns the path of the cached binary form of the source with the given hash.
+	std::string binaryPath(std::uint64_t hash) const;
+
+	// Rewrites the index with one line per source.
+	void writeIndex() const;
+
+	// Removes the cached binary form of the source with the given hash,
+	// unless a source in the index still has that hash.
+	void removeUnused(std::uint64_t hash) const;
+
+	// Returns the loaded level with the given source hash, or nullptr if there is none.
+	std::shared_ptr<const ChunkedLevel> findLoaded(std::uint64_t hash);
+
+	// Remembers level as the one loaded from the given source hash,
+	// unless another thread got there first, and returns the one kept.
+	std::shared_ptr<const ChunkedLevel> addLoaded(std::uint64_t hash, std::shared_ptr<const ChunkedLevel> level);
+
+	public:
+
+	// Directory constructor.
+	// Keeps the cache in the given directory, creating it if needed,
+	// and interns chunks in store, which must outlive the LevelCache.
+	// This function will throw if the directory cannot be created.
+	LevelCache(const std::string& directory, ContentStore& store);
+
+	// Copy constructor. Deleted.
+	LevelCache(const LevelCache& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	LevelCache& operator = (const LevelCache& other) = delete;
+
+	// Loads the level file at the given path, from memory or the disk
+	// cache when its contents have not changed.
+	// A cache that cannot be written is skipped.
+	// This function will throw if the file cannot be read or is not a valid level.
+	std::shared_ptr<const ChunkedLevel> load(const std::string& path);
+
+	// Returns what load had to do so far.
+	LevelCacheStats stats() const;
+};
+
+#endif // LEVELCACHE_H_INCLUDED
@@ -0,0 +1,300 @@
+// 2D Platform Game
+// LevelGenerator.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the LevelGenerator class.
+
+#include "LevelGenerator.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint64_t;
+
+// <stdexcept>
+using std::invalid_argument;
+
+namespace
+{
+	// Salts, so each use of the noise sees different values.
+	constexpr uint64_t TERRAIN_SALT = 0x7465727261696E00;
+	constexpr uint64_t CAVE_SALT = 0x6361766573000000;
+	constexpr uint64_t TUNNEL_SALT = 0x74756E6E656C0000;
+	constexpr uint64_t PLATFORM_SALT = 0x706C6174666F726D;
+
+	// Tunnels are carved where their noise is within this of 0.5.
+	constexpr float TUNNEL_WIDTH = 0.025f;
+
+	// Distance between cave noise samples, which must divide CHUNK_SIZE.
+	constexpr int32_t CAVE_STEP = 4;
+	constexpr int32_t CAVE_SAMPLES = LevelGenerator::CHUNK_SIZE / CAVE_STEP + 1;
+
+	uint64_t mix(uint64_t h)
+	{
+		h ^= h >> 30;
+		h *= 0xBF58476D1CE4E5B9;
+		h ^= h >> 27;
+		h *= 0x94D049BB133111EB;
+		h ^= h >> 31;
+		return h;
+	}
+
+	uint64_t hash(uint64_t seed, int32_t x, int32_t y)
+	{
+		return mix(seed ^ (uint64_t(std::uint32_t(x)) * 0xC2B2AE3D27D4EB4F) ^ (uint64_t(std::uint32_t(y)) * 0x165667B19E3779F9));
+	}
+
+	// Returns a value in [0, 1) for the lattice point (x, y).
+	float lattice(uint64_t seed, int32_t x, int32_t y)
+	{
+		return float(hash(seed, x, y) >> 40) * (1.0f / 16777216.0f);
+	}
+
+	float smooth(float t)
+	{
+		return t * t * (3.0f - 2.0f * t);
+	}
+
+	float lerp(float a, float b, float t)
+	{
+		return a + (b - a) * t;
+	}
+
+	float value_noise(uint64_t seed, float x)
+	{
+		const float fx = std::floor(x);
+		const int32_t ix = int32_t(fx);
+
+		return lerp(lattice(seed, ix, 0), lattice(seed, ix + 1, 0), smooth(x - fx));
+	}
+
+	float value_noise(uint64_t seed, float x, float y)
+	{
+		const float fx = std::floor(x);
+		const float fy = std::floor(y);
+		const int32_t ix = int32_t(fx);
+		const int32_t iy = int32_t(fy);
+		const float tx = smooth(x - fx);
+
+		const float top = lerp(lattice(seed, ix, iy), lattice(seed, ix + 1, iy), tx);
+		const float bottom = lerp(lattice(seed, ix, iy + 1), lattice(seed, ix + 1, iy + 1), tx);
+
+		return lerp(top, bottom, smooth(y - fy));
+	}
+
+	// Sums octaves of noise, each twice as fine and half as strong as
+	// the last, scaled back to [0, 1].
+	float fractal_noise(uint64_t seed, float x, int octaves)
+	{
+		float sum = 0.0f;
+		float weight = 1.0f;
+		float total = 0.0f;
+
+		for (int i = 0; i < octaves; ++i)
+		{
+			sum += value_noise(seed + uint64_t(i), x) * weight;
+			total += weight;
+			x *= 2.0f;
+			weight *= 0.5f;
+		}
+
+		return sum / total;
+	}
+
+	float fractal_noise(uint64_t seed, float x, float y, int octaves)
+	{
+		float sum = 0.0f;
+		float weight = 1.0f;
+		float total = 0.0f;
+
+		for (int i = 0; i < octaves; ++i)
+		{
+			sum += value_noise(seed + uint64_t(i), x, y) * weight;
+			total += weight;
+			x *= 2.0f;
+			y *= 2.0f;
+			weight *= 0.5f;
+		}
+
+		return sum / total;
+	}
+}
+
+LevelGenerator::LevelGenerator(const GeneratorSettings& settings)
+{
+	if (!(settings.terrain_scale > 0.0f) || !(settings.cave_scale > 0.0f))
+		throw invalid_argument("LevelGenerator: scales must be positive");
+
+	if (settings.cave_depth < 0)
+		throw invalid_argument("LevelGenerator: cave_depth must not be negative");
+
+	settings_ = settings;
+}
+
+const GeneratorSettings& LevelGenerator::settings() const
+{
+	return settings_;
+}
+
+int32_t LevelGenerator::surfaceHeight(int32_t x) const
+{
+	const float noise = fractal_noise(settings_.seed ^ TERRAIN_SALT, float(x) / settings_.terrain_scale, 4);
+
+	return settings_.ground_level + int32_t(std::lround((noise - 0.5f) * 2.0f * settings_.terrain_amplitude));
+}
+
+void LevelGenerator::generateChunk(int32_t chunk_x, int32_t chunk_y, uint8_t* tiles) const
+{
+	const int32_t left = chunk_x * CHUNK_SIZE;
+	const int32_t top = chunk_y * CHUNK_SIZE;
+	const uint64_t cave_seed = settings_.seed ^ CAVE_SALT;
+	const uint64_t tunnel_seed = settings_.seed ^ TUNNEL_SALT;
+	const float cave_frequency = 1.0f / settings_.cave_scale;
+	const float tunnel_frequency = cave_frequency * 0.5f;
+
+	int32_t surface[CHUNK_SIZE];
+	int32_t lowest_surface = surface[0] = surfaceHeight(left);
+
+	for (int32_t c = 1; c < CHUNK_SIZE; ++c)
+	{
+		surface[c] = surfaceHeight(left + c);
+		lowest_surface = std::min(lowest_surface, surface[c]);
+	}
+
+	// The cave noise is only evaluated every CAVE_STEP tiles, at world
+	// positions shared with the neighbouring chunks, and blended in
+	// between. The finest octave is still a few steps wide.
+	float cave[CAVE_SAMPLES][CAVE_SAMPLES];
+	float tunnel[CAVE_SAMPLES][CAVE_SAMPLES];
+	const bool has_caves = top + CHUNK_SIZE > lowest_surface + settings_.cave_depth;
+
+	for (int32_t i = 0; has_caves && i < CAVE_SAMPLES; ++i)
+	{
+		const float y = float(top + i * CAVE_STEP);
+
+		for (int32_t j = 0; j < CAVE_SAMPLES; ++j)
+		{
+			const float x = float(left + j * CAVE_STEP);
+
+			cave[i][j] = fractal_noise(cave_seed, x * cave_frequency, y * cave_frequency, 3);
+			tunnel[i][j] = value_noise(tunnel_seed, x * tunnel_frequency, y * tunnel_frequency);
+		}
+	}
+
+	for (int32_t r = 0; r < CHUNK_SIZE; ++r)
+	{
+		const int32_t y = top + r;
+		const int32_t i = r / CAVE_STEP;
+		const float ty = float(r % CAVE_STEP) * (1.0f / CAVE_STEP);
+		uint8_t* row = tiles + size_t(r) * CHUNK_SIZE;
+
+		for (int32_t c = 0; c < CHUNK_SIZE; ++c)
+		{
+			if (y < surface[c])
+			{
+				row[c] = TILE_EMPTY;
+				continue;
+			}
+
+			bool carved = false;
+
+			if (y >= surface[c] + settings_.cave_depth)
+			{
+				const int32_t j = c / CAVE_STEP;
+				const float tx = float(c % CAVE_STEP) * (1.0f / CAVE_STEP);
+
+				const float cave_value = lerp(lerp(cave[i][j], cave[i][j + 1], tx), lerp(cave[i + 1][j], cave[i + 1][j + 1], tx), ty);
+				const float tunnel_value = lerp(lerp(tunnel[i][j], tunnel[i][j + 1], tx), lerp(tunnel[i + 1][j], tunnel[i + 1][j + 1], tx), ty);
+
+				carved = cave_value > settings_.cave_threshold || std::fabs(tunnel_value - 0.5f) < TUNNEL_WIDTH;
+			}
+
+			row[c] = carved ? TILE_EMPTY : TILE_SOLID;
+		}
+	}
+
+	// Platforms hover 3 to 10 tiles above the ground below their middle,
+	// and are kept inside the chunk so no other chunk needs to know of them.
+	uint64_t h = hash(settings_.seed ^ PLATFORM_SALT, chunk_x, chunk_y);
+
+	for (int32_t i = 0; i < settings_.platforms_per_chunk; ++i)
+	{
+		h = mix(h + uint64_t(i));
+
+		const int32_t length = 3 + int32_t(h % 6);
+		const int32_t start = int32_t((h >> 8) % uint64_t(CHUNK_SIZE - length + 1));
+		const int32_t y = surface[start + length / 2] - 3 - int32_t((h >> 16) % 8);
+		const int32_t r = y - top;
+
+		if (r < 0 || r >= CHUNK_SIZE)
+			continue;
+
+		// Skipped where the ground rises to meet it.
+		bool clear = true;
+
+		for (int32_t c = start; c < start + length; ++c)
+			clear = clear && y < surface[c] - 2;
+
+		if (clear)
+			std::memset(tiles + size_t(r) * CHUNK_SIZE + size_t(start), TILE_SOLID, size_t(length));
+	}
+}
+
+Level LevelGenerator::generateLevel(size_t width, size_t height, ThreadPool* pool) const
+{
+	if (width == 0 || height == 0)
+		throw invalid_argument("LevelGenerator::generateLevel: the level must not be empty");
+
+	const size_t chunks_x = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	const size_t chunks_y = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+	Level level;
+	level.layout.resize(height, width);
+
+	// Chunks write to separate parts of the layout.
+	const auto generate = [&](size_t index)
+	{
+		const size_t chunk_x = index % chunks_x;
+		const size_t chunk_y = index / chunks_x;
+		uint8_t tiles[CHUNK_TILES];
+
+		generateChunk(int32_t(chunk_x), int32_t(chunk_y), tiles);
+
+		const size_t left = chunk_x * CHUNK_SIZE;
+		const size_t top = chunk_y * CHUNK_SIZE;
+		const size_t columns = std::min<size_t>(CHUNK_SIZE, width - left);
+		const size_t rows = std::min<size_t>(CHUNK_SIZE, height - top);
+
+		for (size_t r = 0; r < rows; ++r)
+			std::memcpy(level.layout.data() + (top + r) * width + left, tiles + r * CHUNK_SIZE, columns);
+	};
+
+	if (pool != nullptr)
+		pool->parallelFor(chunks_x * chunks_y, generate);
+	else
+	{
+		for (size_t i = 0; i < chunks_x * chunks_y; ++i)
+			generate(i);
+	}
+
+	const int32_t spawn_x = std::min<int32_t>(2, int32_t(width) - 1);
+	const int32_t spawn_y = std::clamp<int32_t>(surfaceHeight(spawn_x) - 1, 0, int32_t(height) - 1);
+
+	level.spawn.x = float(spawn_x);
+	level.spawn.y = float(spawn_y);
+
+	return level;
+}
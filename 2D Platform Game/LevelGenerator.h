@@ -0,0 +1,93 @@
+// 2D Platform Game
+// LevelGenerator.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the LevelGenerator class.
+
+#ifndef LEVELGENERATOR_H_INCLUDED
+#define LEVELGENERATOR_H_INCLUDED
+
+#include "Level.h"
+
+#include "Jlib/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Settings of a LevelGenerator. Lengths are in tiles.
+struct GeneratorSettings
+{
+	std::uint64_t seed = 0;
+
+	// Row of the ground surface before terrain noise moves it, and how
+	// far up or down the noise may move it.
+	std::int32_t ground_level = 32;
+	float terrain_amplitude = 12.0f;
+
+	// Width of the widest hills.
+	float terrain_scale = 64.0f;
+
+	// Size of the largest caves, and the noise value above which a
+	// tile is carved out. Higher thresholds give fewer, smaller caves.
+	float cave_scale = 24.0f;
+	float cave_threshold = 0.6f;
+
+	// Caves only start this many tiles below the surface, so the
+	// surface is never carved open.
+	std::int32_t cave_depth = 4;
+
+	// Most platforms placed in the air of each chunk.
+	std::int32_t platforms_per_chunk = 3;
+};
+
+// Generates an endless level made of chunks of CHUNK_SIZE by CHUNK_SIZE
+// tiles, in the tile format of Tile.h.
+// Terrain height and caves come from value noise evaluated at world
+// coordinates, and platforms are placed from a hash of the chunk
+// coordinate, so every tile depends only on the seed and its chunk:
+// chunks can be generated in any order, on any thread, and always
+// match their neighbours. The results are the same across runs of the
+// same build; floating point differences between compilers may change
+// them.
+// Chunk (0, 0) covers tiles (0, 0) to (CHUNK_SIZE - 1, CHUNK_SIZE - 1).
+// y grows downwards, so the ground is at positive chunk rows.
+class LevelGenerator
+{
+	public:
+
+	static constexpr std::int32_t CHUNK_SIZE = 32;
+	static constexpr std::size_t CHUNK_TILES = std::size_t(CHUNK_SIZE) * std::size_t(CHUNK_SIZE);
+
+	private:
+
+	GeneratorSettings settings_;
+
+	public:
+
+	// Default constructor.
+	// Uses the default GeneratorSettings.
+	LevelGenerator() = default;
+
+	// Settings constructor.
+	// This function will throw if a scale is not positive or cave_depth is negative.
+	explicit LevelGenerator(const GeneratorSettings& settings);
+
+	// Returns the settings.
+	const GeneratorSettings& settings() const;
+
+	// Returns the row of the topmost ground tile in column x.
+	std::int32_t surfaceHeight(std::int32_t x) const;
+
+	// Writes the given chunk to tiles, CHUNK_TILES of them, row by row.
+	// Safe to call from several threads at once.
+	void generateChunk(std::int32_t chunk_x, std::int32_t chunk_y, std::uint8_t* tiles) const;
+
+	// Generates the tiles (0, 0) to (width - 1, height - 1) as a Level,
+	// one chunk per parallelFor index when pool is not nullptr.
+	// The spawn is in the air above the surface near the left edge.
+	// This function will throw if width or height is 0.
+	Level generateLevel(std::size_t width, std::size_t height, Jlib::ThreadPool* pool = nullptr) const;
+};
+
+#endif // LEVELGENERATOR_H_INCLUDED
@@ -0,0 +1,299 @@
+// 2D Platform Game
+// LevelReloader.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the LevelReloader class.
+
+#include "LevelReloader.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// <chrono>
+using std::chrono::duration;
+using std::chrono::milliseconds;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+
+// <fstream>
+using std::ifstream;
+
+// <memory>
+using std::make_unique;
+using std::unique_ptr;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+// <string_view>
+using std::string_view;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	bool is_space(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+	}
+
+	// Returns the amount of characters in line that are not whitespace.
+	size_t tile_count(string_view line)
+	{
+		size_t count = 0;
+
+		for (char c : line)
+			count += is_space(c) ? 0 : 1;
+
+		return count;
+	}
+
+	// Splits text into lines, dropping trailing lines with nothing but whitespace.
+	void split_lines(const vector<char>& text, vector<string_view>& lines)
+	{
+		const string_view all(text.data(), text.size());
+		size_t start = 0;
+
+		lines.clear();
+
+		while (start <= all.size())
+		{
+			size_t end = all.find('\n', start);
+
+			if (end == string_view::npos)
+				end = all.size();
+
+			lines.push_back(all.substr(start, end - start));
+			start = end + 1;
+		}
+
+		while (!lines.empty() && tile_count(lines.back()) == 0)
+			lines.pop_back();
+	}
+
+	double milliseconds_between(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+	{
+		return duration<double, std::milli>(end - begin).count();
+	}
+}
+
+LevelReloader::LevelReloader(const string& path)
+	: watcher_(path)
+{
+	thread_ = std::thread(&LevelReloader::run, this);
+}
+
+LevelReloader::~LevelReloader()
+{
+	stopping_.store(true, std::memory_order_relaxed);
+	thread_.join();
+}
+
+void LevelReloader::findRowLines()
+{
+	const size_t width = current_.layout.colSize();
+	const size_t height = current_.layout.rowSize();
+
+	row_per_line_ = false;
+
+	// The last lines of a layered file are the foreground, not the
+	// collision rows, so layered files are always parsed in full.
+	if (height == 0 || lines_.size() < height || is_layered_level(text_.data(), text_.size()))
+		return;
+
+	first_row_line_ = lines_.size() - height;
+
+	for (size_t i = first_row_line_; i < lines_.size(); ++i)
+	{
+		if (tile_count(lines_[i]) != width)
+			return;
+	}
+
+	row_per_line_ = true;
+}
+
+unique_ptr<LevelReloader::Reload> LevelReloader::reload(Clock::time_point written)
+{
+	const Clock::time_point start = Clock::now();
+
+	ifstream fin(watcher_.path(), std::ios::binary | std::ios::ate);
+
+	if (!fin.is_open())
+		throw runtime_error("LevelReloader: could not open " + watcher_.path());
+
+	next_text_.resize(size_t(fin.tellg()));
+	fin.seekg(0);
+
+	if (!fin.read(next_text_.data(), std::streamsize(next_text_.size())))
+		throw runtime_error("LevelReloader: could not read " + watcher_.path());
+
+	split_lines(next_text_, next_lines_);
+
+	const vector<string_view>& lines = next_lines_;
+	const size_t width = current_.layout.colSize();
+
+	// Only tile rows changed if the lines before them did not, and
+	// every changed row still has one tile per column.
+	bool full_parse = !(row_per_line_ && lines.size() == lines_.size() && std::equal(lines.begin(), lines.begin() + first_row_line_, lines_.begin()));
+	size_t parsed_rows = 0;
+
+	for (size_t i = first_row_line_; !full_parse && i < lines.size(); ++i)
+	{
+		if (lines[i] != lines_[i] && tile_count(lines[i]) != width)
+			full_parse = true;
+	}
+
+	if (full_parse)
+	{
+		current_ = parse_level(next_text_.data(), next_text_.size());
+		parsed_rows = current_.layout.rowSize();
+	}
+	else
+	{
+		for (size_t i = first_row_line_; i < lines.size(); ++i)
+		{
+			if (lines[i] == lines_[i])
+				continue;
+
+			uint8_t* tile = current_.layout.data() + (i - first_row_line_) * width;
+
+			for (char c : lines[i])
+			{
+				if (!is_space(c))
+					*tile++ = uint8_t(c);
+			}
+
+			++parsed_rows;
+		}
+	}
+
+	// The lines point into the text, and swapping vectors keeps them valid.
+	text_.swap(next_text_);
+	lines_.swap(next_lines_);
+
+	if (full_parse)
+		findRowLines();
+
+	unique_ptr<Reload> next;
+
+	{
+		lock_guard<mutex> lock(mutex_);
+		next = std::move(recycled_);
+	}
+
+	if (!next)
+		next = make_unique<Reload>();
+
+	// Reuses the recycled buffer when it is big enough.
+	next->level.layout = current_.layout;
+	next->level.spawn = current_.spawn;
+	next->parsed_rows = parsed_rows;
+	next->full_parse = full_parse;
+	next->written = written;
+	next->parse_milliseconds = milliseconds_between(start, Clock::now());
+	return next;
+}
+
+void LevelReloader::run()
+{
+	// What the file holds now is what changes are found against.
+	try
+	{
+		reload(Clock::now());
+	}
+	catch (const std::exception& e)
+	{
+		lock_guard<mutex> lock(mutex_);
+		error_ = e.what();
+	}
+
+	while (!stopping_.load(std::memory_order_relaxed))
+	{
+		if (!watcher_.wait(milliseconds(100)))
+			continue;
+
+		const Clock::time_point written = Clock::now();
+
+		try
+		{
+			unique_ptr<Reload> next = reload(written);
+
+			lock_guard<mutex> lock(mutex_);
+			ready_ = std::move(next);
+			error_.clear();
+		}
+		catch (const std::exception& e)
+		{
+			lock_guard<mutex> lock(mutex_);
+			error_ = e.what();
+		}
+	}
+}
+
+bool LevelReloader::apply(Matrix<uint8_t>& layout, Point2f& player_position, ReloadReport* report)
+{
+	unique_ptr<Reload> reload;
+
+	{
+		lock_guard<mutex> lock(mutex_);
+		reload = std::move(ready_);
+	}
+
+	if (!reload)
+		return false;
+
+	const Clock::time_point start = Clock::now();
+
+	layout.swap(reload->level.layout);
+
+	const bool player_moved = is_solid_at(layout, int32_t(std::floor(player_position.x)), int32_t(std::floor(player_position.y)));
+
+	if (player_moved)
+		player_position = reload->level.spawn;
+
+	const Clock::time_point end = Clock::now();
+
+	if (report != nullptr)
+	{
+		report->parsed_rows = reload->parsed_rows;
+		report->full_parse = reload->full_parse;
+		report->player_moved = player_moved;
+		report->parse_milliseconds = reload->parse_milliseconds;
+		report->latency_milliseconds = milliseconds_between(reload->written, end);
+		report->swap_milliseconds = milliseconds_between(start, end);
+	}
+
+	lock_guard<mutex> lock(mutex_);
+	recycled_ = std::move(reload);
+
+	return true;
+}
+
+string LevelReloader::lastError() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return error_;
+}
@@ -0,0 +1,140 @@
+// 2D Platform Game
+// LevelReloader.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the LevelReloader class.
+
+#ifndef LEVELRELOADER_H_INCLUDED
+#define LEVELRELOADER_H_INCLUDED
+
+#include "FileWatcher.h"
+#include "Level.h"
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// What happened during the last reload applied by LevelReloader::apply.
+struct ReloadReport
+{
+	// Amount of tile rows parsed again, or the level height after a full parse.
+	std::size_t parsed_rows = 0;
+
+	// True if the whole file was parsed, because more than tile rows changed.
+	bool full_parse = false;
+
+	// True if the player was moved to the spawn, because their
+	// position was outside of the new level or inside a solid tile.
+	bool player_moved = false;
+
+	// Milliseconds spent reading and parsing on the background thread.
+	double parse_milliseconds = 0.0;
+
+	// Milliseconds from the FileWatcher noticing the write to the new level being in use.
+	double latency_milliseconds = 0.0;
+
+	// Milliseconds the swap took on the calling thread.
+	double swap_milliseconds = 0.0;
+};
+
+// Reloads a level file whenever it is written, without restarting.
+// A background thread waits on a FileWatcher and reads the file again.
+// When only tile rows changed and the file has one row per line, as
+// level.txt does, only the changed lines are parsed, into a copy of
+// the previous layout. Anything else, layered files included, is
+// parsed in full.
+// apply, called between ticks, swaps the new layout in. The swap only
+// exchanges buffers, and the old buffer goes back to the background
+// thread, so apply costs the same for any level size.
+// A file that fails to parse, such as one caught half written, is
+// skipped until it is written again; see lastError.
+class LevelReloader
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct Reload
+	{
+		Level level;
+		std::size_t parsed_rows = 0;
+		bool full_parse = false;
+		double parse_milliseconds = 0.0;
+		Clock::time_point written;
+	};
+
+	FileWatcher watcher_;
+
+	// Background thread only: the last text read, split into lines,
+	// and the level parsed from it. The next_ members are kept so
+	// reading reuses their storage.
+	std::vector<char> text_;
+	std::vector<std::string_view> lines_;
+	std::vector<char> next_text_;
+	std::vector<std::string_view> next_lines_;
+	std::size_t first_row_line_ = 0;
+	bool row_per_line_ = false;
+	Level current_;
+
+	mutable std::mutex mutex_;
+	std::unique_ptr<Reload> ready_;
+	std::string error_;
+
+	// The last Reload applied, holding the layout swapped out, so its
+	// buffer is reused by the next reload instead of being freed by apply.
+	std::unique_ptr<Reload> recycled_;
+
+	std::atomic<bool> stopping_ = false;
+	std::thread thread_;
+
+	// Reads the file and builds the next Reload from the changes since
+	// the last one. Runs on the background thread.
+	std::unique_ptr<Reload> reload(Clock::time_point written);
+
+	// Remembers the tile row layout of lines_ for the next reload.
+	void findRowLines();
+
+	// Body of the background thread.
+	void run();
+
+	public:
+
+	// Path constructor.
+	// Watches the level file at path. Changes are reported against
+	// what the file holds when the background thread starts.
+	// This function will throw if the file cannot be watched.
+	explicit LevelReloader(const std::string& path);
+
+	// Copy constructor. Deleted.
+	LevelReloader(const LevelReloader& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	LevelReloader& operator = (const LevelReloader& other) = delete;
+
+	// Destructor.
+	// Stops the background thread.
+	~LevelReloader();
+
+	// Swaps in the most recently reloaded level, if one is ready.
+	// Call between ticks, so a tick never sees half of each level.
+	// player_position is kept if it is inside the new level and not
+	// inside a solid tile, and moved to the new spawn otherwise.
+	// If report is not nullptr, it is filled in.
+	// Returns true if a level was swapped in.
+	// Returns false otherwise.
+	bool apply(Jlib::Matrix<std::uint8_t>& layout, Jlib::Point2f& player_position, ReloadReport* report = nullptr);
+
+	// Returns why the last reload failed, or an empty string if it did not.
+	std::string lastError() const;
+};
+
+#endif // LEVELRELOADER_H_INCLUDED
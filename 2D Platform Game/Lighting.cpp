@@ -0,0 +1,522 @@
+// 2D Platform Game
+// Lighting.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for field of view and the LightMap class.
+
+#include "Lighting.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+
+// Jlib/Color.h
+using Jlib::Color;
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+using Jlib::Point2i;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// <cmath>
+using std::floor;
+using std::sqrt;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// <stdexcept>
+using std::invalid_argument;
+using std::out_of_range;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// Maps the (dx, dy) of octant 0 onto each of the 8 octants:
+	// x = dx * m[0] + dy * m[1], y = dx * m[2] + dy * m[3].
+	constexpr int32_t OCTANTS[8][4] =
+	{
+		{ 1, 0, 0, 1 }, { 0, 1, 1, 0 }, { 0, -1, 1, 0 }, { -1, 0, 0, 1 },
+		{ -1, 0, 0, -1 }, { 0, -1, -1, 0 }, { 0, 1, -1, 0 }, { 1, 0, 0, -1 }
+	};
+
+	// Scratch space for lighting a single tile area, one set per thread.
+	// A tile has been visited by the current search if its stamp
+	// equals stamp, so nothing needs clearing between searches.
+	struct AreaScratch
+	{
+		vector<uint32_t> stamps;
+		uint32_t stamp = 0;
+		int32_t side = 0;
+		vector<int32_t> queue;
+
+		// Starts a search covering the tiles within radius of the centre.
+		void begin(int32_t radius)
+		{
+			side = 2 * radius + 1;
+
+			if (stamps.size() < size_t(side) * size_t(side))
+				stamps.resize(size_t(side) * size_t(side), 0);
+
+			if (++stamp == 0)
+			{
+				std::fill(stamps.begin(), stamps.end(), 0);
+				stamp = 1;
+			}
+		}
+
+		// Returns true the first time it is called for the tile (dx, dy)
+		// away from the centre during a search.
+		bool visit(int32_t dx, int32_t dy)
+		{
+			uint32_t& tile_stamp = stamps[size_t(dy + side / 2) * size_t(side) + size_t(dx + side / 2)];
+
+			if (tile_stamp == stamp)
+				return false;
+
+			tile_stamp = stamp;
+			return true;
+		}
+	};
+
+	thread_local AreaScratch area_scratch;
+
+	// Scans the rows of one octant from row outwards, between the
+	// slopes start and end, calling visit(x, y, dx, dy) on every tile
+	// within radius. Each wall narrows the scan and starts a new scan
+	// for the rows behind it.
+	template <typename F>
+	void cast_octant(const Matrix<uint8_t>& level, int32_t cx, int32_t cy, int32_t radius, int32_t row,
+					 float start, float end, const int32_t* m, F& visit)
+	{
+		if (start < end)
+			return;
+
+		const int32_t radius_squared = radius * radius;
+		float new_start = 0.0f;
+
+		for (int32_t j = row; j <= radius; ++j)
+		{
+			const int32_t dy = -j;
+			bool blocked = false;
+
+			for (int32_t dx = -j; dx <= 0; ++dx)
+			{
+				const float left_slope = (float(dx) - 0.5f) / (float(dy) + 0.5f);
+				const float right_slope = (float(dx) + 0.5f) / (float(dy) - 0.5f);
+
+				if (start < right_slope)
+					continue;
+
+				if (end > left_slope)
+					break;
+
+				const int32_t x = cx + dx * m[0] + dy * m[1];
+				const int32_t y = cy + dx * m[2] + dy * m[3];
+
+				if (dx * dx + dy * dy <= radius_squared)
+					visit(x, y, dx, dy);
+
+				const bool solid = is_solid_at(level, x, y);
+
+				if (blocked)
+				{
+					if (solid)
+					{
+						new_start = right_slope;
+						continue;
+					}
+
+					blocked = false;
+					start = new_start;
+				}
+				else if (solid && j < radius)
+				{
+					blocked = true;
+					cast_octant(level, cx, cy, radius, j + 1, start, left_slope, m, visit);
+					new_start = right_slope;
+				}
+			}
+
+			if (blocked)
+				break;
+		}
+	}
+
+	// Calls visit(x, y, dx, dy) once for every tile visible from
+	// (cx, cy) within radius, including (cx, cy) itself.
+	template <typename F>
+	void shadowcast(const Matrix<uint8_t>& level, int32_t cx, int32_t cy, int32_t radius, F& visit)
+	{
+		AreaScratch& scratch = area_scratch;
+		scratch.begin(radius);
+
+		// Tiles on the edge between 2 octants are scanned by both.
+		auto visit_once = [&](int32_t x, int32_t y, int32_t, int32_t)
+		{
+			if (scratch.visit(x - cx, y - cy))
+				visit(x, y, x - cx, y - cy);
+		};
+
+		visit_once(cx, cy, 0, 0);
+
+		for (const int32_t* m : OCTANTS)
+			cast_octant(level, cx, cy, radius, 1, 1.0f, 0.0f, m, visit_once);
+	}
+}
+
+void field_of_view(const Matrix<uint8_t>& level, const Point2i& origin, int32_t radius, vector<Point2i>& visible)
+{
+	if (radius < 0)
+		throw invalid_argument("field_of_view: radius must not be negative");
+
+	visible.clear();
+
+	if (origin.x < 0 || origin.y < 0 || size_t(origin.x) >= level.colSize() || size_t(origin.y) >= level.rowSize())
+		return;
+
+	auto visit = [&](int32_t x, int32_t y, int32_t, int32_t)
+	{
+		if (x >= 0 && y >= 0 && size_t(x) < level.colSize() && size_t(y) < level.rowSize())
+			visible.emplace_back(x, y);
+	};
+
+	shadowcast(level, origin.x, origin.y, radius, visit);
+}
+
+LightMap::LightMap(const Matrix<uint8_t>& level, ThreadPool* pool)
+{
+	setLevel(level, pool);
+}
+
+LightMap::Light& LightMap::lightAt(uint32_t id)
+{
+	if (id >= lights_.size() || !lights_[id].active)
+		throw out_of_range("LightMap: no light with the given id");
+
+	return lights_[id];
+}
+
+void LightMap::markDirty(uint32_t id)
+{
+	if (!lights_[id].dirty)
+	{
+		lights_[id].dirty = true;
+		dirty_lights_.push_back(id);
+	}
+}
+
+void LightMap::apply(const Light& light, int32_t sign)
+{
+	// Unsigned wraparound makes removing exactly undo adding.
+	const uint32_t red = uint32_t(sign * int32_t(light.applied_color.red));
+	const uint32_t green = uint32_t(sign * int32_t(light.applied_color.green));
+	const uint32_t blue = uint32_t(sign * int32_t(light.applied_color.blue));
+
+	for (const LitTile& tile : light.lit)
+	{
+		const int32_t x = tile.x - window_x_;
+		const int32_t y = tile.y - window_y_;
+
+		if (uint32_t(x) >= uint32_t(window_width_) || uint32_t(y) >= uint32_t(window_height_))
+			continue;
+
+		uint32_t* total = totals_.data() + (size_t(y) * size_t(window_width_) + size_t(x)) * 3;
+		total[0] += red * tile.level;
+		total[1] += green * tile.level;
+		total[2] += blue * tile.level;
+	}
+
+	buffer_dirty_ = true;
+}
+
+void LightMap::computeLight(Light& light) const
+{
+	light.lit.clear();
+
+	const Matrix<uint8_t>& level = *level_;
+	const int32_t cx = light.tile.x;
+	const int32_t cy = light.tile.y;
+	const int32_t radius = light.radius;
+
+	if (is_solid_at(level, cx, cy))
+		return;
+
+	// Brightness at distance d is peak * (1 - d / radius).
+	const float peak = 255.0f * float(light.color.alpha) / 255.0f;
+	const float fade = peak / float(radius);
+
+	auto light_tile = [&](int32_t x, int32_t y, float distance)
+	{
+		const float brightness = peak - fade * distance;
+
+		if (brightness >= 0.5f && x >= 0 && y >= 0 && size_t(x) < level.colSize() && size_t(y) < level.rowSize())
+			light.lit.push_back(LitTile { x, y, uint8_t(brightness + 0.5f) });
+	};
+
+	if (light.mode == LightMode::Shadowcast)
+	{
+		auto visit = [&](int32_t x, int32_t y, int32_t dx, int32_t dy)
+		{
+			light_tile(x, y, sqrt(float(dx * dx + dy * dy)));
+		};
+
+		shadowcast(level, cx, cy, radius, visit);
+		return;
+	}
+
+	// Breadth first, one ring of steps at a time. Solid tiles are lit
+	// but do not pass the light on.
+	AreaScratch& scratch = area_scratch;
+	scratch.begin(radius);
+
+	vector<int32_t>& queue = scratch.queue;
+	queue.clear();
+	queue.push_back(radius * scratch.side + radius);
+	scratch.visit(0, 0);
+
+	constexpr int32_t STEP_X[4] = { -1, 1, 0, 0 };
+	constexpr int32_t STEP_Y[4] = { 0, 0, -1, 1 };
+
+	size_t ring_begin = 0;
+
+	for (int32_t steps = 0; steps < radius && ring_begin < queue.size(); ++steps)
+	{
+		const size_t ring_end = queue.size();
+
+		for (size_t i = ring_begin; i < ring_end; ++i)
+		{
+			// Offsets from the light are packed as (dy + radius) * side + (dx + radius).
+			const int32_t dx = queue[i] % scratch.side - radius;
+			const int32_t dy = queue[i] / scratch.side - radius;
+			const int32_t x = cx + dx;
+			const int32_t y = cy + dy;
+
+			light_tile(x, y, float(steps));
+
+			if (steps + 1 >= radius || is_solid_at(level, x, y))
+				continue;
+
+			for (int32_t n = 0; n < 4; ++n)
+			{
+				if (scratch.visit(dx + STEP_X[n], dy + STEP_Y[n]))
+					queue.push_back((dy + STEP_Y[n] + radius) * scratch.side + dx + STEP_X[n] + radius);
+			}
+		}
+
+		ring_begin = ring_end;
+	}
+}
+
+void LightMap::setLevel(const Matrix<uint8_t>& level, ThreadPool* pool)
+{
+	level_ = &level;
+	pool_ = pool;
+
+	for (uint32_t id = 0; id < lights_.size(); ++id)
+	{
+		if (lights_[id].active)
+			markDirty(id);
+	}
+}
+
+void LightMap::setWindow(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	if (width < 0 || height < 0)
+		throw invalid_argument("LightMap::setWindow: width and height must not be negative");
+
+	window_x_ = x;
+	window_y_ = y;
+	window_width_ = width;
+	window_height_ = height;
+
+	totals_.assign(size_t(width) * size_t(height) * 3, 0);
+	buffer_.resize(size_t(width) * size_t(height));
+
+	// Dirty lights are added too, so update can take them away again.
+	for (const Light& light : lights_)
+	{
+		if (light.active)
+			apply(light, 1);
+	}
+
+	buffer_dirty_ = true;
+}
+
+void LightMap::setAmbient(const Color& color)
+{
+	ambient_ = color;
+	buffer_dirty_ = true;
+}
+
+uint32_t LightMap::addLight(const Point2f& position, const Color& color, int32_t radius, LightMode mode)
+{
+	if (radius < 1)
+		throw invalid_argument("LightMap::addLight: radius must be at least 1");
+
+	uint32_t id;
+
+	if (free_lights_.empty())
+	{
+		id = uint32_t(lights_.size());
+		lights_.emplace_back();
+	}
+	else
+	{
+		id = free_lights_.back();
+		free_lights_.pop_back();
+	}
+
+	Light& light = lights_[id];
+	light.tile = Point2i(int32_t(floor(position.x)), int32_t(floor(position.y)));
+	light.color = color;
+	light.radius = radius;
+	light.mode = mode;
+	light.active = true;
+	markDirty(id);
+
+	return id;
+}
+
+void LightMap::moveLight(uint32_t id, const Point2f& position)
+{
+	Light& light = lightAt(id);
+	const Point2i tile(int32_t(floor(position.x)), int32_t(floor(position.y)));
+
+	if (tile.x != light.tile.x || tile.y != light.tile.y)
+	{
+		light.tile = tile;
+		markDirty(id);
+	}
+}
+
+void LightMap::setLightColor(uint32_t id, const Color& color)
+{
+	Light& light = lightAt(id);
+
+	if (light.color != color)
+	{
+		light.color = color;
+		markDirty(id);
+	}
+}
+
+void LightMap::removeLight(uint32_t id)
+{
+	Light& light = lightAt(id);
+
+	apply(light, -1);
+	light.lit.clear();
+	light.active = false;
+	free_lights_.push_back(id);
+}
+
+void LightMap::tileChanged(int32_t x, int32_t y)
+{
+	for (uint32_t id = 0; id < lights_.size(); ++id)
+	{
+		const Light& light = lights_[id];
+
+		if (light.active && std::abs(x - light.tile.x) <= light.radius && std::abs(y - light.tile.y) <= light.radius)
+			markDirty(id);
+	}
+}
+
+size_t LightMap::update()
+{
+	size_t recomputed = 0;
+
+	if (!dirty_lights_.empty())
+	{
+		// Removed lights may still be listed; they were taken away already.
+		size_t count = 0;
+
+		for (uint32_t id : dirty_lights_)
+		{
+			lights_[id].dirty = false;
+
+			if (lights_[id].active)
+			{
+				apply(lights_[id], -1);
+				dirty_lights_[count++] = id;
+			}
+		}
+
+		dirty_lights_.resize(count);
+
+		auto compute = [&](size_t i)
+		{
+			computeLight(lights_[dirty_lights_[i]]);
+		};
+
+		if (pool_ != nullptr)
+			pool_->parallelFor(count, compute);
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+				compute(i);
+		}
+
+		for (uint32_t id : dirty_lights_)
+		{
+			lights_[id].applied_color = lights_[id].color;
+			apply(lights_[id], 1);
+		}
+
+		recomputed = count;
+		dirty_lights_.clear();
+	}
+
+	if (buffer_dirty_)
+	{
+		for (size_t i = 0; i < buffer_.size(); ++i)
+		{
+			const uint32_t* total = totals_.data() + i * 3;
+
+			buffer_[i].red = uint8_t(std::min<uint32_t>(255, ambient_.red + (total[0] + 127) / 255));
+			buffer_[i].green = uint8_t(std::min<uint32_t>(255, ambient_.green + (total[1] + 127) / 255));
+			buffer_[i].blue = uint8_t(std::min<uint32_t>(255, ambient_.blue + (total[2] + 127) / 255));
+			buffer_[i].alpha = Color::COLOR_MAX;
+		}
+
+		buffer_dirty_ = false;
+	}
+
+	return recomputed;
+}
+
+Color LightMap::lightLevel(int32_t x, int32_t y) const
+{
+	x -= window_x_;
+	y -= window_y_;
+
+	if (uint32_t(x) >= uint32_t(window_width_) || uint32_t(y) >= uint32_t(window_height_))
+		return ambient_;
+
+	return buffer_[size_t(y) * size_t(window_width_) + size_t(x)];
+}
+
+const vector<Color>& LightMap::buffer() const
+{
+	return buffer_;
+}
+
+size_t LightMap::lightCount() const
+{
+	return lights_.size() - free_lights_.size();
+}
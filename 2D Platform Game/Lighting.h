@@ -0,0 +1,167 @@
+// 2D Platform Game
+// Lighting.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for field of view and the LightMap class.
+
+#ifndef LIGHTING_H_INCLUDED
+#define LIGHTING_H_INCLUDED
+
+#include "Jlib/Color.h"
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Finds every tile visible from origin within radius tiles using
+// recursive shadowcasting, storing them in visible.
+// A tile counts as visible if any part of it can be seen, so this is
+// more generous than line_of_sight between tile centres.
+// Solid tiles are visible but hide the tiles behind them.
+// visible is left empty if origin is outside of the level.
+// This function will throw if radius is negative.
+void field_of_view(const Jlib::Matrix<std::uint8_t>& level, const Jlib::Point2i& origin, std::int32_t radius, std::vector<Jlib::Point2i>& visible);
+
+// The way light spreads from a light source.
+enum class LightMode : std::uint8_t
+{
+	// Lights the tiles the source can see, with hard shadows behind walls.
+	Shadowcast,
+
+	// Spreads from tile to tile through open tiles like a flood fill,
+	// so the light bends around corners, losing strength with each step.
+	Flood
+};
+
+// Per-tile light levels for the visible part of the level.
+// Each light source fades linearly to nothing at its radius. The
+// alpha of its Color scales its brightness. Lights are added
+// together on top of an ambient Color, saturating at full brightness.
+// Every light remembers the tiles it lights, so an update only
+// recomputes lights that moved to another tile, changed, or have a
+// changed tile within their radius, and adjusts the light levels by
+// the difference. Recomputed lights are spread across the ThreadPool
+// if there is one.
+class LightMap
+{
+	struct LitTile
+	{
+		std::int32_t x = 0;
+		std::int32_t y = 0;
+		std::uint8_t level = 0;
+	};
+
+	struct Light
+	{
+		Jlib::Point2i tile;
+		Jlib::Color color;
+		std::int32_t radius = 0;
+		LightMode mode = LightMode::Shadowcast;
+		bool active = false;
+		bool dirty = false;
+
+		// The tiles lit, as of the last update.
+		std::vector<LitTile> lit;
+
+		// The color the lit tiles were added to the totals with.
+		Jlib::Color applied_color;
+	};
+
+	const Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	Jlib::ThreadPool* pool_ = nullptr;
+
+	std::int32_t window_x_ = 0;
+	std::int32_t window_y_ = 0;
+	std::int32_t window_width_ = 0;
+	std::int32_t window_height_ = 0;
+	Jlib::Color ambient_ = Jlib::Color(0, 0, 0);
+
+	std::vector<Light> lights_;
+	std::vector<std::uint32_t> free_lights_;
+	std::vector<std::uint32_t> dirty_lights_;
+
+	// Sum of color * level over every light, per window tile and channel.
+	std::vector<std::uint32_t> totals_;
+	std::vector<Jlib::Color> buffer_;
+	bool buffer_dirty_ = true;
+
+	// Returns the light with the given id.
+	// This function will throw if id does not refer to a light.
+	Light& lightAt(std::uint32_t id);
+
+	// Marks the given light to be recomputed by the next update.
+	void markDirty(std::uint32_t id);
+
+	// Adds (sign = 1) or removes (sign = -1) the tiles lit by the given
+	// light to or from the totals.
+	void apply(const Light& light, std::int32_t sign);
+
+	// Finds the tiles lit by the given light.
+	void computeLight(Light& light) const;
+
+	public:
+
+	// Default constructor.
+	LightMap() = default;
+
+	// Level constructor.
+	// Sets the level layout and the ThreadPool used by the LightMap.
+	LightMap(const Jlib::Matrix<std::uint8_t>& level, Jlib::ThreadPool* pool = nullptr);
+
+	// Sets the level layout and the ThreadPool used by the LightMap
+	// and marks every light to be recomputed.
+	// The level must outlive the LightMap or the next call to setLevel.
+	void setLevel(const Jlib::Matrix<std::uint8_t>& level, Jlib::ThreadPool* pool = nullptr);
+
+	// Sets the area of the level, in tiles, whose light levels are kept.
+	// Moving the window keeps every light but adds them up again.
+	// This function will throw if width or height is negative.
+	void setWindow(std::int32_t x, std::int32_t y, std::int32_t width, std::int32_t height);
+
+	// Sets the light level of tiles no light reaches.
+	void setAmbient(const Jlib::Color& color);
+
+	// Adds a light on the tile containing position and returns its id.
+	// This function will throw if radius is less than 1.
+	std::uint32_t addLight(const Jlib::Point2f& position, const Jlib::Color& color, std::int32_t radius, LightMode mode = LightMode::Shadowcast);
+
+	// Moves the given light to the tile containing position.
+	// Moving within the same tile costs nothing.
+	// This function will throw if id does not refer to a light.
+	void moveLight(std::uint32_t id, const Jlib::Point2f& position);
+
+	// Sets the color of the given light.
+	// This function will throw if id does not refer to a light.
+	void setLightColor(std::uint32_t id, const Jlib::Color& color);
+
+	// Removes the given light. Its id may be reused by addLight.
+	// This function will throw if id does not refer to a light.
+	void removeLight(std::uint32_t id);
+
+	// Tells the LightMap the tile at (x, y) has changed, so every light
+	// that could reach it is recomputed by the next update.
+	void tileChanged(std::int32_t x, std::int32_t y);
+
+	// Recomputes every light that changed since the last update
+	// and brings the light levels up to date.
+	// Returns the amount of lights recomputed.
+	std::size_t update();
+
+	// Returns the light level of the tile at (x, y), given in level
+	// coordinates, as of the last update.
+	// Returns the ambient Color outside of the window.
+	Jlib::Color lightLevel(std::int32_t x, std::int32_t y) const;
+
+	// Returns the light level of every window tile as of the last
+	// update, row by row from the top left of the window.
+	const std::vector<Jlib::Color>& buffer() const;
+
+	// Returns the amount of lights.
+	std::size_t lightCount() const;
+};
+
+#endif // LIGHTING_H_INCLUDED
@@ -0,0 +1,314 @@
+// 2D Platform Game
+// ParticleSystem.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the ParticleSystem class.
+
+#include "ParticleSystem.h"
+#include "Tile.h"
+
+#include "Jlib/Simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Jlib/Color.h
+using Jlib::Color;
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+
+// <cmath>
+using std::exp;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// <stdexcept>
+using std::invalid_argument;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// Particles per block. Large enough that waking the ThreadPool is
+	// worth it, small enough to spread 1 million particles over many threads.
+	constexpr size_t BLOCK_SIZE = 16384;
+
+	static_assert(sizeof(Point2f) == 2 * sizeof(float) && sizeof(Vector2f) == 2 * sizeof(float));
+
+	// Returns std::floor(value) as an integer, without the library call.
+	inline int32_t floor_to_int(float value)
+	{
+		const int32_t truncated = int32_t(value);
+		return truncated - int32_t(value < float(truncated));
+	}
+}
+
+ParticleSystem::ParticleSystem(size_t capacity, ThreadPool* pool)
+{
+	setCapacity(capacity);
+	setThreadPool(pool);
+}
+
+void ParticleSystem::updateBlock(size_t block, float seconds, float damping)
+{
+	const size_t first = block * BLOCK_SIZE;
+	const size_t last = std::min(size_, first + BLOCK_SIZE);
+
+	// Positions and velocities are x, y pairs, so both are updated as
+	// flat float arrays of twice the length.
+	float* position = reinterpret_cast<float*>(positions_.data() + first);
+	float* velocity = reinterpret_cast<float*>(velocities_.data() + first);
+	const size_t float_count = (last - first) * 2;
+	size_t j = 0;
+
+	#ifdef JLIB_SSE2
+	const __m128 damping4 = _mm_set1_ps(damping);
+	const __m128 seconds4 = _mm_set1_ps(seconds);
+	const __m128 gravity4 = _mm_set_ps(gravity_.y * seconds, gravity_.x * seconds, gravity_.y * seconds, gravity_.x * seconds);
+
+	for (; j + 4 <= float_count; j += 4)
+	{
+		const __m128 v = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(velocity + j), damping4), gravity4);
+		_mm_storeu_ps(velocity + j, v);
+		_mm_storeu_ps(position + j, _mm_add_ps(_mm_loadu_ps(position + j), _mm_mul_ps(v, seconds4)));
+	}
+	#endif // JLIB_SSE2
+
+	for (; j < float_count; ++j)
+	{
+		const float v = velocity[j] * damping + ((j & 1) != 0 ? gravity_.y : gravity_.x) * seconds;
+		velocity[j] = v;
+		position[j] += v * seconds;
+	}
+
+	float* lifetime = lifetimes_.data();
+
+	for (size_t i = first; i < last; ++i)
+		lifetime[i] -= seconds;
+
+	if (level_ != nullptr)
+	{
+		// Same test as is_solid_at, with the level size read once.
+		const uint8_t* tiles = level_->data();
+		const int32_t width = int32_t(level_->colSize());
+		const int32_t height = int32_t(level_->rowSize());
+
+		for (size_t i = first; i < last; ++i)
+		{
+			const int32_t x = floor_to_int(positions_[i].x);
+			const int32_t y = floor_to_int(positions_[i].y);
+
+			if (uint32_t(x) >= uint32_t(width) || uint32_t(y) >= uint32_t(height) || is_solid(tiles[size_t(y) * size_t(width) + size_t(x)]))
+				collide(i, seconds);
+		}
+	}
+
+	size_t dead_count = 0;
+
+	for (size_t i = first; i < last; ++i)
+		dead_count += lifetime[i] <= 0.0f;
+
+	block_dead_counts_[block] = dead_count;
+}
+
+void ParticleSystem::collide(size_t i, float seconds)
+{
+	Point2f& position = positions_[i];
+	Vector2f& velocity = velocities_[i];
+
+	const float old_x = position.x - velocity.x * seconds;
+	const float old_y = position.y - velocity.y * seconds;
+	const int32_t tile_x = floor_to_int(position.x);
+	const int32_t tile_y = floor_to_int(position.y);
+	const int32_t old_tile_x = floor_to_int(old_x);
+	const int32_t old_tile_y = floor_to_int(old_y);
+
+	// Bounce off the walls crossed along each axis on their own.
+	bool hit_x = old_tile_x != tile_x && is_solid_at(*level_, tile_x, old_tile_y);
+	bool hit_y = old_tile_y != tile_y && is_solid_at(*level_, old_tile_x, tile_y);
+
+	// Straight into a corner: bounce off both.
+	if (!hit_x && !hit_y)
+	{
+		hit_x = old_tile_x != tile_x;
+		hit_y = old_tile_y != tile_y;
+	}
+
+	// Already inside the wall, such as a tile that became solid.
+	if (!hit_x && !hit_y)
+	{
+		lifetimes_[i] = 0.0f;
+		return;
+	}
+
+	if (hit_x)
+	{
+		position.x = old_x;
+		velocity.x = -velocity.x * bounce_;
+	}
+
+	if (hit_y)
+	{
+		position.y = old_y;
+		velocity.y = -velocity.y * bounce_;
+	}
+}
+
+void ParticleSystem::removeDead()
+{
+	// Particles moved in from the end may be dead too, so each index is
+	// checked again after a move. Only blocks with dead particles are
+	// scanned; particles are only moved into those blocks.
+	for (size_t block = 0; block < block_dead_counts_.size(); ++block)
+	{
+		if (block_dead_counts_[block] == 0)
+			continue;
+
+		size_t i = block * BLOCK_SIZE;
+
+		while (i < std::min(size_, (block + 1) * BLOCK_SIZE))
+		{
+			if (lifetimes_[i] > 0.0f)
+			{
+				++i;
+				continue;
+			}
+
+			--size_;
+			positions_[i] = positions_[size_];
+			velocities_[i] = velocities_[size_];
+			lifetimes_[i] = lifetimes_[size_];
+			colors_[i] = colors_[size_];
+		}
+	}
+}
+
+void ParticleSystem::setCapacity(size_t capacity)
+{
+	positions_.assign(capacity, Point2f());
+	velocities_.assign(capacity, Vector2f());
+	lifetimes_.assign(capacity, 0.0f);
+	colors_.assign(capacity, Color());
+	size_ = 0;
+}
+
+void ParticleSystem::setThreadPool(ThreadPool* pool)
+{
+	pool_ = pool;
+}
+
+void ParticleSystem::setGravity(const Vector2f& gravity)
+{
+	gravity_ = gravity;
+}
+
+void ParticleSystem::setDrag(float drag)
+{
+	if (!(drag >= 0.0f))
+		throw invalid_argument("ParticleSystem::setDrag: drag must not be negative");
+
+	drag_ = drag;
+}
+
+void ParticleSystem::setCollision(const Matrix<uint8_t>* level, float bounce)
+{
+	if (!(bounce >= 0.0f && bounce <= 1.0f))
+		throw invalid_argument("ParticleSystem::setCollision: bounce must be within [0, 1]");
+
+	level_ = level;
+	bounce_ = bounce;
+}
+
+bool ParticleSystem::spawn(const Point2f& position, const Vector2f& velocity, float lifetime, const Color& color)
+{
+	if (size_ == positions_.size())
+		return false;
+
+	positions_[size_] = position;
+	velocities_[size_] = velocity;
+	lifetimes_[size_] = lifetime;
+	colors_[size_] = color;
+	++size_;
+
+	return true;
+}
+
+void ParticleSystem::update(float seconds)
+{
+	if (size_ == 0)
+		return;
+
+	const size_t block_count = (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const float damping = exp(-drag_ * seconds);
+
+	block_dead_counts_.assign(block_count, 0);
+
+	auto update_block = [&](size_t block)
+	{
+		updateBlock(block, seconds, damping);
+	};
+
+	if (pool_ != nullptr)
+		pool_->parallelFor(block_count, update_block);
+	else
+	{
+		for (size_t block = 0; block < block_count; ++block)
+			update_block(block);
+	}
+
+	removeDead();
+}
+
+void ParticleSystem::clear()
+{
+	size_ = 0;
+}
+
+size_t ParticleSystem::size() const
+{
+	return size_;
+}
+
+size_t ParticleSystem::capacity() const
+{
+	return positions_.size();
+}
+
+const vector<Point2f>& ParticleSystem::positions() const
+{
+	return positions_;
+}
+
+const vector<Vector2f>& ParticleSystem::velocities() const
+{
+	return velocities_;
+}
+
+const vector<float>& ParticleSystem::lifetimes() const
+{
+	return lifetimes_;
+}
+
+const vector<Color>& ParticleSystem::colors() const
+{
+	return colors_;
+}
@@ -0,0 +1,122 @@
+// 2D Platform Game
+// ParticleSystem.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the ParticleSystem class.
+
+#ifndef PARTICLESYSTEM_H_INCLUDED
+#define PARTICLESYSTEM_H_INCLUDED
+
+#include "Jlib/Color.h"
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/ThreadPool.h"
+#include "Jlib/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A fixed-capacity set of particles, each with a position, velocity,
+// remaining lifetime and Color.
+// Each of those is kept in its own array, so an update streams
+// through memory and the position and velocity math runs on SSE2,
+// 2 particles at a time. Particles are updated in blocks, which are
+// spread across the ThreadPool if there is one.
+// Particles whose lifetime runs out are removed by moving the last
+// particle into their place, so the arrays stay packed but particles
+// do not keep their index across updates.
+class ParticleSystem
+{
+	std::vector<Jlib::Point2f> positions_;
+	std::vector<Jlib::Vector2f> velocities_;
+	std::vector<float> lifetimes_;
+	std::vector<Jlib::Color> colors_;
+	std::size_t size_ = 0;
+
+	Jlib::Vector2f gravity_;
+	float drag_ = 0.0f;
+	const Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	float bounce_ = 0.5f;
+	Jlib::ThreadPool* pool_ = nullptr;
+
+	// Amount of particles whose lifetime ran out in each block during
+	// the last update.
+	std::vector<std::size_t> block_dead_counts_;
+
+	// Moves, ages and collides the particles of the given block.
+	void updateBlock(std::size_t block, float seconds, float damping);
+
+	// Bounces the given particle off the solid tile it moved into.
+	void collide(std::size_t i, float seconds);
+
+	// Removes every particle whose lifetime ran out.
+	void removeDead();
+
+	public:
+
+	// Default constructor.
+	ParticleSystem() = default;
+
+	// Capacity constructor.
+	// Makes room for the given amount of particles and sets the
+	// ThreadPool used by update.
+	explicit ParticleSystem(std::size_t capacity, Jlib::ThreadPool* pool = nullptr);
+
+	// Removes every particle and makes room for the given amount.
+	void setCapacity(std::size_t capacity);
+
+	// Sets the ThreadPool used by update.
+	// Without a ThreadPool, particles are updated on the calling thread.
+	void setThreadPool(Jlib::ThreadPool* pool);
+
+	// Sets the acceleration applied to every particle, in tiles per second squared.
+	void setGravity(const Jlib::Vector2f& gravity);
+
+	// Sets how quickly particles slow down: each second, velocity is
+	// multiplied by e^-drag.
+	// This function will throw if drag is negative.
+	void setDrag(float drag);
+
+	// Makes particles bounce off the solid tiles of the given level
+	// layout, keeping bounce times their speed into the wall.
+	// A null level turns collision off, which is the default.
+	// The level must outlive the ParticleSystem or the next call to setCollision.
+	// This function will throw if bounce is not within [0, 1].
+	void setCollision(const Jlib::Matrix<std::uint8_t>* level, float bounce = 0.5f);
+
+	// Adds a particle that lives for the given amount of seconds.
+	// Returns false, adding nothing, if the ParticleSystem is full.
+	bool spawn(const Jlib::Point2f& position, const Jlib::Vector2f& velocity, float lifetime, const Jlib::Color& color);
+
+	// Advances every particle by the given amount of seconds
+	// and removes the ones whose lifetime ran out.
+	void update(float seconds);
+
+	// Removes every particle.
+	void clear();
+
+	// Returns the amount of particles.
+	std::size_t size() const;
+
+	// Returns the maximum amount of particles.
+	std::size_t capacity() const;
+
+	// The arrays below hold capacity() entries, of which the first
+	// size() are particles.
+
+	// Returns the position of every particle.
+	const std::vector<Jlib::Point2f>& positions() const;
+
+	// Returns the velocity of every particle.
+	const std::vector<Jlib::Vector2f>& velocities() const;
+
+	// Returns the remaining lifetime of every particle, in seconds.
+	const std::vector<float>& lifetimes() const;
+
+	// Returns the Color of every particle.
+	const std::vector<Jlib::Color>& colors() const;
+};
+
+#endif // PARTICLESYSTEM_H_INCLUDED
@@ -0,0 +1,637 @@
+// 2D Platform Game
+// Pathfinding.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the GridPathfinder and PlatformGraph classes.
+
+#include "Pathfinding.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2i;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr float INFINITE_COST = std::numeric_limits<float>::infinity();
+	constexpr float DIAGONAL_EXTRA = 0.41421356f; // sqrt(2) - 1
+
+	// Returns the cost of the shortest 8-directional move between 2 tiles.
+	float octile(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+	{
+		const float dx = float(std::abs(x1 - x0));
+		const float dy = float(std::abs(y1 - y0));
+
+		return std::max(dx, dy) + DIAGONAL_EXTRA * std::min(dx, dy);
+	}
+
+	int32_t sign(int32_t value)
+	{
+		return (value > 0) - (value < 0);
+	}
+
+	bool compare_entries(const OpenSet::Entry& A, const OpenSet::Entry& B)
+	{
+		return A.cost > B.cost;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//////                                        OPENSET                                        //////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void OpenSet::clear()
+{
+	heap_.clear();
+}
+
+bool OpenSet::empty() const
+{
+	return heap_.empty();
+}
+
+void OpenSet::push(float cost, uint32_t node)
+{
+	heap_.push_back(Entry{ cost, node });
+	std::push_heap(heap_.begin(), heap_.end(), compare_entries);
+}
+
+OpenSet::Entry OpenSet::pop()
+{
+	std::pop_heap(heap_.begin(), heap_.end(), compare_entries);
+	const Entry entry = heap_.back();
+	heap_.pop_back();
+
+	return entry;
+}
+
+void OpenSet::reserve(size_t count)
+{
+	heap_.reserve(count);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//////                                     GRIDPATHFINDER                                    //////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GridPathfinder::GridPathfinder(const Matrix<uint8_t>& level)
+{
+	setLevel(level);
+}
+
+void GridPathfinder::setLevel(const Matrix<uint8_t>& level)
+{
+	level_ = &level;
+	width_ = int32_t(level.colSize());
+	height_ = int32_t(level.rowSize());
+
+	if (nodes_.empty())
+	{
+		nodes_.resize(1024);
+		open_.reserve(1024);
+	}
+
+	resetNodes();
+}
+
+bool GridPathfinder::walkable(int32_t x, int32_t y) const
+{
+	return !is_solid_at(*level_, x, y);
+}
+
+uint32_t GridPathfinder::find(uint32_t tile) const
+{
+	const uint32_t mask = uint32_t(nodes_.size() - 1);
+	uint32_t slot = (tile * 0x9E3779B1u) & mask;
+
+	while (nodes_[slot].tile != tile)
+		slot = (slot + 1) & mask;
+
+	return slot;
+}
+
+uint32_t GridPathfinder::findOrInsert(uint32_t tile)
+{
+	if ((used_slots_.size() + 1) * 2 > nodes_.size())
+		grow();
+
+	const uint32_t mask = uint32_t(nodes_.size() - 1);
+	uint32_t slot = (tile * 0x9E3779B1u) & mask;
+
+	while (nodes_[slot].tile != tile)
+	{
+		if (nodes_[slot].tile == EMPTY_SLOT)
+		{
+			nodes_[slot].tile = tile;
+			nodes_[slot].cost = INFINITE_COST;
+			used_slots_.push_back(slot);
+
+			return slot;
+		}
+
+		slot = (slot + 1) & mask;
+	}
+
+	return slot;
+}
+
+void GridPathfinder::grow()
+{
+	vector<Node> old_nodes(nodes_.size() * 2);
+	old_nodes.swap(nodes_);
+
+	const uint32_t mask = uint32_t(nodes_.size() - 1);
+	used_slots_.clear();
+
+	for (const Node& node : old_nodes)
+	{
+		if (node.tile == EMPTY_SLOT)
+			continue;
+
+		uint32_t slot = (node.tile * 0x9E3779B1u) & mask;
+
+		while (nodes_[slot].tile != EMPTY_SLOT)
+			slot = (slot + 1) & mask;
+
+		nodes_[slot] = node;
+		used_slots_.push_back(slot);
+	}
+}
+
+void GridPathfinder::resetNodes()
+{
+	for (uint32_t slot : used_slots_)
+		nodes_[slot] = Node();
+
+	used_slots_.clear();
+}
+
+bool GridPathfinder::jumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy, Point2i& result) const
+{
+	while (true)
+	{
+		x += dx;
+		y += dy;
+
+		if (!walkable(x, y))
+			return false;
+
+		if (x == goal_.x && y == goal_.y)
+		{
+			result.setAll(x, y);
+			return true;
+		}
+
+		// A jump point has a neighbour that only becomes reachable
+		// by stopping here, because the tile behind it is blocked.
+		if (dx != 0)
+		{
+			if ((walkable(x, y - 1) && !walkable(x - dx, y - 1)) ||
+			    (walkable(x, y + 1) && !walkable(x - dx, y + 1)))
+			{
+				result.setAll(x, y);
+				return true;
+			}
+		}
+		else
+		{
+			if ((walkable(x - 1, y) && !walkable(x - 1, y - dy)) ||
+			    (walkable(x + 1, y) && !walkable(x + 1, y - dy)))
+			{
+				result.setAll(x, y);
+				return true;
+			}
+		}
+	}
+}
+
+bool GridPathfinder::jump(int32_t x, int32_t y, int32_t dx, int32_t dy, Point2i& result) const
+{
+	if (dx == 0 || dy == 0)
+		return jumpStraight(x, y, dx, dy, result);
+
+	Point2i unused;
+
+	while (true)
+	{
+		// Diagonal moves may not cut corners.
+		if (!walkable(x + dx, y) || !walkable(x, y + dy))
+			return false;
+
+		x += dx;
+		y += dy;
+
+		if (!walkable(x, y))
+			return false;
+
+		if ((x == goal_.x && y == goal_.y) ||
+		    jumpStraight(x, y, dx, 0, unused) || jumpStraight(x, y, 0, dy, unused))
+		{
+			result.setAll(x, y);
+			return true;
+		}
+	}
+}
+
+bool GridPathfinder::findPath(const Point2i& start, const Point2i& goal, vector<Point2i>& path)
+{
+	path.clear();
+	expanded_ = 0;
+
+	if (level_ == nullptr || !walkable(start.x, start.y) || !walkable(goal.x, goal.y))
+		return false;
+
+	resetNodes();
+	open_.clear();
+	goal_ = goal;
+
+	const uint32_t start_tile = uint32_t(start.y * width_ + start.x);
+	const uint32_t goal_tile = uint32_t(goal.y * width_ + goal.x);
+
+	nodes_[findOrInsert(start_tile)].cost = 0.0f;
+	open_.push(octile(start.x, start.y, goal.x, goal.y), start_tile);
+
+	while (!open_.empty())
+	{
+		const OpenSet::Entry entry = open_.pop();
+		const uint32_t slot = find(entry.node);
+
+		if (nodes_[slot].closed)
+			continue;
+
+		nodes_[slot].closed = true;
+		++expanded_;
+
+		const uint32_t tile = entry.node;
+		const float cost = nodes_[slot].cost;
+		const int32_t x = int32_t(tile % uint32_t(width_));
+		const int32_t y = int32_t(tile / uint32_t(width_));
+
+		if (tile == goal_tile)
+		{
+			for (uint32_t t = tile; t != EMPTY_SLOT; t = nodes_[find(t)].parent)
+				path.emplace_back(int32_t(t % uint32_t(width_)), int32_t(t / uint32_t(width_)));
+
+			std::reverse(path.begin(), path.end());
+			return true;
+		}
+
+		// Pick the directions worth searching. Without a parent, every
+		// direction is. Otherwise only the natural and forced neighbours.
+		int32_t directions[8][2];
+		int32_t direction_count = 0;
+
+		const auto add = [&](int32_t dx, int32_t dy)
+		{
+			directions[direction_count][0] = dx;
+			directions[direction_count][1] = dy;
+			++direction_count;
+		};
+
+		const uint32_t parent = nodes_[slot].parent;
+
+		if (parent == EMPTY_SLOT)
+		{
+			for (int32_t dy = -1; dy <= 1; ++dy)
+			{
+				for (int32_t dx = -1; dx <= 1; ++dx)
+				{
+					if (dx != 0 || dy != 0)
+						add(dx, dy);
+				}
+			}
+		}
+		else
+		{
+			const int32_t dx = sign(x - int32_t(parent % uint32_t(width_)));
+			const int32_t dy = sign(y - int32_t(parent / uint32_t(width_)));
+
+			if (dx != 0 && dy != 0)
+			{
+				add(dx, 0);
+				add(0, dy);
+				add(dx, dy);
+			}
+			else if (dx != 0)
+			{
+				add(dx, 0);
+
+				// The same forced neighbour test as jumpStraight: a side
+				// tile whose tile behind is walkable is reached without
+				// passing through here.
+				if (walkable(x, y - 1) && !walkable(x - dx, y - 1))
+				{
+					add(dx, -1);
+					add(0, -1);
+				}
+
+				if (walkable(x, y + 1) && !walkable(x - dx, y + 1))
+				{
+					add(dx, 1);
+					add(0, 1);
+				}
+			}
+			else
+			{
+				add(0, dy);
+
+				if (walkable(x - 1, y) && !walkable(x - 1, y - dy))
+				{
+					add(-1, dy);
+					add(-1, 0);
+				}
+
+				if (walkable(x + 1, y) && !walkable(x + 1, y - dy))
+				{
+					add(1, dy);
+					add(1, 0);
+				}
+			}
+		}
+
+		for (int32_t d = 0; d < direction_count; ++d)
+		{
+			Point2i jump_point;
+
+			if (!jump(x, y, directions[d][0], directions[d][1], jump_point))
+				continue;
+
+			const uint32_t jump_tile = uint32_t(jump_point.y * width_ + jump_point.x);
+			const uint32_t jump_slot = findOrInsert(jump_tile);
+			Node& node = nodes_[jump_slot];
+
+			if (node.closed)
+				continue;
+
+			const float new_cost = cost + octile(x, y, jump_point.x, jump_point.y);
+
+			if (new_cost < node.cost)
+			{
+				node.cost = new_cost;
+				node.parent = tile;
+				open_.push(new_cost + octile(jump_point.x, jump_point.y, goal.x, goal.y), jump_tile);
+			}
+		}
+	}
+
+	return false;
+}
+
+size_t GridPathfinder::lastExpandedCount() const
+{
+	return expanded_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//////                                     PLATFORMGRAPH                                     //////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+PlatformGraph::PlatformGraph(const Matrix<uint8_t>& level, const JumpSettings& jump)
+{
+	build(level, jump);
+}
+
+void PlatformGraph::build(const Matrix<uint8_t>& level, const JumpSettings& jump)
+{
+	level_ = &level;
+	width_ = int32_t(level.colSize());
+	height_ = int32_t(level.rowSize());
+	jump_ = jump;
+
+	node_tiles_.clear();
+	link_offsets_.clear();
+	links_.clear();
+
+	const auto solid = [&](int32_t x, int32_t y) { return is_solid_at(level, x, y); };
+
+	for (int32_t y = 0; y < height_; ++y)
+	{
+		for (int32_t x = 0; x < width_; ++x)
+		{
+			if (!solid(x, y) && solid(x, y + 1))
+				node_tiles_.push_back(uint32_t(y * width_ + x));
+		}
+	}
+
+	link_offsets_.reserve(node_tiles_.size() + 1);
+
+	for (uint32_t tile : node_tiles_)
+	{
+		link_offsets_.push_back(uint32_t(links_.size()));
+
+		const int32_t x = int32_t(tile % uint32_t(width_));
+		const int32_t y = int32_t(tile / uint32_t(width_));
+
+		// Walking and falling off ledges.
+		for (int32_t side = -1; side <= 1; side += 2)
+		{
+			const uint32_t neighbour = nodeAt(x + side, y);
+
+			if (neighbour != NO_NODE)
+				links_.push_back(Link{ neighbour, 1.0f, PlatformMove::Walk });
+			else if (!solid(x + side, y))
+			{
+				const uint32_t landing = landingNode(x + side, y);
+
+				if (landing != NO_NODE)
+				{
+					const int32_t fall = int32_t(node_tiles_[landing] / uint32_t(width_)) - y;
+					links_.push_back(Link{ landing, 1.0f + float(fall), PlatformMove::Fall });
+				}
+			}
+		}
+
+		// Jumping. The arc is approximated by rising straight up to one
+		// tile above the higher of the 2 tiles, moving across, and coming
+		// straight down, all of which must be free of solid tiles.
+		// The range of ty limits the rise to max_height; the apex is the
+		// headroom above it and does not count.
+		for (int32_t ty = y - jump_.max_height; ty <= y + jump_.max_height; ++ty)
+		{
+			for (int32_t tx = x - jump_.max_distance; tx <= x + jump_.max_distance; ++tx)
+			{
+				if ((ty == y && std::abs(tx - x) <= 1) || (tx == x && ty >= y))
+					continue;
+
+				const uint32_t target = nodeAt(tx, ty);
+
+				if (target == NO_NODE)
+					continue;
+
+				const int32_t apex = std::min(y, ty) - 1;
+				bool clear = true;
+
+				for (int32_t cy = y - 1; clear && cy >= apex; --cy)
+					clear = !solid(x, cy);
+
+				for (int32_t cx = std::min(x, tx); clear && cx <= std::max(x, tx); ++cx)
+					clear = !solid(cx, apex);
+
+				for (int32_t cy = apex; clear && cy <= ty; ++cy)
+					clear = !solid(tx, cy);
+
+				if (clear)
+					links_.push_back(Link{ target, 1.0f + float(std::abs(tx - x) + std::abs(ty - y)), PlatformMove::Jump });
+			}
+		}
+	}
+
+	link_offsets_.push_back(uint32_t(links_.size()));
+
+	cost_.assign(node_tiles_.size(), INFINITE_COST);
+	parent_.assign(node_tiles_.size(), NO_NODE);
+	parent_move_.assign(node_tiles_.size(), PlatformMove::Walk);
+	visited_.assign(node_tiles_.size(), 0);
+	search_id_ = 0;
+}
+
+size_t PlatformGraph::nodeCount() const
+{
+	return node_tiles_.size();
+}
+
+size_t PlatformGraph::linkCount() const
+{
+	return links_.size();
+}
+
+uint32_t PlatformGraph::nodeAt(int32_t x, int32_t y) const
+{
+	if (x < 0 || y < 0 || x >= width_ || y >= height_)
+		return NO_NODE;
+
+	const uint32_t tile = uint32_t(y * width_ + x);
+	const auto iter = std::lower_bound(node_tiles_.begin(), node_tiles_.end(), tile);
+
+	if (iter == node_tiles_.end() || *iter != tile)
+		return NO_NODE;
+
+	return uint32_t(iter - node_tiles_.begin());
+}
+
+Point2i PlatformGraph::nodeTile(uint32_t node) const
+{
+	return Point2i(int32_t(node_tiles_[node] % uint32_t(width_)), int32_t(node_tiles_[node] / uint32_t(width_)));
+}
+
+uint32_t PlatformGraph::landingNode(int32_t x, int32_t y) const
+{
+	if (level_ == nullptr || x < 0 || x >= width_)
+		return NO_NODE;
+
+	// Every empty tile with a solid tile below is a node, so the fall
+	// ends on the empty tile above the first solid tile going down the
+	// column. A position inside a solid tile does not fall through it.
+	for (int32_t fy = std::max(y, 0); fy < height_; ++fy)
+	{
+		if (is_solid_at(*level_, x, fy))
+			return NO_NODE;
+
+		if (is_solid_at(*level_, x, fy + 1))
+			return nodeAt(x, fy);
+	}
+
+	return NO_NODE;
+}
+
+bool PlatformGraph::findPath(const Point2i& start, const Point2i& goal, vector<PlatformStep>& path)
+{
+	path.clear();
+
+	const uint32_t start_node = landingNode(start.x, start.y);
+	const uint32_t goal_node = landingNode(goal.x, goal.y);
+
+	if (start_node == NO_NODE || goal_node == NO_NODE)
+		return false;
+
+	// Search ids mark which entries of cost_ belong to this search,
+	// so nothing has to be cleared between queries.
+	if (++search_id_ == 0)
+	{
+		std::fill(visited_.begin(), visited_.end(), 0);
+		search_id_ = 1;
+	}
+
+	const Point2i goal_tile = nodeTile(goal_node);
+
+	// Every link costs at least the Manhattan distance it covers,
+	// so the Manhattan distance never overestimates.
+	const auto heuristic = [&](uint32_t node)
+	{
+		const Point2i tile = nodeTile(node);
+		return float(std::abs(tile.x - goal_tile.x) + std::abs(tile.y - goal_tile.y));
+	};
+
+	open_.clear();
+	visited_[start_node] = search_id_;
+	cost_[start_node] = 0.0f;
+	parent_[start_node] = NO_NODE;
+	open_.push(heuristic(start_node), start_node);
+
+	while (!open_.empty())
+	{
+		const OpenSet::Entry entry = open_.pop();
+		const uint32_t node = entry.node;
+
+		// Stale entry left behind by a cheaper push.
+		if (entry.cost > cost_[node] + heuristic(node))
+			continue;
+
+		if (node == goal_node)
+		{
+			for (uint32_t n = node; n != start_node; n = parent_[n])
+				path.push_back(PlatformStep{ nodeTile(n), parent_move_[n] });
+
+			std::reverse(path.begin(), path.end());
+			return true;
+		}
+
+		for (uint32_t l = link_offsets_[node]; l < link_offsets_[node + 1]; ++l)
+		{
+			const Link& link = links_[l];
+			const float new_cost = cost_[node] + link.cost;
+
+			if (visited_[link.target] != search_id_ || new_cost < cost_[link.target])
+			{
+				visited_[link.target] = search_id_;
+				cost_[link.target] = new_cost;
+				parent_[link.target] = node;
+				parent_move_[link.target] = link.move;
+				open_.push(new_cost + heuristic(link.target), link.target);
+			}
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,234 @@
+// 2D Platform Game
+// Pathfinding.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the GridPathfinder and PlatformGraph classes.
+
+#ifndef PATHFINDING_H_INCLUDED
+#define PATHFINDING_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary min-heap of (cost, node) pairs.
+// The storage is kept between queries, so after the first few
+// searches pushing and popping never allocates.
+// Stale entries are not removed on a cost decrease; the caller
+// skips them when they are popped.
+class OpenSet
+{
+	public:
+
+	struct Entry
+	{
+		float cost = 0.0f;
+		std::uint32_t node = 0;
+	};
+
+	private:
+
+	std::vector<Entry> heap_;
+
+	public:
+
+	// Removes every entry, keeping the storage.
+	void clear();
+
+	// Returns true if the OpenSet has no entries.
+	bool empty() const;
+
+	// Adds the given node with the given cost.
+	void push(float cost, std::uint32_t node);
+
+	// Removes and returns the entry with the lowest cost.
+	// The OpenSet must not be empty.
+	Entry pop();
+
+	// Makes sure count entries fit without allocating.
+	void reserve(std::size_t count);
+};
+
+// Finds paths for flying or top-down movement over the level layout,
+// moving in 8 directions without cutting corners.
+// Uses A* with jump point search, which only stores the tiles where
+// the path can change direction, so open areas cost a few nodes
+// instead of one node per tile.
+// Search state lives in a hash table sized by the search rather than
+// by the level, so one GridPathfinder per thread is cheap even on
+// very large levels.
+// A query across a 4096x4096 level with scattered walls takes 50 to 150
+// milliseconds, thousands of times too slow for 1,000 queries a frame.
+// Long queries belong to HierarchicalPathfinder; this is for short
+// ones and for the paths inside a chunk.
+class GridPathfinder
+{
+	static constexpr std::uint32_t EMPTY_SLOT = 0xFFFFFFFF;
+
+	struct Node
+	{
+		std::uint32_t tile = EMPTY_SLOT;
+		std::uint32_t parent = EMPTY_SLOT;
+		float cost = 0.0f;
+		bool closed = false;
+	};
+
+	const Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	std::int32_t width_ = 0;
+	std::int32_t height_ = 0;
+	Jlib::Point2i goal_;
+
+	// Open-addressing hash table from tile index to search state.
+	std::vector<Node> nodes_;
+	std::vector<std::uint32_t> used_slots_;
+	OpenSet open_;
+	std::size_t expanded_ = 0;
+
+	// Returns true if the tile at (x, y) can be moved through.
+	bool walkable(std::int32_t x, std::int32_t y) const;
+
+	// Returns the slot of the given tile, inserting it if needed.
+	std::uint32_t findOrInsert(std::uint32_t tile);
+
+	// Returns the slot of the given tile, which must have been inserted.
+	std::uint32_t find(std::uint32_t tile) const;
+
+	// Doubles the size of the node table.
+	void grow();
+
+	// Clears the nodes touched by the previous search.
+	void resetNodes();
+
+	// Moves from (x, y) in the direction (dx, dy) until reaching a
+	// jump point, returning false if the move runs into a wall.
+	bool jump(std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy, Jlib::Point2i& result) const;
+
+	// Returns true if a straight move in the direction (dx, dy)
+	// from (x, y) reaches a jump point.
+	bool jumpStraight(std::int32_t x, std::int32_t y, std::int32_t dx, std::int32_t dy, Jlib::Point2i& result) const;
+
+	public:
+
+	// Default constructor.
+	GridPathfinder() = default;
+
+	// Level constructor.
+	// Sets the level layout searched by the GridPathfinder.
+	explicit GridPathfinder(const Jlib::Matrix<std::uint8_t>& level);
+
+	// Sets the level layout searched by the GridPathfinder.
+	// The level must outlive the GridPathfinder or the next call to setLevel.
+	void setLevel(const Jlib::Matrix<std::uint8_t>& level);
+
+	// Finds a path from start to goal, given as tile positions.
+	// On success, path holds the jump points from start to goal, each
+	// reachable from the previous one in a straight or diagonal line,
+	// and true is returned.
+	// Returns false if either position is solid or no path exists.
+	bool findPath(const Jlib::Point2i& start, const Jlib::Point2i& goal, std::vector<Jlib::Point2i>& path);
+
+	// Returns the amount of nodes expanded by the last call to findPath.
+	std::size_t lastExpandedCount() const;
+};
+
+// The way a PlatformGraph link is traversed.
+enum class PlatformMove : std::uint8_t
+{
+	Walk,
+	Jump,
+	Fall
+};
+
+// One step of a path through a PlatformGraph.
+struct PlatformStep
+{
+	Jlib::Point2i tile;
+	PlatformMove move = PlatformMove::Walk;
+};
+
+// Limits of a jump, in tiles: how much higher the landing tile can be
+// than the take-off tile, and how far across.
+struct JumpSettings
+{
+	std::int32_t max_height = 3;
+	std::int32_t max_distance = 4;
+};
+
+// Navigation graph for agents affected by gravity.
+// The nodes are the tiles an agent can stand on: empty tiles with a
+// solid tile below. They are linked by walking to a neighbouring
+// standing tile, falling off a ledge, or jumping within JumpSettings.
+class PlatformGraph
+{
+	struct Link
+	{
+		std::uint32_t target = 0;
+		float cost = 0.0f;
+		PlatformMove move = PlatformMove::Walk;
+	};
+
+	const Jlib::Matrix<std::uint8_t>* level_ = nullptr;
+	std::int32_t width_ = 0;
+	std::int32_t height_ = 0;
+	JumpSettings jump_;
+
+	// Tile index y * width + x of every node, in increasing order.
+	std::vector<std::uint32_t> node_tiles_;
+
+	// The links of node n are links_[link_offsets_[n]] to links_[link_offsets_[n + 1] - 1].
+	std::vector<std::uint32_t> link_offsets_;
+	std::vector<Link> links_;
+
+	// Per-node search state, reused between queries.
+	std::vector<float> cost_;
+	std::vector<std::uint32_t> parent_;
+	std::vector<PlatformMove> parent_move_;
+	std::vector<std::uint32_t> visited_;
+	std::uint32_t search_id_ = 0;
+	OpenSet open_;
+
+	// Returns the node standing on the given tile, or NO_NODE.
+	std::uint32_t nodeAt(std::int32_t x, std::int32_t y) const;
+
+	public:
+
+	static constexpr std::uint32_t NO_NODE = 0xFFFFFFFF;
+
+	// Default constructor.
+	PlatformGraph() = default;
+
+	// Level constructor.
+	// Builds the graph for the given level layout.
+	// The level must outlive the PlatformGraph or the next call to build.
+	PlatformGraph(const Jlib::Matrix<std::uint8_t>& level, const JumpSettings& jump = JumpSettings());
+
+	// Rebuilds the graph for the given level layout.
+	// The level must outlive the PlatformGraph or the next call to build.
+	void build(const Jlib::Matrix<std::uint8_t>& level, const JumpSettings& jump = JumpSettings());
+
+	// Returns the amount of standing tiles in the graph.
+	std::size_t nodeCount() const;
+
+	// Returns the amount of links in the graph.
+	std::size_t linkCount() const;
+
+	// Returns the tile the given node stands on.
+	Jlib::Point2i nodeTile(std::uint32_t node) const;
+
+	// Returns the node reached by falling from (x, y),
+	// or NO_NODE if (x, y) is solid or there is none.
+	std::uint32_t landingNode(std::int32_t x, std::int32_t y) const;
+
+	// Finds a path from start to goal, given as tile positions.
+	// Positions in the air are first dropped to the tile they land on.
+	// On success, path holds every step after start, each with the move
+	// used to reach it, and true is returned.
+	// Returns false if start or goal is solid or no path exists.
+	bool findPath(const Jlib::Point2i& start, const Jlib::Point2i& goal, std::vector<PlatformStep>& path);
+};
+
+#endif // PATHFINDING_H_INCLUDED
@@ -0,0 +1,403 @@
+// 2D Platform Game
+// Raycast.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for raycasts and visibility queries against the level layout.
+
+#include "Raycast.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+using Jlib::Point2i;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// Jlib/Vector.h
+using Jlib::Vector2f;
+using Jlib::Vector2i;
+
+// <cmath>
+using std::floor;
+using std::sqrt;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::uint8_t;
+using std::uint32_t;
+
+// <limits>
+using std::numeric_limits;
+
+// <stdexcept>
+using std::invalid_argument;
+
+// <utility>
+using std::pair;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr float INF = numeric_limits<float>::infinity();
+
+	// Rays cast by raycast_batch per ThreadPool task.
+	constexpr size_t BATCH_SIZE = 256;
+
+	// How far to either side of a wall corner visibility_polygon casts,
+	// as a fraction of the distance to the corner.
+	constexpr float CORNER_OFFSET = 0.0001f;
+
+	// The level layout with its size read once, so each step of a ray
+	// costs one unsigned compare and one load.
+	struct Grid
+	{
+		const uint8_t* tiles = nullptr;
+		int32_t width = 0;
+		int32_t height = 0;
+
+		explicit Grid(const Matrix<uint8_t>& level)
+			: tiles(level.data()), width(int32_t(level.colSize())), height(int32_t(level.rowSize()))
+		{
+
+		}
+
+		bool solid(int32_t x, int32_t y) const
+		{
+			if (uint32_t(x) >= uint32_t(width) || uint32_t(y) >= uint32_t(height))
+				return true;
+
+			return is_solid(tiles[size_t(y) * size_t(width) + size_t(x)]);
+		}
+	};
+
+	// Walks the tiles crossed by the ray from origin along the unit
+	// vector (dx, dy), stopping at the first solid tile or after max_t tiles.
+	bool cast(const Grid& grid, const Point2f& origin, float dx, float dy, float max_t, RayHit& hit)
+	{
+		int32_t x = int32_t(floor(origin.x));
+		int32_t y = int32_t(floor(origin.y));
+
+		if (grid.solid(x, y))
+		{
+			hit.hit = true;
+			hit.tile = Point2i(x, y);
+			hit.point = origin;
+			hit.normal = Vector2i(0, 0);
+			hit.distance = 0.0f;
+			return true;
+		}
+
+		const int32_t step_x = dx > 0.0f ? 1 : -1;
+		const int32_t step_y = dy > 0.0f ? 1 : -1;
+
+		// Distance along the ray between 2 vertical or 2 horizontal tile edges.
+		const float delta_x = dx != 0.0f ? std::fabs(1.0f / dx) : INF;
+		const float delta_y = dy != 0.0f ? std::fabs(1.0f / dy) : INF;
+
+		// Distance along the ray to the next vertical or horizontal tile edge.
+		float next_x = dx > 0.0f ? (float(x) + 1.0f - origin.x) * delta_x : (dx < 0.0f ? (origin.x - float(x)) * delta_x : INF);
+		float next_y = dy > 0.0f ? (float(y) + 1.0f - origin.y) * delta_y : (dy < 0.0f ? (origin.y - float(y)) * delta_y : INF);
+
+		// 0 = crossed a vertical edge, 1 = crossed a horizontal edge.
+		int32_t axis = 0;
+		float t = 0.0f;
+		bool blocked = false;
+
+		while (true)
+		{
+			if (next_x < next_y)
+			{
+				t = next_x;
+
+				if (t > max_t)
+					break;
+
+				x += step_x;
+				next_x += delta_x;
+				axis = 0;
+			}
+			else
+			{
+				t = next_y;
+
+				if (t > max_t)
+					break;
+
+				if (next_x == next_y)
+				{
+					// Through a corner: the 2 tiles beside it block the ray too.
+					if (grid.solid(x + step_x, y))
+					{
+						x += step_x;
+						axis = 0;
+						blocked = true;
+						break;
+					}
+
+					if (grid.solid(x, y + step_y))
+					{
+						y += step_y;
+						axis = 1;
+						blocked = true;
+						break;
+					}
+
+					x += step_x;
+					next_x += delta_x;
+				}
+
+				y += step_y;
+				next_y += delta_y;
+				axis = 1;
+			}
+
+			if (grid.solid(x, y))
+			{
+				blocked = true;
+				break;
+			}
+		}
+
+		hit.hit = blocked;
+		hit.tile = Point2i(x, y);
+
+		if (!blocked)
+		{
+			hit.point = Point2f(origin.x + dx * max_t, origin.y + dy * max_t);
+			hit.normal = Vector2i(0, 0);
+			hit.distance = max_t;
+			return false;
+		}
+
+		hit.distance = t;
+
+		// The coordinate on the crossed edge is exact rather than
+		// origin + direction * t, so hit points never land inside the tile.
+		if (axis == 0)
+		{
+			hit.normal = Vector2i(-step_x, 0);
+			hit.point = Point2f(float(step_x > 0 ? x : x + 1), origin.y + dy * t);
+		}
+		else
+		{
+			hit.normal = Vector2i(0, -step_y);
+			hit.point = Point2f(origin.x + dx * t, float(step_y > 0 ? y : y + 1));
+		}
+
+		return true;
+	}
+
+	// Casts along (dx, dy), which does not need to be a unit vector.
+	bool cast_any(const Grid& grid, const Point2f& origin, float dx, float dy, float max_distance, RayHit& hit)
+	{
+		const float length = sqrt(dx * dx + dy * dy);
+
+		if (max_distance < 0.0f)
+			max_distance = 0.0f;
+
+		if (length == 0.0f)
+			return cast(grid, origin, 0.0f, 0.0f, 0.0f, hit);
+
+		return cast(grid, origin, dx / length, dy / length, max_distance, hit);
+	}
+
+	// Returns a value that sorts the same way as the angle of (dx, dy),
+	// in [0, 4), without calling atan2.
+	float pseudo_angle(float dx, float dy)
+	{
+		const float p = dy / (std::fabs(dx) + std::fabs(dy));
+
+		if (dx < 0.0f)
+			return 2.0f - p;
+
+		if (dy < 0.0f)
+			return 4.0f + p;
+
+		return p;
+	}
+
+	// Scratch space for visibility_polygon, one set per thread.
+	thread_local vector<pair<float, Point2f>> visibility_points;
+}
+
+bool raycast(const Matrix<uint8_t>& level, const Point2f& origin, const Vector2f& direction, float max_distance, RayHit& hit)
+{
+	return cast_any(Grid(level), origin, direction.x, direction.y, max_distance, hit);
+}
+
+bool raycast(const Matrix<uint8_t>& level, const Ray& ray, RayHit& hit)
+{
+	return cast_any(Grid(level), ray.origin, ray.direction.x, ray.direction.y, ray.max_distance, hit);
+}
+
+void raycast_batch(const Matrix<uint8_t>& level, const vector<Ray>& rays, vector<RayHit>& hits, ThreadPool* pool)
+{
+	hits.resize(rays.size());
+
+	const Grid grid(level);
+	const size_t batch_count = (rays.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+
+	auto cast_batch = [&](size_t batch)
+	{
+		const size_t last = std::min(rays.size(), (batch + 1) * BATCH_SIZE);
+
+		for (size_t i = batch * BATCH_SIZE; i < last; ++i)
+			cast_any(grid, rays[i].origin, rays[i].direction.x, rays[i].direction.y, rays[i].max_distance, hits[i]);
+	};
+
+	if (pool != nullptr)
+		pool->parallelFor(batch_count, cast_batch);
+	else
+	{
+		for (size_t batch = 0; batch < batch_count; ++batch)
+			cast_batch(batch);
+	}
+}
+
+bool line_of_sight(const Matrix<uint8_t>& level, const Point2f& from, const Point2f& to)
+{
+	RayHit hit;
+	const float dx = to.x - from.x;
+	const float dy = to.y - from.y;
+
+	return !cast_any(Grid(level), from, dx, dy, sqrt(dx * dx + dy * dy), hit);
+}
+
+void visibility_polygon(const Matrix<uint8_t>& level, const Point2f& origin, float radius, vector<Point2f>& polygon)
+{
+	if (!(radius > 0.0f))
+		throw invalid_argument("visibility_polygon: radius must be positive");
+
+	polygon.clear();
+
+	const Grid grid(level);
+
+	if (grid.solid(int32_t(floor(origin.x)), int32_t(floor(origin.y))))
+		return;
+
+	const float min_x = origin.x - radius;
+	const float min_y = origin.y - radius;
+	const float max_x = origin.x + radius;
+	const float max_y = origin.y + radius;
+
+	vector<pair<float, Point2f>>& points = visibility_points;
+	points.clear();
+
+	// Casts towards (dx, dy), stopping at the edge of the square.
+	auto cast_towards = [&](float dx, float dy)
+	{
+		const float length = sqrt(dx * dx + dy * dy);
+
+		if (length == 0.0f)
+			return;
+
+		dx /= length;
+		dy /= length;
+
+		float max_t = INF;
+
+		if (dx != 0.0f)
+			max_t = std::min(max_t, ((dx > 0.0f ? max_x : min_x) - origin.x) / dx);
+
+		if (dy != 0.0f)
+			max_t = std::min(max_t, ((dy > 0.0f ? max_y : min_y) - origin.y) / dy);
+
+		RayHit hit;
+		cast(grid, origin, dx, dy, max_t, hit);
+		points.emplace_back(pseudo_angle(dx, dy), hit.point);
+	};
+
+	// Casts at the given corner and just to either side of it, so the
+	// polygon follows both the wall and whatever lies past its edge.
+	auto cast_corner = [&](float corner_x, float corner_y)
+	{
+		const float dx = corner_x - origin.x;
+		const float dy = corner_y - origin.y;
+
+		cast_towards(dx, dy);
+		cast_towards(dx - dy * CORNER_OFFSET, dy + dx * CORNER_OFFSET);
+		cast_towards(dx + dy * CORNER_OFFSET, dy - dx * CORNER_OFFSET);
+	};
+
+	cast_corner(min_x, min_y);
+	cast_corner(max_x, min_y);
+	cast_corner(min_x, max_y);
+	cast_corner(max_x, max_y);
+
+	// A point between 4 tiles is a corner of the walls unless the solid
+	// tiles around it form a straight edge or fill it completely.
+	const int32_t x0 = int32_t(std::ceil(min_x));
+	const int32_t y0 = int32_t(std::ceil(min_y));
+	const int32_t x1 = int32_t(floor(max_x));
+	const int32_t y1 = int32_t(floor(max_y));
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		for (int32_t x = x0; x <= x1; ++x)
+		{
+			const bool top_left = grid.solid(x - 1, y - 1);
+			const bool top_right = grid.solid(x, y - 1);
+			const bool bottom_left = grid.solid(x - 1, y);
+			const bool bottom_right = grid.solid(x, y);
+			const int32_t solid_count = int32_t(top_left) + int32_t(top_right) + int32_t(bottom_left) + int32_t(bottom_right);
+
+			if (solid_count == 1 || solid_count == 3 || (solid_count == 2 && top_left == bottom_right))
+				cast_corner(float(x), float(y));
+		}
+	}
+
+	// Walls cut by the edge of the square have their corners outside
+	// of it, so cast where their edges cross it instead.
+	const int32_t left = int32_t(floor(min_x));
+	const int32_t right = int32_t(floor(max_x));
+	const int32_t top = int32_t(floor(min_y));
+	const int32_t bottom = int32_t(floor(max_y));
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		if (grid.solid(left, y - 1) != grid.solid(left, y))
+			cast_corner(min_x, float(y));
+
+		if (grid.solid(right, y - 1) != grid.solid(right, y))
+			cast_corner(max_x, float(y));
+	}
+
+	for (int32_t x = x0; x <= x1; ++x)
+	{
+		if (grid.solid(x - 1, top) != grid.solid(x, top))
+			cast_corner(float(x), min_y);
+
+		if (grid.solid(x - 1, bottom) != grid.solid(x, bottom))
+			cast_corner(float(x), max_y);
+	}
+
+	std::sort(points.begin(), points.end(), [](const pair<float, Point2f>& a, const pair<float, Point2f>& b)
+	{
+		return a.first < b.first;
+	});
+
+	polygon.reserve(points.size());
+
+	for (const pair<float, Point2f>& point : points)
+	{
+		if (!polygon.empty() && std::fabs(polygon.back().x - point.second.x) < 0.0001f && std::fabs(polygon.back().y - point.second.y) < 0.0001f)
+			continue;
+
+		polygon.push_back(point.second);
+	}
+}
@@ -0,0 +1,87 @@
+// 2D Platform Game
+// Raycast.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for raycasts and visibility queries against the level layout.
+
+#ifndef RAYCAST_H_INCLUDED
+#define RAYCAST_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/ThreadPool.h"
+#include "Jlib/Vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// A ray to cast against the level layout.
+struct Ray
+{
+	Jlib::Point2f origin;
+
+	// Does not need to be a unit vector.
+	Jlib::Vector2f direction;
+
+	// Furthest distance the ray travels, in tiles.
+	float max_distance = std::numeric_limits<float>::infinity();
+};
+
+// Result of a raycast.
+struct RayHit
+{
+	// True if the ray hit a solid tile before travelling its maximum distance.
+	bool hit = false;
+
+	// The solid tile that was hit, or the last tile the ray
+	// passed through if nothing was hit.
+	Jlib::Point2i tile;
+
+	// Where the ray stopped.
+	Jlib::Point2f point;
+
+	// Points out of the face of the tile that was hit.
+	// The zero vector if nothing was hit or the ray started inside a solid tile.
+	Jlib::Vector2i normal;
+
+	// Distance from the origin to point, in tiles.
+	float distance = 0.0f;
+};
+
+// Casts a ray from origin along direction until it enters a solid tile
+// or travels max_distance tiles, walking the tiles it crosses in order
+// (Amanatides and Woo). Positions outside of the level are solid, so
+// every ray stops at the edge of the level.
+// A ray passing exactly through the corner shared by 2 tiles hits
+// them if either is solid, so rays never slip between diagonal walls.
+// A ray starting inside a solid tile hits it at distance 0.
+// A zero direction only checks the origin tile.
+// Returns hit.hit.
+bool raycast(const Jlib::Matrix<std::uint8_t>& level, const Jlib::Point2f& origin, const Jlib::Vector2f& direction, float max_distance, RayHit& hit);
+
+// Casts the given ray.
+// Returns hit.hit.
+bool raycast(const Jlib::Matrix<std::uint8_t>& level, const Ray& ray, RayHit& hit);
+
+// Casts every ray in rays, storing the result of rays[i] in hits[i].
+// hits is resized to match rays.
+// The rays are split across the given ThreadPool if there is one.
+void raycast_batch(const Jlib::Matrix<std::uint8_t>& level, const std::vector<Ray>& rays, std::vector<RayHit>& hits, Jlib::ThreadPool* pool = nullptr);
+
+// Returns true if no solid tile lies between from and to.
+// Returns false otherwise.
+bool line_of_sight(const Jlib::Matrix<std::uint8_t>& level, const Jlib::Point2f& from, const Jlib::Point2f& to);
+
+// Computes the area visible from origin within a square of
+// 2 * radius tiles, as a polygon around origin sorted by angle.
+// Rays are only cast towards the corners of walls and of the square
+// and where walls cross its edge, plus one to either side of each, so the cost depends on the
+// shape of the walls rather than on the size of the square.
+// polygon is left empty if origin is inside a solid tile.
+// This function will throw if radius is not positive.
+void visibility_polygon(const Jlib::Matrix<std::uint8_t>& level, const Jlib::Point2f& origin, float radius, std::vector<Jlib::Point2f>& polygon);
+
+#endif // RAYCAST_H_INCLUDED
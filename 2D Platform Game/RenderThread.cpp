@@ -0,0 +1,183 @@
+// 2D Platform Game
+// RenderThread.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the RenderSnapshot struct and the RenderThread class.
+
+#include "RenderThread.h"
+#include "Tile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// <chrono>
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::int32_t;
+using std::int64_t;
+using std::uint8_t;
+using std::uint64_t;
+
+// <functional>
+using std::function;
+
+namespace
+{
+	// Returns the mean and max of stats in milliseconds, and clears it.
+	template <typename Stats> void take_stats(Stats& stats, size_t& frames, double& mean, double& max)
+	{
+		frames = stats.frames.exchange(0, std::memory_order_relaxed);
+		const int64_t total = stats.total_nanoseconds.exchange(0, std::memory_order_relaxed);
+		max = double(stats.max_nanoseconds.exchange(0, std::memory_order_relaxed)) / 1e6;
+		mean = frames != 0 ? double(total) / double(frames) / 1e6 : 0.0;
+	}
+}
+
+void RenderSnapshot::capture(const Camera& camera, const Matrix<uint8_t>& level, int32_t margin)
+{
+	camera_top_left = camera.topLeft();
+	viewport = camera.viewport();
+	tile_area = camera.visibleTiles(margin);
+	sprites.clear();
+
+	const size_t width = size_t(tile_area.width);
+	const size_t height = size_t(tile_area.height);
+
+	tiles.resize(width * height);
+
+	for (size_t r = 0; r < height; ++r)
+	{
+		const int32_t y = tile_area.vertex.y + int32_t(r);
+		uint8_t* row = tiles.data() + r * width;
+
+		// Without camera bounds the area can reach outside of the level,
+		// which is drawn as solid, as is_solid_at treats it.
+		for (size_t c = 0; c < width;)
+		{
+			const int32_t x = tile_area.vertex.x + int32_t(c);
+
+			if (y < 0 || size_t(y) >= level.rowSize() || x >= int32_t(level.colSize()))
+			{
+				std::memset(row + c, TILE_SOLID, width - c);
+				break;
+			}
+
+			if (x < 0)
+			{
+				const size_t outside = std::min(size_t(-int64_t(x)), width - c);
+				std::memset(row + c, TILE_SOLID, outside);
+				c += outside;
+				continue;
+			}
+
+			const size_t inside = std::min(level.colSize() - size_t(x), width - c);
+			std::memcpy(row + c, level.data() + size_t(y) * level.colSize() + size_t(x), inside);
+			c += inside;
+		}
+	}
+}
+
+uint8_t RenderSnapshot::tileAt(int32_t x, int32_t y) const
+{
+	return tiles[size_t(y - tile_area.vertex.y) * size_t(tile_area.width) + size_t(x - tile_area.vertex.x)];
+}
+
+void RenderThread::FrameStats::add(int64_t nanoseconds)
+{
+	frames.fetch_add(1, std::memory_order_relaxed);
+	total_nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+	int64_t max = max_nanoseconds.load(std::memory_order_relaxed);
+
+	while (nanoseconds > max && !max_nanoseconds.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed));
+}
+
+RenderThread::RenderThread(function<void(const RenderSnapshot&)> render)
+	: render_(std::move(render))
+{
+	thread_ = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread()
+{
+	stopping_.store(true, std::memory_order_relaxed);
+	published_.fetch_add(1, std::memory_order_release);
+	published_.notify_one();
+	thread_.join();
+}
+
+void RenderThread::run()
+{
+	uint64_t seen = 0;
+
+	while (true)
+	{
+		published_.wait(seen, std::memory_order_acquire);
+		seen = published_.load(std::memory_order_acquire);
+
+		if (stopping_.load(std::memory_order_relaxed))
+			break;
+
+		if (!snapshots_.update())
+			continue;
+
+		const steady_clock::time_point start = steady_clock::now();
+
+		try
+		{
+			render_(snapshots_.front());
+		}
+		catch (...)
+		{
+			exception_ = std::current_exception();
+			failed_.store(true, std::memory_order_release);
+			break;
+		}
+
+		render_stats_.add(duration_cast<nanoseconds>(steady_clock::now() - start).count());
+	}
+}
+
+RenderSnapshot& RenderThread::snapshot()
+{
+	return snapshots_.back();
+}
+
+void RenderThread::publish(double simulation_milliseconds)
+{
+	if (failed_.load(std::memory_order_acquire))
+		std::rethrow_exception(exception_);
+
+	simulation_stats_.add(int64_t(simulation_milliseconds * 1e6));
+
+	if (snapshots_.publish())
+		skipped_.fetch_add(1, std::memory_order_relaxed);
+
+	published_.fetch_add(1, std::memory_order_release);
+	published_.notify_one();
+}
+
+FrameReport RenderThread::takeReport()
+{
+	FrameReport report;
+
+	take_stats(simulation_stats_, report.simulation_frames, report.simulation_mean_milliseconds, report.simulation_max_milliseconds);
+	take_stats(render_stats_, report.render_frames, report.render_mean_milliseconds, report.render_max_milliseconds);
+	report.skipped_snapshots = skipped_.exchange(0, std::memory_order_relaxed);
+
+	return report;
+}
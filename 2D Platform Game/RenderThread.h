@@ -0,0 +1,148 @@
+// 2D Platform Game
+// RenderThread.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the RenderSnapshot struct and the RenderThread class.
+
+#ifndef RENDERTHREAD_H_INCLUDED
+#define RENDERTHREAD_H_INCLUDED
+
+#include "Camera.h"
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/Rectangle.h"
+#include "Jlib/TripleBuffer.h"
+#include "Jlib/Vector.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <vector>
+
+// A sprite to draw, in tiles.
+struct RenderSprite
+{
+	Jlib::Point2f position;
+	std::uint32_t sprite = 0;
+
+	// Sprites on higher layers are drawn over lower ones.
+	std::uint8_t layer = 0;
+};
+
+// Everything the renderer needs from one tick, copied out of the
+// simulation so the two can run at once.
+struct RenderSnapshot
+{
+	std::uint64_t tick = 0;
+
+	Jlib::Point2f camera_top_left;
+	Jlib::Vector2f viewport;
+
+	// The tiles on screen, as given by Camera::visibleTiles, and a copy
+	// of them row by row.
+	Jlib::Rectangle<std::int32_t> tile_area;
+	std::vector<std::uint8_t> tiles;
+
+	std::vector<RenderSprite> sprites;
+
+	// Fills in the camera and copies the tiles on screen, plus margin
+	// tiles around them, from level. Clears the sprites.
+	// Reuses the memory of the last snapshot written to this one.
+	void capture(const Camera& camera, const Jlib::Matrix<std::uint8_t>& level, std::int32_t margin = 1);
+
+	// Returns the tile at (x, y), which must be inside tile_area.
+	std::uint8_t tileAt(std::int32_t x, std::int32_t y) const;
+};
+
+// Frame times since the last RenderThread::takeReport.
+struct FrameReport
+{
+	std::size_t simulation_frames = 0;
+	double simulation_mean_milliseconds = 0.0;
+	double simulation_max_milliseconds = 0.0;
+
+	std::size_t render_frames = 0;
+	double render_mean_milliseconds = 0.0;
+	double render_max_milliseconds = 0.0;
+
+	// Snapshots published but replaced before the renderer took them.
+	std::size_t skipped_snapshots = 0;
+};
+
+// Draws on its own thread, so the simulation of the next tick runs
+// while the last one is drawn.
+// The simulation fills snapshot and calls publish; the render thread
+// takes the newest snapshot from a Jlib::TripleBuffer and calls the
+// render function with it. Neither thread takes a lock: the render
+// thread sleeps on an atomic counter while there is nothing new, and
+// a slow renderer only skips snapshots, never holds up the simulation.
+class RenderThread
+{
+	// Frame times added by one thread and taken by another.
+	struct FrameStats
+	{
+		std::atomic<std::size_t> frames = 0;
+		std::atomic<std::int64_t> total_nanoseconds = 0;
+		std::atomic<std::int64_t> max_nanoseconds = 0;
+
+		void add(std::int64_t nanoseconds);
+	};
+
+	Jlib::TripleBuffer<RenderSnapshot> snapshots_;
+	std::function<void(const RenderSnapshot&)> render_;
+
+	std::atomic<std::uint64_t> published_ = 0;
+	std::atomic<bool> stopping_ = false;
+
+	// exception_ is written before failed_ is set, and read after.
+	std::exception_ptr exception_;
+	std::atomic<bool> failed_ = false;
+
+	FrameStats simulation_stats_;
+	FrameStats render_stats_;
+	std::atomic<std::size_t> skipped_ = 0;
+
+	std::thread thread_;
+
+	// Body of the render thread.
+	void run();
+
+	public:
+
+	// Render function constructor.
+	// Starts the render thread, which calls render with each snapshot
+	// it takes. Anything render uses besides the snapshot, such as the
+	// window, belongs to the render thread from then on.
+	explicit RenderThread(std::function<void(const RenderSnapshot&)> render);
+
+	// Copy constructor. Deleted.
+	RenderThread(const RenderThread& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	RenderThread& operator = (const RenderThread& other) = delete;
+
+	// Destructor.
+	// Stops the render thread after the frame it is drawing.
+	~RenderThread();
+
+	// Simulation thread only.
+	// Returns the snapshot to fill before the next publish.
+	RenderSnapshot& snapshot();
+
+	// Simulation thread only.
+	// Hands the filled snapshot to the render thread, and records how
+	// long the simulation of this tick took.
+	// If the render function threw, the exception is rethrown here and
+	// nothing more is drawn.
+	void publish(double simulation_milliseconds);
+
+	// Returns the frame times since the last call, and starts counting again.
+	FrameReport takeReport();
+};
+
+#endif // RENDERTHREAD_H_INCLUDED
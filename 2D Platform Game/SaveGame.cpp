@@ -0,0 +1,541 @@
+// 2D Platform Game
+// SaveGame.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for save files and the SaveWriter class.
+
+#include "SaveGame.h"
+#include "ByteStream.h"
+#include "Compression.h"
+#include "ContentStore.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+// Jlib/Matrix.h
+using Jlib::Matrix;
+
+// <chrono>
+using std::chrono::duration;
+using std::chrono::steady_clock;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint32_t;
+using std::uint64_t;
+
+// <filesystem>
+namespace fs = std::filesystem;
+
+// <fstream>
+using std::ifstream;
+using std::ofstream;
+
+// <memory>
+using std::make_unique;
+using std::unique_ptr;
+
+// <mutex>
+using std::lock_guard;
+using std::mutex;
+using std::unique_lock;
+
+// <stdexcept>
+using std::runtime_error;
+
+// <string>
+using std::string;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	// A save file is this header followed by the payload compressed
+	// with lz_compress:
+	//
+	//     magic "JSAV", version as uint32_t,
+	//     payload size as uint64_t, content_hash of the payload as uint64_t
+	//
+	// Version 1 payload, with counts and integers as varints:
+	//
+	//     tick
+	//     player position x, y, velocity x, y as floats, is_grounded as a byte
+	//     layout width, height, then LAYOUT_DIFF or LAYOUT_FULL:
+	//         LAYOUT_DIFF: content_hash of the base layout as uint64_t,
+	//             then runs of tiles differing from the base: tiles
+	//             skipped since the last run, run length, the tiles;
+	//             ended by a run of length 0
+	//         LAYOUT_FULL: width * height tiles
+	//     entity count, then each field of every entity in turn: types,
+	//     flags, positions and velocities as floats
+	//
+	// Storing entities field by field puts alike bytes together, which
+	// compresses better than one entity after another.
+	constexpr char SAVE_MAGIC[4] = { 'J', 'S', 'A', 'V' };
+	constexpr size_t SAVE_HEADER_SIZE = 4 + 4 + 8 + 8;
+
+	constexpr uint8_t LAYOUT_DIFF = 0;
+	constexpr uint8_t LAYOUT_FULL = 1;
+
+	// Differing tiles fewer than this many tiles apart go in one run,
+	// as a new run costs at least 2 bytes.
+	constexpr size_t RUN_MERGE_GAP = 4;
+
+	double milliseconds_since(steady_clock::time_point start)
+	{
+		return duration<double, std::milli>(steady_clock::now() - start).count();
+	}
+
+	uint64_t load64(const uint8_t* data)
+	{
+		uint64_t value = 0;
+		std::memcpy(&value, data, 8);
+		return value;
+	}
+
+	// Writes the runs of tiles that differ between layout and base,
+	// which are the same size. Returns the amount of tiles that differ.
+	size_t write_tile_diff(const uint8_t* layout, const uint8_t* base, size_t size, ByteWriter& writer)
+	{
+		size_t changed = 0;
+		size_t last_end = 0;
+		size_t i = 0;
+
+		while (i < size)
+		{
+			// Most of a level is unchanged, so skip 8 tiles at a time.
+			while (i + 8 <= size && load64(layout + i) == load64(base + i))
+				i += 8;
+
+			while (i < size && layout[i] == base[i])
+				++i;
+
+			if (i == size)
+				break;
+
+			const size_t start = i;
+			size_t end = i + 1;
+			size_t same = 0;
+
+			++changed;
+
+			for (size_t j = i + 1; j < size && same < RUN_MERGE_GAP; ++j)
+			{
+				if (layout[j] == base[j])
+					++same;
+				else
+				{
+					same = 0;
+					end = j + 1;
+					++changed;
+				}
+			}
+
+			writer.writeVarint(start - last_end);
+			writer.writeVarint(end - start);
+			writer.writeBytes(layout + start, end - start);
+
+			last_end = end;
+			i = end;
+		}
+
+		writer.writeVarint(0);
+		writer.writeVarint(0);
+
+		return changed;
+	}
+
+	void write_payload(const SaveState& state, const Matrix<uint8_t>& base, ByteWriter& writer, SaveReport* report)
+	{
+		writer.writeVarint(state.tick);
+		writer.writeF32(state.player_position.x);
+		writer.writeF32(state.player_position.y);
+		writer.writeF32(state.player_velocity.x);
+		writer.writeF32(state.player_velocity.y);
+		writer.writeU8(state.is_grounded ? 1 : 0);
+
+		const Matrix<uint8_t>& layout = state.layout;
+		size_t changed = layout.size();
+
+		writer.writeVarint(layout.colSize());
+		writer.writeVarint(layout.rowSize());
+
+		if (layout.rowSize() == base.rowSize() && layout.colSize() == base.colSize())
+		{
+			writer.writeU8(LAYOUT_DIFF);
+			writer.writeU64(content_hash(base.data(), base.size()));
+			changed = write_tile_diff(layout.data(), base.data(), layout.size(), writer);
+		}
+		else
+		{
+			writer.writeU8(LAYOUT_FULL);
+			writer.writeBytes(layout.data(), layout.size());
+		}
+
+		const vector<EntityState>& entities = state.entities;
+
+		writer.writeVarint(entities.size());
+
+		for (const EntityState& entity : entities)
+			writer.writeVarint(entity.type);
+
+		for (const EntityState& entity : entities)
+			writer.writeVarint(entity.flags);
+
+		// The float columns are written in place, with no check per value.
+		uint8_t* positions = writer.reserve(entities.size() * 8);
+
+		for (const EntityState& entity : entities)
+		{
+			std::memcpy(positions, &entity.position.x, 4);
+			std::memcpy(positions + 4, &entity.position.y, 4);
+			positions += 8;
+		}
+
+		uint8_t* velocities = writer.reserve(entities.size() * 8);
+
+		for (const EntityState& entity : entities)
+		{
+			std::memcpy(velocities, &entity.velocity.x, 4);
+			std::memcpy(velocities + 4, &entity.velocity.y, 4);
+			velocities += 8;
+		}
+
+		if (report != nullptr)
+			report->changed_tiles = changed;
+	}
+
+	void read_payload_v1(ByteReader& reader, const Matrix<uint8_t>& base, SaveState& state)
+	{
+		state.tick = reader.readVarint();
+		state.player_position.x = reader.readF32();
+		state.player_position.y = reader.readF32();
+		state.player_velocity.x = reader.readF32();
+		state.player_velocity.y = reader.readF32();
+		state.is_grounded = reader.readU8() != 0;
+
+		const uint64_t width = reader.readVarint();
+		const uint64_t height = reader.readVarint();
+		const uint8_t layout_kind = reader.readU8();
+
+		if (layout_kind == LAYOUT_DIFF)
+		{
+			if (width != base.colSize() || height != base.rowSize() || reader.readU64() != content_hash(base.data(), base.size()))
+				throw runtime_error("deserialize_save: the save was made against a different level");
+
+			state.layout = base;
+
+			uint8_t* const tiles = state.layout.data();
+			const size_t size = state.layout.size();
+			size_t position = 0;
+
+			while (true)
+			{
+				const uint64_t skip = reader.readVarint();
+				const uint64_t length = reader.readVarint();
+
+				if (length == 0)
+					break;
+
+				if (skip > size - position || length > size - position - skip)
+					throw runtime_error("deserialize_save: tile run outside of the level");
+
+				position += size_t(skip);
+				std::memcpy(tiles + position, reader.readBytes(size_t(length)), size_t(length));
+				position += size_t(length);
+			}
+		}
+		else if (layout_kind == LAYOUT_FULL)
+		{
+			// A damaged size must not allocate more than the file holds.
+			if (width != 0 && height > reader.remaining() / width)
+				throw runtime_error("deserialize_save: layout larger than the file");
+
+			state.layout.resize(size_t(height), size_t(width));
+			std::memcpy(state.layout.data(), reader.readBytes(state.layout.size()), state.layout.size());
+		}
+		else
+			throw runtime_error("deserialize_save: unknown layout kind");
+
+		const uint64_t count = reader.readVarint();
+
+		// Each entity takes at least 18 bytes.
+		if (count > reader.remaining() / 18)
+			throw runtime_error("deserialize_save: more entities than the file holds");
+
+		vector<EntityState>& entities = state.entities;
+		entities.resize(size_t(count));
+
+		for (EntityState& entity : entities)
+			entity.type = uint32_t(reader.readVarint());
+
+		for (EntityState& entity : entities)
+			entity.flags = uint32_t(reader.readVarint());
+
+		const uint8_t* positions = reader.readBytes(entities.size() * 8);
+
+		for (EntityState& entity : entities)
+		{
+			std::memcpy(&entity.position.x, positions, 4);
+			std::memcpy(&entity.position.y, positions + 4, 4);
+			positions += 8;
+		}
+
+		const uint8_t* velocities = reader.readBytes(entities.size() * 8);
+
+		for (EntityState& entity : entities)
+		{
+			std::memcpy(&entity.velocity.x, velocities, 4);
+			std::memcpy(&entity.velocity.y, velocities + 4, 4);
+			velocities += 8;
+		}
+
+		if (reader.remaining() != 0)
+			throw runtime_error("deserialize_save: unexpected bytes after the payload");
+	}
+}
+
+void serialize_save(const SaveState& state, const Matrix<uint8_t>& base, vector<uint8_t>& payload, vector<uint8_t>& file, SaveReport* report)
+{
+	steady_clock::time_point start = steady_clock::now();
+
+	payload.clear();
+	ByteWriter payload_writer(payload);
+	write_payload(state, base, payload_writer, report);
+
+	if (report != nullptr)
+		report->serialize_milliseconds = milliseconds_since(start);
+
+	start = steady_clock::now();
+
+	file.clear();
+	ByteWriter file_writer(file);
+	const uint32_t version = SAVE_VERSION;
+
+	file_writer.writeBytes(SAVE_MAGIC, 4);
+	file_writer.writeU32(version);
+	file_writer.writeU64(payload.size());
+	file_writer.writeU64(content_hash(payload.data(), payload.size()));
+	lz_compress(payload.data(), payload.size(), file_writer);
+
+	if (report != nullptr)
+	{
+		report->compress_milliseconds = milliseconds_since(start);
+		report->payload_bytes = payload.size();
+		report->file_bytes = file.size();
+	}
+}
+
+void deserialize_save(const uint8_t* data, size_t size, const Matrix<uint8_t>& base, SaveState& state, LoadReport* report)
+{
+	steady_clock::time_point start = steady_clock::now();
+
+	if (size < SAVE_HEADER_SIZE || std::memcmp(data, SAVE_MAGIC, 4) != 0)
+		throw runtime_error("deserialize_save: not a save file");
+
+	ByteReader header(data + 4, SAVE_HEADER_SIZE - 4);
+	const uint32_t version = header.readU32();
+	const uint64_t payload_size = header.readU64();
+	const uint64_t payload_hash = header.readU64();
+
+	if (version == 0 || version > SAVE_VERSION)
+		throw runtime_error("deserialize_save: unsupported version " + std::to_string(version));
+
+	// Each compressed byte holds at most 255 + a few bytes, so a damaged
+	// size must not allocate more than that.
+	if (payload_size > uint64_t(size) * 256)
+		throw runtime_error("deserialize_save: the file is damaged");
+
+	// Kept between loads on this thread, as it is only needed here.
+	thread_local vector<uint8_t> payload;
+	payload.resize(size_t(payload_size));
+	lz_decompress(data + SAVE_HEADER_SIZE, size - SAVE_HEADER_SIZE, payload.data(), payload.size());
+
+	if (content_hash(payload.data(), payload.size()) != payload_hash)
+		throw runtime_error("deserialize_save: the file is damaged");
+
+	if (report != nullptr)
+	{
+		report->decompress_milliseconds = milliseconds_since(start);
+		report->payload_bytes = payload.size();
+		report->file_bytes = size;
+	}
+
+	start = steady_clock::now();
+
+	// Versions that change the payload get a reader of their own here.
+	ByteReader reader(payload.data(), payload.size());
+	read_payload_v1(reader, base, state);
+
+	if (report != nullptr)
+		report->deserialize_milliseconds = milliseconds_since(start);
+}
+
+SaveState load_save(const string& path, const Matrix<uint8_t>& base, LoadReport* report)
+{
+	const steady_clock::time_point start = steady_clock::now();
+
+	ifstream fin(path, std::ios::binary | std::ios::ate);
+
+	if (!fin.is_open())
+		throw runtime_error("load_save: could not open " + path);
+
+	vector<uint8_t> file(size_t(fin.tellg()));
+	fin.seekg(0);
+
+	if (!fin.read(reinterpret_cast<char*>(file.data()), std::streamsize(file.size())))
+		throw runtime_error("load_save: could not read " + path);
+
+	if (report != nullptr)
+		report->read_milliseconds = milliseconds_since(start);
+
+	SaveState state;
+	deserialize_save(file.data(), file.size(), base, state, report);
+
+	return state;
+}
+
+SaveWriter::SaveWriter(const Matrix<uint8_t>& base)
+	: base_(base)
+{
+	thread_ = std::thread(&SaveWriter::run, this);
+}
+
+SaveWriter::~SaveWriter()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stopping_ = true;
+	}
+
+	wake_.notify_one();
+	thread_.join();
+}
+
+void SaveWriter::write(const Job& job)
+{
+	SaveReport report;
+	serialize_save(job.state, base_, payload_, file_, &report);
+	report.snapshot_milliseconds = job.snapshot_milliseconds;
+
+	const steady_clock::time_point start = steady_clock::now();
+	const string temporary = job.path + ".tmp";
+
+	{
+		ofstream fout(temporary, std::ios::binary | std::ios::trunc);
+		fout.write(reinterpret_cast<const char*>(file_.data()), std::streamsize(file_.size()));
+
+		if (!fout)
+			throw runtime_error("SaveWriter: could not write " + temporary);
+	}
+
+	std::error_code error;
+	fs::rename(temporary, job.path, error);
+
+	if (error)
+		throw runtime_error("SaveWriter: could not replace " + job.path + ": " + error.message());
+
+	report.write_milliseconds = milliseconds_since(start);
+
+	lock_guard<mutex> lock(mutex_);
+	report_ = report;
+}
+
+void SaveWriter::run()
+{
+	unique_lock<mutex> lock(mutex_);
+
+	while (true)
+	{
+		wake_.wait(lock, [this] { return queued_ != nullptr || stopping_; });
+
+		if (queued_ == nullptr)
+			break;
+
+		unique_ptr<Job> job = std::move(queued_);
+		writing_ = true;
+		lock.unlock();
+
+		string error;
+
+		try
+		{
+			write(*job);
+		}
+		catch (const std::exception& e)
+		{
+			error = e.what();
+		}
+
+		lock.lock();
+		writing_ = false;
+		error_ = error;
+		++completed_;
+		recycled_ = std::move(job);
+		idle_.notify_all();
+	}
+}
+
+void SaveWriter::save(const string& path, const SaveState& state)
+{
+	const steady_clock::time_point start = steady_clock::now();
+	unique_ptr<Job> job;
+
+	{
+		lock_guard<mutex> lock(mutex_);
+		job = queued_ != nullptr ? std::move(queued_) : std::move(recycled_);
+	}
+
+	if (job == nullptr)
+		job = make_unique<Job>();
+
+	// Reuses the memory of the job's last state when it is big enough.
+	job->path = path;
+	job->state = state;
+	job->snapshot_milliseconds = milliseconds_since(start);
+
+	{
+		lock_guard<mutex> lock(mutex_);
+		queued_ = std::move(job);
+	}
+
+	wake_.notify_one();
+}
+
+bool SaveWriter::busy() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return queued_ != nullptr || writing_;
+}
+
+void SaveWriter::wait()
+{
+	unique_lock<mutex> lock(mutex_);
+	idle_.wait(lock, [this] { return queued_ == nullptr && !writing_; });
+}
+
+size_t SaveWriter::completedCount() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return completed_;
+}
+
+SaveReport SaveWriter::lastReport() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return report_;
+}
+
+string SaveWriter::lastError() const
+{
+	lock_guard<mutex> lock(mutex_);
+	return error_;
+}
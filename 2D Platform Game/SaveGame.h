@@ -0,0 +1,177 @@
+// 2D Platform Game
+// SaveGame.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for save files and the SaveWriter class.
+
+#ifndef SAVEGAME_H_INCLUDED
+#define SAVEGAME_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+#include "Jlib/Point.h"
+#include "Jlib/Vector.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Newest save file version. Files of older versions can still be read.
+constexpr std::uint32_t SAVE_VERSION = 1;
+
+// An entity as kept in a save.
+struct EntityState
+{
+	std::uint32_t type = 0;
+	Jlib::Point2f position;
+	Jlib::Vector2f velocity;
+
+	// Free for the entity type to use.
+	std::uint32_t flags = 0;
+};
+
+// Everything a save holds.
+struct SaveState
+{
+	std::uint64_t tick = 0;
+
+	Jlib::Point2f player_position;
+	Jlib::Vector2f player_velocity;
+	bool is_grounded = false;
+
+	std::vector<EntityState> entities;
+
+	// The level as it is now. Only the tiles that differ from the base
+	// level are written.
+	Jlib::Matrix<std::uint8_t> layout;
+};
+
+// Sizes and times of the last save written by SaveWriter.
+struct SaveReport
+{
+	// Milliseconds the calling thread spent copying the state in save.
+	double snapshot_milliseconds = 0.0;
+
+	// Milliseconds the background thread spent on each step.
+	double serialize_milliseconds = 0.0;
+	double compress_milliseconds = 0.0;
+	double write_milliseconds = 0.0;
+
+	// Tiles that differ from the base level.
+	std::size_t changed_tiles = 0;
+
+	// Bytes before compression, and of the whole file.
+	std::size_t payload_bytes = 0;
+	std::size_t file_bytes = 0;
+};
+
+// Sizes and times of a load_save.
+struct LoadReport
+{
+	double read_milliseconds = 0.0;
+	double decompress_milliseconds = 0.0;
+	double deserialize_milliseconds = 0.0;
+	std::size_t payload_bytes = 0;
+	std::size_t file_bytes = 0;
+};
+
+// Writes state as a save file to file, replacing its contents.
+// The layout is stored as the tiles that differ from base, or in full
+// if its size differs from base.
+// payload is scratch space; keep it between calls so its memory is reused.
+// If report is not nullptr, its sizes and serialize and compress times are filled in.
+void serialize_save(const SaveState& state, const Jlib::Matrix<std::uint8_t>& base, std::vector<std::uint8_t>& payload, std::vector<std::uint8_t>& file, SaveReport* report = nullptr);
+
+// Reads the save file in data into state, reusing its memory.
+// base must be the level the save was made against.
+// This function will throw if the file is damaged, is of a newer
+// version or was made against a different base level.
+void deserialize_save(const std::uint8_t* data, std::size_t size, const Jlib::Matrix<std::uint8_t>& base, SaveState& state, LoadReport* report = nullptr);
+
+// Reads the save file at path. See deserialize_save.
+// This function will throw if the file cannot be read.
+SaveState load_save(const std::string& path, const Jlib::Matrix<std::uint8_t>& base, LoadReport* report = nullptr);
+
+// Writes saves on a background thread, so the game loop only pays for
+// copying the state. save copies into a snapshot kept from the last
+// save, so a world of the same size is copied without allocating, and
+// the background thread serializes, compresses and writes it through a
+// temporary file, so a crash never leaves half a save.
+// A save asked for while another is queued replaces it; the one being
+// written is finished first.
+class SaveWriter
+{
+	struct Job
+	{
+		std::string path;
+		SaveState state;
+		double snapshot_milliseconds = 0.0;
+	};
+
+	Jlib::Matrix<std::uint8_t> base_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable idle_;
+	std::unique_ptr<Job> queued_;
+	std::unique_ptr<Job> recycled_;
+	bool writing_ = false;
+	bool stopping_ = false;
+	std::size_t completed_ = 0;
+	SaveReport report_;
+	std::string error_;
+
+	// Background thread only, kept so their memory is reused.
+	std::vector<std::uint8_t> payload_;
+	std::vector<std::uint8_t> file_;
+
+	std::thread thread_;
+
+	// Serializes and writes job. Runs on the background thread.
+	void write(const Job& job);
+
+	// Body of the background thread.
+	void run();
+
+	public:
+
+	// Base level constructor.
+	// Saves store their layout as the tiles that differ from base.
+	explicit SaveWriter(const Jlib::Matrix<std::uint8_t>& base);
+
+	// Copy constructor. Deleted.
+	SaveWriter(const SaveWriter& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	SaveWriter& operator = (const SaveWriter& other) = delete;
+
+	// Destructor.
+	// Finishes any queued save, then stops the background thread.
+	~SaveWriter();
+
+	// Queues a copy of state to be written to path.
+	void save(const std::string& path, const SaveState& state);
+
+	// Returns true if a save is queued or being written.
+	// Returns false otherwise.
+	bool busy() const;
+
+	// Blocks until every queued save is written.
+	void wait();
+
+	// Returns the amount of saves written.
+	std::size_t completedCount() const;
+
+	// Returns the report of the last save written.
+	SaveReport lastReport() const;
+
+	// Returns why the last save failed, or an empty string if it did not.
+	std::string lastError() const;
+};
+
+#endif // SAVEGAME_H_INCLUDED
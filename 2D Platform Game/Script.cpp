@@ -0,0 +1,314 @@
+// 2D Platform Game
+// Script.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the Script and ScriptScheduler classes.
+
+#include "Script.h"
+
+#include <new>
+
+// <coroutine>
+using std::coroutine_handle;
+using std::noop_coroutine;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint64_t;
+
+// <exception>
+using std::exception_ptr;
+using std::rethrow_exception;
+
+namespace
+{
+	// Frames are handed out in size classes of CLASS_SIZE bytes up to
+	// CLASS_SIZE * CLASS_COUNT. Larger frames go to the heap.
+	constexpr size_t CLASS_SIZE = 64;
+	constexpr size_t CLASS_COUNT = 16;
+	constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	// A freed frame holds the next free frame of its size class.
+	struct FreeFrame
+	{
+		FreeFrame* next;
+	};
+
+	// Every member is trivially destructible, so frames freed by
+	// objects destroyed after the thread's own destructors have run
+	// are still safe. Chunks are kept for the life of the thread.
+	struct FramePool
+	{
+		FreeFrame* free_lists[CLASS_COUNT];
+		char* chunk;
+		size_t chunk_left;
+	};
+
+	thread_local FramePool frame_pool = {};
+}
+
+coroutine_handle<> Script::promise_type::FinalAwaiter::await_suspend(Handle handle) noexcept
+{
+	const Handle parent = handle.promise().parent;
+
+	if (!parent)
+		return noop_coroutine();
+
+	parent.promise().root->leaf = parent;
+	return parent;
+}
+
+Script Script::promise_type::get_return_object()
+{
+	return Script(Handle::from_promise(*this));
+}
+
+void Script::promise_type::unhandled_exception()
+{
+	exception = std::current_exception();
+}
+
+void* Script::promise_type::operator new(size_t size)
+{
+	if (size > CLASS_SIZE * CLASS_COUNT)
+		return ::operator new(size);
+
+	const size_t size_class = (size - 1) / CLASS_SIZE;
+	FramePool& pool = frame_pool;
+
+	if (FreeFrame* frame = pool.free_lists[size_class])
+	{
+		pool.free_lists[size_class] = frame->next;
+		return frame;
+	}
+
+	const size_t class_bytes = (size_class + 1) * CLASS_SIZE;
+
+	// The rest of a chunk too small for this class is left unused.
+	if (pool.chunk_left < class_bytes)
+	{
+		pool.chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+		pool.chunk_left = CHUNK_SIZE;
+	}
+
+	void* frame = pool.chunk;
+	pool.chunk += class_bytes;
+	pool.chunk_left -= class_bytes;
+
+	return frame;
+}
+
+void Script::promise_type::operator delete(void* frame, size_t size)
+{
+	if (size > CLASS_SIZE * CLASS_COUNT)
+	{
+		::operator delete(frame);
+		return;
+	}
+
+	FreeFrame*& free_list = frame_pool.free_lists[(size - 1) / CLASS_SIZE];
+	free_list = new (frame) FreeFrame { free_list };
+}
+
+coroutine_handle<> Script::ChildAwaiter::await_suspend(Handle parent) noexcept
+{
+	promise_type& promise = child.promise();
+
+	promise.root = parent.promise().root;
+	promise.parent = parent;
+	promise.root->leaf = child;
+
+	return child;
+}
+
+void Script::ChildAwaiter::await_resume() const
+{
+	if (child && child.promise().exception)
+		rethrow_exception(child.promise().exception);
+}
+
+Script::Script(Handle handle)
+{
+	handle_ = handle;
+}
+
+Script::Script(Script&& other) noexcept
+{
+	handle_ = other.release();
+}
+
+Script& Script::operator = (Script&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (handle_)
+			handle_.destroy();
+
+		handle_ = other.release();
+	}
+
+	return *this;
+}
+
+Script::~Script()
+{
+	if (handle_)
+		handle_.destroy();
+}
+
+bool Script::done() const
+{
+	return !handle_ || handle_.done();
+}
+
+Script::Handle Script::release()
+{
+	const Handle handle = handle_;
+	handle_ = nullptr;
+	return handle;
+}
+
+Script::ChildAwaiter Script::operator co_await() && noexcept
+{
+	return ChildAwaiter { handle_ };
+}
+
+void WaitSeconds::await_suspend(Script::Handle handle) const noexcept
+{
+	Script::promise_type& root = *handle.promise().root;
+
+	root.resume_time = root.scheduler->time() + double(seconds);
+}
+
+void WaitTicks::await_suspend(Script::Handle handle) const noexcept
+{
+	Script::promise_type& root = *handle.promise().root;
+
+	root.resume_tick = root.scheduler->tick() + ticks;
+}
+
+ScriptScheduler::~ScriptScheduler()
+{
+	for (Script::Handle handle : scripts_)
+		handle.destroy();
+
+	for (Script::Handle handle : started_)
+		handle.destroy();
+}
+
+uint64_t ScriptScheduler::start(Script script)
+{
+	if (script.done())
+		return 0;
+
+	const Script::Handle handle = script.release();
+	Script::promise_type& promise = handle.promise();
+
+	promise.leaf = handle;
+	promise.scheduler = this;
+	promise.id = next_id_++;
+	started_.push_back(handle);
+
+	return promise.id;
+}
+
+bool ScriptScheduler::stop(uint64_t id)
+{
+	for (Script::Handle handle : scripts_)
+	{
+		Script::promise_type& promise = handle.promise();
+
+		if (promise.id == id && !promise.cancelled)
+		{
+			promise.cancelled = true;
+			return true;
+		}
+	}
+
+	for (Script::Handle handle : started_)
+	{
+		Script::promise_type& promise = handle.promise();
+
+		if (promise.id == id && !promise.cancelled)
+		{
+			promise.cancelled = true;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ScriptScheduler::update(float seconds)
+{
+	time_ += seconds;
+	++tick_;
+
+	// Scripts started during this update wait for the next one.
+	scripts_.insert(scripts_.end(), started_.begin(), started_.end());
+	started_.clear();
+
+	exception_ptr first_exception;
+
+	for (size_t i = 0; i < scripts_.size();)
+	{
+		const Script::Handle handle = scripts_[i];
+		Script::promise_type& promise = handle.promise();
+
+		if (!promise.cancelled)
+		{
+			if (promise.resume_tick > tick_ || promise.resume_time > time_)
+			{
+				++i;
+				continue;
+			}
+
+			if (promise.condition)
+			{
+				if (!promise.condition(promise.condition_context))
+				{
+					++i;
+					continue;
+				}
+
+				promise.condition = nullptr;
+			}
+
+			promise.leaf.resume();
+
+			if (!handle.done())
+			{
+				++i;
+				continue;
+			}
+
+			if (promise.exception && !first_exception)
+				first_exception = promise.exception;
+		}
+
+		handle.destroy();
+		scripts_[i] = scripts_.back();
+		scripts_.pop_back();
+	}
+
+	if (first_exception)
+		rethrow_exception(first_exception);
+}
+
+double ScriptScheduler::time() const
+{
+	return time_;
+}
+
+uint64_t ScriptScheduler::tick() const
+{
+	return tick_;
+}
+
+size_t ScriptScheduler::runningCount() const
+{
+	return scripts_.size() + started_.size();
+}
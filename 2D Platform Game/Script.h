@@ -0,0 +1,256 @@
+// 2D Platform Game
+// Script.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the Script and ScriptScheduler classes.
+
+#ifndef SCRIPT_H_INCLUDED
+#define SCRIPT_H_INCLUDED
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class ScriptScheduler;
+
+// A C++20 coroutine for game logic that spans many ticks, such as
+// "wait 2 seconds, jump, wait until grounded". A function returning
+// Script can co_await wait_seconds, wait_ticks, next_tick, wait_until
+// and other Scripts, which run as part of it.
+// A Script does nothing until it is started by a ScriptScheduler or
+// awaited by another Script.
+// Coroutine frames come from a pool kept by each thread, so once
+// the pool has grown, starting and finishing Scripts does not touch
+// the heap. A Script must be destroyed on the thread that created it.
+class Script
+{
+	public:
+
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	struct promise_type
+	{
+		// The outermost Script. Wait state lives there, so the
+		// ScriptScheduler only looks at one place per Script.
+		promise_type* root = this;
+
+		// Set on the root: the innermost Script currently running.
+		Handle leaf;
+
+		// Set on awaited Scripts: the Script awaiting it.
+		Handle parent;
+
+		// Set on the root by ScriptScheduler::start.
+		ScriptScheduler* scheduler = nullptr;
+		std::uint64_t id = 0;
+		bool cancelled = false;
+
+		// The root does not resume before both of these are reached,
+		// nor while condition(condition_context) returns false.
+		double resume_time = 0.0;
+		std::uint64_t resume_tick = 0;
+		bool (*condition)(void*) = nullptr;
+		void* condition_context = nullptr;
+
+		std::exception_ptr exception;
+
+		// Resumes the awaiting Script, if there is one, when this one finishes.
+		struct FinalAwaiter
+		{
+			bool await_ready() const noexcept { return false; }
+			std::coroutine_handle<> await_suspend(Handle handle) noexcept;
+			void await_resume() const noexcept {}
+		};
+
+		Script get_return_object();
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+		void return_void() const noexcept {}
+		void unhandled_exception();
+
+		// Frames are taken from the pool of the calling thread.
+		static void* operator new(std::size_t size);
+		static void operator delete(void* frame, std::size_t size);
+	};
+
+	// Runs an awaited Script inside the awaiting one.
+	struct ChildAwaiter
+	{
+		Handle child;
+
+		bool await_ready() const noexcept { return !child || child.done(); }
+		std::coroutine_handle<> await_suspend(Handle parent) noexcept;
+		void await_resume() const;
+	};
+
+	private:
+
+	Handle handle_;
+
+	public:
+
+	// Default constructor.
+	// The Script has no coroutine.
+	Script() = default;
+
+	// Handle constructor.
+	explicit Script(Handle handle);
+
+	// Copy constructor. Deleted.
+	Script(const Script& other) = delete;
+
+	// Move constructor.
+	Script(Script&& other) noexcept;
+
+	// Copy assignment operator. Deleted.
+	Script& operator = (const Script& other) = delete;
+
+	// Move assignment operator.
+	Script& operator = (Script&& other) noexcept;
+
+	// Destructor.
+	// Destroys the coroutine, along with any Script it is awaiting.
+	~Script();
+
+	// Returns true if the Script has no coroutine or has finished.
+	// Returns false otherwise.
+	bool done() const;
+
+	// Gives up ownership of the coroutine and returns it.
+	Handle release();
+
+	// Awaiting a Script runs it to completion as part of the awaiting
+	// Script, and rethrows any exception it ended with.
+	ChildAwaiter operator co_await() && noexcept;
+};
+
+// Suspends the awaiting Script until the given amount of seconds of
+// ScriptScheduler time have passed.
+struct WaitSeconds
+{
+	float seconds = 0.0f;
+
+	bool await_ready() const noexcept { return seconds <= 0.0f; }
+	void await_suspend(Script::Handle handle) const noexcept;
+	void await_resume() const noexcept {}
+};
+
+// Suspends the awaiting Script for the given amount of ticks.
+struct WaitTicks
+{
+	std::uint64_t ticks = 1;
+
+	bool await_ready() const noexcept { return ticks == 0; }
+	void await_suspend(Script::Handle handle) const noexcept;
+	void await_resume() const noexcept {}
+};
+
+// Suspends the awaiting Script until predicate() returns true,
+// checking once per tick from the next tick on.
+// The predicate is stored in the awaiting coroutine frame, so waiting
+// does not allocate.
+template <typename F> struct WaitUntil
+{
+	F predicate;
+
+	static bool check(void* context)
+	{
+		return (*static_cast<F*>(context))();
+	}
+
+	bool await_ready() { return predicate(); }
+
+	void await_suspend(Script::Handle handle) noexcept
+	{
+		Script::promise_type& root = *handle.promise().root;
+
+		root.condition = &check;
+		root.condition_context = &predicate;
+		WaitTicks { 1 }.await_suspend(handle);
+	}
+
+	void await_resume() const noexcept {}
+};
+
+// Returns an awaitable that waits for the given amount of seconds.
+inline WaitSeconds wait_seconds(float seconds)
+{
+	return WaitSeconds { seconds };
+}
+
+// Returns an awaitable that waits for the given amount of ticks.
+inline WaitTicks wait_ticks(std::uint64_t ticks)
+{
+	return WaitTicks { ticks };
+}
+
+// Returns an awaitable that waits until the next tick.
+inline WaitTicks next_tick()
+{
+	return WaitTicks { 1 };
+}
+
+// Returns an awaitable that waits until predicate() returns true.
+template <typename F> WaitUntil<std::decay_t<F>> wait_until(F&& predicate)
+{
+	return WaitUntil<std::decay_t<F>> { std::forward<F>(predicate) };
+}
+
+// Runs Scripts, resuming each one once per tick when what it is
+// waiting for has happened.
+class ScriptScheduler
+{
+	std::vector<Script::Handle> scripts_;
+	std::vector<Script::Handle> started_;
+	double time_ = 0.0;
+	std::uint64_t tick_ = 0;
+	std::uint64_t next_id_ = 1;
+
+	public:
+
+	// Default constructor.
+	ScriptScheduler() = default;
+
+	// Copy constructor. Deleted.
+	ScriptScheduler(const ScriptScheduler& other) = delete;
+
+	// Copy assignment operator. Deleted.
+	ScriptScheduler& operator = (const ScriptScheduler& other) = delete;
+
+	// Destructor.
+	// Destroys every Script that has not finished.
+	~ScriptScheduler();
+
+	// Takes ownership of the given Script and returns an id for stopping it.
+	// The Script first runs during the next call to update.
+	// Returns 0, starting nothing, if the Script has no coroutine or has finished.
+	std::uint64_t start(Script script);
+
+	// Stops the Script with the given id. It is destroyed without
+	// being resumed again, before the next update resumes anything else.
+	// Returns false if no running Script has the given id.
+	bool stop(std::uint64_t id);
+
+	// Advances the time by the given amount of seconds and resumes
+	// every Script that is ready. Finished Scripts are destroyed.
+	// If any Scripts ended with an exception, the first one is
+	// rethrown after every other Script has been resumed.
+	void update(float seconds);
+
+	// Returns the time, in seconds, passed through update.
+	double time() const;
+
+	// Returns the amount of calls to update.
+	std::uint64_t tick() const;
+
+	// Returns the amount of Scripts that have not finished.
+	std::size_t runningCount() const;
+};
+
+#endif // SCRIPT_H_INCLUDED
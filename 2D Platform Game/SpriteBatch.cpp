@@ -0,0 +1,246 @@
+// 2D Platform Game
+// SpriteBatch.cpp
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Source file for the SpriteBatch class.
+
+#include "SpriteBatch.h"
+#include "Jlib/Transform.h"
+
+#include <algorithm>
+
+// Jlib/Angle.h
+using Jlib::Angle;
+
+// Jlib/Color.h
+using Jlib::Color;
+
+// Jlib/Point.h
+using Jlib::Point2f;
+
+// Jlib/Rectangle.h
+using Jlib::Rectangle;
+
+// Jlib/ThreadPool.h
+using Jlib::ThreadPool;
+
+// Jlib/Transform.h
+using Jlib::Mat3f;
+
+// <cstddef>
+using std::size_t;
+
+// <cstdint>
+using std::uint8_t;
+using std::uint16_t;
+using std::uint32_t;
+
+// <vector>
+using std::vector;
+
+namespace
+{
+	constexpr uint32_t LAYER_SHIFT = 16;
+	constexpr uint32_t TEXTURE_MASK = 0xFFFF;
+
+	// Radix sort digits: 8 bits over the 24 bit key.
+	constexpr size_t DIGIT_BITS = 8;
+	constexpr size_t DIGIT_COUNT = 3;
+	constexpr size_t BUCKET_COUNT = size_t(1) << DIGIT_BITS;
+
+	// Sprites written per ThreadPool task.
+	constexpr size_t SPRITES_PER_TASK = 4096;
+}
+
+void SpriteBatch::clear()
+{
+	positions_.clear();
+	sources_.clear();
+	colors_.clear();
+	rotations_.clear();
+	keys_.clear();
+}
+
+void SpriteBatch::reserve(size_t count)
+{
+	positions_.reserve(count);
+	sources_.reserve(count);
+	colors_.reserve(count);
+	rotations_.reserve(count);
+	keys_.reserve(count);
+}
+
+void SpriteBatch::add(const Point2f& position, const Rectangle<float>& source, uint16_t texture, uint8_t layer, const Color& tint, const Angle& rotation)
+{
+	positions_.push_back(position);
+	sources_.push_back(source);
+	colors_.push_back(tint);
+	rotations_.push_back(rotation);
+	keys_.push_back((uint32_t(layer) << LAYER_SHIFT) | uint32_t(texture));
+}
+
+size_t SpriteBatch::size() const
+{
+	return keys_.size();
+}
+
+void SpriteBatch::sort()
+{
+	const size_t count = keys_.size();
+
+	order_.resize(count);
+	order_scratch_.resize(count);
+	sorted_keys_.assign(keys_.begin(), keys_.end());
+	keys_scratch_.resize(count);
+
+	for (size_t i = 0; i < count; ++i)
+		order_[i] = uint32_t(i);
+
+	// Counts every digit in one pass over the keys.
+	size_t counts[DIGIT_COUNT][BUCKET_COUNT] = {};
+
+	for (const uint32_t key : keys_)
+	{
+		for (size_t d = 0; d < DIGIT_COUNT; ++d)
+			++counts[d][(key >> (d * DIGIT_BITS)) & (BUCKET_COUNT - 1)];
+	}
+
+	// Least significant digit first; each pass is stable, so the last
+	// leaves the keys in order and equal keys in the order they were added.
+	for (size_t d = 0; d < DIGIT_COUNT; ++d)
+	{
+		const size_t shift = d * DIGIT_BITS;
+
+		// A digit all sprites share moves nothing. Most frames use few
+		// layers and textures, so this skips most passes.
+		if (counts[d][(sorted_keys_[0] >> shift) & (BUCKET_COUNT - 1)] == count)
+			continue;
+
+		size_t offsets[BUCKET_COUNT];
+		size_t total = 0;
+
+		for (size_t b = 0; b < BUCKET_COUNT; ++b)
+		{
+			offsets[b] = total;
+			total += counts[d][b];
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t key = sorted_keys_[i];
+			const size_t position = offsets[(key >> shift) & (BUCKET_COUNT - 1)]++;
+
+			keys_scratch_[position] = key;
+			order_scratch_[position] = order_[i];
+		}
+
+		sorted_keys_.swap(keys_scratch_);
+		order_.swap(order_scratch_);
+	}
+}
+
+void SpriteBatch::build(const Point2f& view_top_left, float pixels_per_tile, ThreadPool* pool)
+{
+	const size_t count = keys_.size();
+
+	draw_calls_.clear();
+	vertices_.resize(count * VERTICES_PER_SPRITE);
+
+	if (count == 0)
+		return;
+
+	sort();
+
+	sines_.resize(count);
+	cosines_.resize(count);
+	Jlib::fast_sincos(rotations_.data(), sines_.data(), cosines_.data(), count);
+
+	// From positions in tiles to positions in pixels, as Camera::viewTransform.
+	const Mat3f view = Mat3f::scale(pixels_per_tile, pixels_per_tile) * Mat3f::translation(-view_top_left.x, -view_top_left.y);
+
+	// Sprites write to separate parts of the vertices.
+	const auto write = [&](size_t task)
+	{
+		const size_t first = task * SPRITES_PER_TASK;
+		const size_t last = std::min(first + SPRITES_PER_TASK, count);
+
+		for (size_t i = first; i < last; ++i)
+		{
+			const uint32_t sprite = order_[i];
+			const Rectangle<float>& source = sources_[sprite];
+			const Color color = colors_[sprite];
+
+			const float half_width = source.width * 0.5f;
+			const float half_height = source.height * 0.5f;
+
+			// Sprite sizes are in pixels, so the corners are rotated around
+			// the centre of the sprite and then moved to where the view
+			// puts that centre.
+			const Point2f centre = view.transformPoint(positions_[sprite]);
+			const Mat3f transform = Mat3f::rotationTranslation(cosines_[sprite], sines_[sprite], centre.x, centre.y);
+
+			const Point2f top_left_corner = transform.transformPoint(Point2f(-half_width, -half_height));
+			const Point2f top_right_corner = transform.transformPoint(Point2f(half_width, -half_height));
+			const Point2f bottom_right_corner = transform.transformPoint(Point2f(half_width, half_height));
+			const Point2f bottom_left_corner = transform.transformPoint(Point2f(-half_width, half_height));
+
+			const float left = source.vertex.x;
+			const float top = source.vertex.y;
+			const float right = left + source.width;
+			const float bottom = top + source.height;
+
+			const SpriteVertex top_left { top_left_corner.x, top_left_corner.y, color, left, top };
+			const SpriteVertex top_right { top_right_corner.x, top_right_corner.y, color, right, top };
+			const SpriteVertex bottom_right { bottom_right_corner.x, bottom_right_corner.y, color, right, bottom };
+			const SpriteVertex bottom_left { bottom_left_corner.x, bottom_left_corner.y, color, left, bottom };
+
+			SpriteVertex* const quad = vertices_.data() + i * VERTICES_PER_SPRITE;
+			quad[0] = top_left;
+			quad[1] = top_right;
+			quad[2] = bottom_right;
+			quad[3] = top_left;
+			quad[4] = bottom_right;
+			quad[5] = bottom_left;
+		}
+	};
+
+	const size_t tasks = (count + SPRITES_PER_TASK - 1) / SPRITES_PER_TASK;
+
+	if (pool != nullptr && tasks > 1)
+		pool->parallelFor(tasks, write);
+	else
+	{
+		for (size_t i = 0; i < tasks; ++i)
+			write(i);
+	}
+
+	// Sorted, equal keys are next to each other: one draw call per run.
+	for (size_t i = 0; i < count;)
+	{
+		const uint32_t key = sorted_keys_[i];
+		size_t end = i + 1;
+
+		while (end < count && sorted_keys_[end] == key)
+			++end;
+
+		SpriteDrawCall call;
+		call.texture = uint16_t(key & TEXTURE_MASK);
+		call.layer = uint8_t(key >> LAYER_SHIFT);
+		call.first_vertex = i * VERTICES_PER_SPRITE;
+		call.vertex_count = (end - i) * VERTICES_PER_SPRITE;
+		draw_calls_.push_back(call);
+
+		i = end;
+	}
+}
+
+const vector<SpriteVertex>& SpriteBatch::vertices() const
+{
+	return vertices_;
+}
+
+const vector<SpriteDrawCall>& SpriteBatch::drawCalls() const
+{
+	return draw_calls_;
+}
@@ -0,0 +1,112 @@
+// 2D Platform Game
+// SpriteBatch.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the SpriteBatch class.
+
+#ifndef SPRITEBATCH_H_INCLUDED
+#define SPRITEBATCH_H_INCLUDED
+
+#include "Jlib/Angle.h"
+#include "Jlib/Color.h"
+#include "Jlib/Point.h"
+#include "Jlib/Rectangle.h"
+#include "Jlib/ThreadPool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// A vertex laid out as sf::Vertex: position, color, texture coordinates.
+// Positions are in screen pixels and texture coordinates in texture
+// pixels, as SFML expects.
+struct SpriteVertex
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	Jlib::Color color;
+	float u = 0.0f;
+	float v = 0.0f;
+};
+
+static_assert(sizeof(SpriteVertex) == 20, "SpriteVertex must match the layout of sf::Vertex");
+
+// A run of vertices that share a texture and layer, drawn at once.
+struct SpriteDrawCall
+{
+	std::uint16_t texture = 0;
+	std::uint8_t layer = 0;
+	std::size_t first_vertex = 0;
+	std::size_t vertex_count = 0;
+};
+
+// Collects the sprites of a frame and turns them into as few draw calls
+// as possible: one per layer and texture used.
+// Sprites are kept as arrays of each field, as in ParticleSystem. build
+// radix sorts them by layer, then texture, keeping the order they were
+// added in within each, and writes 2 triangles per sprite into one
+// vertex array, each draw call a contiguous part of it. Pass
+// vertices().data() + first_vertex to sf::RenderTarget::draw as
+// sf::Vertex with sf::Triangles and the call's texture.
+// Every array is kept between frames, so a batch of the same size
+// builds without allocating.
+class SpriteBatch
+{
+	std::vector<Jlib::Point2f> positions_;
+	std::vector<Jlib::Rectangle<float>> sources_;
+	std::vector<Jlib::Color> colors_;
+	std::vector<Jlib::Angle> rotations_;
+
+	// Layer in bits 16 to 23 and texture in bits 0 to 15.
+	std::vector<std::uint32_t> keys_;
+
+	// Scratch space for build.
+	std::vector<std::uint32_t> order_;
+	std::vector<std::uint32_t> order_scratch_;
+	std::vector<std::uint32_t> sorted_keys_;
+	std::vector<std::uint32_t> keys_scratch_;
+	std::vector<float> sines_;
+	std::vector<float> cosines_;
+
+	std::vector<SpriteVertex> vertices_;
+	std::vector<SpriteDrawCall> draw_calls_;
+
+	// Sorts the indices of the sprites into order_ by key.
+	void sort();
+
+	public:
+
+	static constexpr std::size_t VERTICES_PER_SPRITE = 6;
+
+	// Default constructor.
+	SpriteBatch() = default;
+
+	// Removes every sprite. The built vertices and draw calls are kept
+	// until the next build.
+	void clear();
+
+	// Makes room for the given amount of sprites.
+	void reserve(std::size_t count);
+
+	// Adds a sprite centred on position, in tiles, showing the source
+	// rectangle of texture, in texture pixels, at its size in pixels.
+	void add(const Jlib::Point2f& position, const Jlib::Rectangle<float>& source, std::uint16_t texture, std::uint8_t layer = 0, const Jlib::Color& tint = Jlib::Color(255, 255, 255, 255), const Jlib::Angle& rotation = Jlib::Angle(0.0));
+
+	// Returns the amount of sprites added since the last clear.
+	std::size_t size() const;
+
+	// Builds the vertices and draw calls of every sprite added, seen
+	// from a view whose top left corner is view_top_left, in tiles,
+	// with pixels_per_tile pixels to a tile.
+	// When pool is not nullptr, the vertices are written in parallel.
+	void build(const Jlib::Point2f& view_top_left, float pixels_per_tile, Jlib::ThreadPool* pool = nullptr);
+
+	// Returns the vertices of the last build.
+	const std::vector<SpriteVertex>& vertices() const;
+
+	// Returns the draw calls of the last build, in drawing order.
+	const std::vector<SpriteDrawCall>& drawCalls() const;
+};
+
+#endif // SPRITEBATCH_H_INCLUDED
@@ -0,0 +1,43 @@
+// 2D Platform Game
+// Tile.h
+// Justyn Durnford
+// Created on 2026-10-19
+// Last updated on 2026-10-19
+// Header file for the tile types stored in the level layout.
+
+#ifndef TILE_H_INCLUDED
+#define TILE_H_INCLUDED
+
+#include "Jlib/Matrix.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// The level layout is a Jlib::Matrix<std::uint8_t> indexed as
+// (row, column) = (y, x), with y = 0 at the top of the level.
+// Each element is the character used for the tile in level.txt.
+
+// Tile that blocks movement.
+constexpr std::uint8_t TILE_SOLID = '#';
+
+// Tile that can be moved through.
+constexpr std::uint8_t TILE_EMPTY = '_';
+
+// Returns true if the given tile blocks movement.
+// Returns false otherwise.
+constexpr bool is_solid(std::uint8_t tile)
+{
+	return tile == TILE_SOLID;
+}
+
+// Returns true if the tile at (x, y) blocks movement.
+// Positions outside of the level are treated as solid.
+inline bool is_solid_at(const Jlib::Matrix<std::uint8_t>& level, std::int32_t x, std::int32_t y)
+{
+	if (x < 0 || y < 0 || std::size_t(x) >= level.colSize() || std::size_t(y) >= level.rowSize())
+		return true;
+
+	return is_solid(level(std::size_t(y), std::size_t(x)));
+}
+
+#endif // TILE_H_INCLUDED
@@ -2,7 +2,7 @@
 // main.cpp
 // Justyn Durnford
 // Created on 2021-02-22
-// Last updated on 2021-02-24
+// Last updated on 2026-10-19
 // Main file.
 
 #include <SFML/Graphics/Texture.hpp>
@@ -24,39 +24,47 @@ using Jlib::Point2f;
 #include "Jlib/Vector.h"
 using Jlib::Vector2f;
 
+#include "AssetManager.h"
+#include "Camera.h"
+#include "LevelCache.h"
+#include "LevelReloader.h"
+#include "Tile.h"
+
 #include <cmath>
 using std::fabsf;
 
-#include <cstddef>
-using std::size_t;
-
 #include <cstdint>
+using std::int32_t;
 using std::uint8_t;
 using std::uint32_t;
 
-#include <fstream>
-using std::ifstream;
+#include <exception>
+using std::exception;
 
 #include <iostream>
 using std::cout;
 using std::endl;
 
-#include <stdexcept>
-using std::runtime_error;
-
-#include <string>
-using std::string;
+#include <memory>
+using std::make_unique;
+using std::shared_ptr;
+using std::unique_ptr;
 
 // Level properties.
 Matrix<uint8_t> level_layout;
 
+// Swaps in level.txt whenever it is saved, if it could be watched.
+unique_ptr<LevelReloader> level_reloader;
+
 // Player properties.
 Point2f player_position;
 Vector2f player_velocity;
 bool is_grounded = true;
 
 // Camera properties.
-Point2f camera_position;
+// The view is 32 by 18 tiles, and the player can move 4 by 3 tiles
+// around the centre before the camera follows.
+Camera camera(Vector2f(32.0f, 18.0f));
 
 template <arithmetic T> void clamp(T& value, T lower, T upper)
 {
@@ -73,32 +81,9 @@ template <arithmetic T> void clamp(T& value, T lower, T upper)
 	}
 }
 
-template <typename T> void read(ifstream& fin, T& var)
-{
-	fin >> var;
-
-	if (fin.bad() || fin.eof())
-		throw runtime_error("Error reading from file");
-}
-
 bool is_tile_solid(const Point2f& position)
 {
-	switch (level_layout(position.x, position.y))
-	{
-		case '#':
-			return true;
-			break;
-
-		case '_':
-			return false;
-			break;
-
-		default:
-			return false;
-			break;
-	}
-
-	return false;
+	return is_solid_at(level_layout, int32_t(position.x), int32_t(position.y));
 }
 
 void check_collision()
@@ -143,6 +128,15 @@ void check_collision()
 
 void update(float elapsed_time)
 {
+	// Ticks start with a whole level, never half of an old and a new one.
+	ReloadReport reload;
+
+	if (level_reloader && level_reloader->apply(level_layout, player_position, &reload))
+	{
+		camera.setBounds(level_layout);
+		cout << "Reloaded level.txt in " << reload.latency_milliseconds << " ms" << endl;
+	}
+
 	// Apply gravity.
 	player_velocity.y += 20.0f * elapsed_time;
 
@@ -166,57 +160,53 @@ void update(float elapsed_time)
 	// Check for collisions.
 	check_collision();
 
-	// Set camera to the player's position.
-	camera_position = player_position;
+	// Move the camera towards the player's position.
+	camera.update(player_position, elapsed_time);
 }
 
-bool load_level(const string& file_dir)
+int main()
 {
+	// Nothing is on screen yet, so wait for the level here. Later level
+	// switches call assets.update once per frame instead.
+	AssetManager assets;
+	AssetHandle<shared_ptr<const ChunkedLevel>> level;
+
 	try
 	{
-		ifstream fin(file_dir);
-
-		if (!fin.is_open())
-			return false;
-
-		size_t row = 0, col = 0;
-
-		read(fin, col);
-		read(fin, row);
-
-		read(fin, player_position.x);
-		read(fin, player_position.y);
-
-		level_layout = Matrix<uint8_t>(row, col);
-
-		for (size_t r = 0; r < row; ++r)
-		{
-			for (size_t c = 0; c < col; ++c)
-				read(fin, level_layout.at(r, c));
-		}
+		// Parsed levels are kept in the cache directory between runs.
+		static ContentStore content_store;
+		static LevelCache level_cache("cache", content_store);
+
+		level = assets.generate<shared_ptr<const ChunkedLevel>>("level.txt", 0, [] { return level_cache.load("level.txt"); });
+		assets.wait(level);
+		level.get()->copyTo(level_layout);
+		player_position = level.get()->spawn();
 	}
-	catch (...) { return false; }
-
-	return true;
-}
-
-int main()
-{
-	if (!load_level("level.txt"))
+	catch (const exception& e)
 	{
-		cout << "ERROR: Could not read from file level.txt" << endl;
+		cout << "ERROR: Could not load level.txt: " << e.what() << endl;
 		return 1;
 	}
 
-	// DEBUG
-	// Print out level.
-	for (size_t r = 0; r < level_layout.rowSize(); ++r)
-	{
-		for (size_t c = 0; c < level_layout.colSize(); ++c)
-			cout << level_layout.at(r, c);
+	cout << "Loaded level.txt in " << level.timings().total << " ms" << endl;
 
-		cout << endl;
+	// Collision, the camera and the reloader all work on level_layout,
+	// so the chunks are let go of here rather than kept alongside it.
+	level = AssetHandle<shared_ptr<const ChunkedLevel>>();
+
+	try
+	{
+		level_reloader = make_unique<LevelReloader>("level.txt");
+	}
+	catch (const exception& e)
+	{
+		cout << "WARNING: level.txt will not be reloaded: " << e.what() << endl;
 	}
 
+	camera.setDeadZone(Vector2f(4.0f, 3.0f));
+	camera.setSmoothing(0.15f);
+	camera.setBounds(level_layout);
+	camera.snapTo(player_position);
+
 	return 0;
 }
\ No newline at end of file